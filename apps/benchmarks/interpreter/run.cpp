@@ -0,0 +1,234 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/locals.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/streamerrorhandler.hpp>
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class CompilerContext : public Compiler::Context
+    {
+    public:
+        bool canDeclareLocals() const override { return true; }
+
+        char getGlobalType(const std::string& /*name*/) const override { return ' '; }
+
+        std::pair<char, bool> getMemberType(const std::string& /*name*/, const std::string& /*id*/) const override
+        {
+            return {' ', false};
+        }
+
+        bool isId(const std::string& /*name*/) const override { return false; }
+
+        bool isJournalId(const std::string& /*name*/) const override { return false; }
+    };
+
+    /// Keeps only local variables, the generated scripts don't use anything else.
+    class InterpreterContext : public Interpreter::Context
+    {
+    public:
+        explicit InterpreterContext(const Compiler::Locals& locals)
+            : mShorts(locals.get('s').size())
+            , mLongs(locals.get('l').size())
+            , mFloats(locals.get('f').size())
+        {
+        }
+
+        int getLocalShort(int index) const override { return mShorts[index]; }
+
+        int getLocalLong(int index) const override { return mLongs[index]; }
+
+        float getLocalFloat(int index) const override { return mFloats[index]; }
+
+        void setLocalShort(int index, int value) override { mShorts[index] = value; }
+
+        void setLocalLong(int index, int value) override { mLongs[index] = value; }
+
+        void setLocalFloat(int index, float value) override { mFloats[index] = value; }
+
+        void messageBox(const std::string&, const std::vector<std::string>&) override {}
+
+        void report(const std::string&) override {}
+
+        int getGlobalShort(const std::string&) const override { return 0; }
+
+        int getGlobalLong(const std::string&) const override { return 0; }
+
+        float getGlobalFloat(const std::string&) const override { return 0; }
+
+        void setGlobalShort(const std::string&, int) override {}
+
+        void setGlobalLong(const std::string&, int) override {}
+
+        void setGlobalFloat(const std::string&, float) override {}
+
+        std::vector<std::string> getGlobals() const override { return {}; }
+
+        char getGlobalType(const std::string&) const override { return ' '; }
+
+        std::string getActionBinding(const std::string&) const override { return {}; }
+
+        std::string getActorName() const override { return {}; }
+
+        std::string getNPCRace() const override { return {}; }
+
+        std::string getNPCClass() const override { return {}; }
+
+        std::string getNPCFaction() const override { return {}; }
+
+        std::string getNPCRank() const override { return {}; }
+
+        std::string getPCName() const override { return {}; }
+
+        std::string getPCRace() const override { return {}; }
+
+        std::string getPCClass() const override { return {}; }
+
+        std::string getPCRank() const override { return {}; }
+
+        std::string getPCNextRank() const override { return {}; }
+
+        int getPCBounty() const override { return 0; }
+
+        std::string getCurrentCellName() const override { return {}; }
+
+        int getMemberShort(const std::string&, const std::string&, bool) const override { return 0; }
+
+        int getMemberLong(const std::string&, const std::string&, bool) const override { return 0; }
+
+        float getMemberFloat(const std::string&, const std::string&, bool) const override { return 0; }
+
+        void setMemberShort(const std::string&, const std::string&, int, bool) override {}
+
+        void setMemberLong(const std::string&, const std::string&, int, bool) override {}
+
+        void setMemberFloat(const std::string&, const std::string&, float, bool) override {}
+
+    private:
+        std::vector<int> mShorts;
+        std::vector<int> mLongs;
+        std::vector<float> mFloats;
+    };
+
+    struct Script
+    {
+        std::vector<Interpreter::Type_Code> mCode;
+        Compiler::Locals mLocals;
+    };
+
+    /// Local script of an object doing some state tracking each frame, the kind of script large plugins have
+    /// hundreds of. Uses only the core language, engine extensions require a running game.
+    std::string makeScriptText(std::size_t index)
+    {
+        std::ostringstream stream;
+        stream << "begin benchmark_script_" << index << "\n"
+            << "short state\n"
+            << "short doOnce\n"
+            << "long counter\n"
+            << "float timer\n"
+            << "float value\n"
+            << "if ( doOnce == 0 )\n"
+            << "    set doOnce to 1\n"
+            << "    set value to " << index % 17 << ".5\n"
+            << "endif\n"
+            << "set timer to timer + 0.016\n"
+            << "if ( timer > " << 1 + index % 5 << " )\n"
+            << "    set timer to 0\n"
+            << "    if ( state == 0 )\n"
+            << "        set state to 1\n"
+            << "    elseif ( state == 1 )\n"
+            << "        set state to 2\n"
+            << "    else\n"
+            << "        set state to 0\n"
+            << "    endif\n"
+            << "endif\n"
+            << "set counter to 0\n"
+            << "while ( counter < " << 4 + index % 8 << " )\n"
+            << "    set value to value * 0.5 + counter - timer / 2\n"
+            << "    set counter to counter + 1\n"
+            << "endwhile\n"
+            << "if ( state == 2 )\n"
+            << "    if ( value > 10 )\n"
+            << "        return\n"
+            << "    endif\n"
+            << "endif\n"
+            << "set value to -value\n"
+            << "end\n";
+        return stream.str();
+    }
+
+    const std::vector<Script>& getScripts()
+    {
+        static const std::vector<Script> scripts = []
+        {
+            // Number of scripts in a large plugin
+            constexpr std::size_t count = 1000;
+            CompilerContext context;
+            Compiler::StreamErrorHandler errorHandler;
+            Compiler::FileParser parser(errorHandler, context);
+            std::vector<Script> result;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                parser.reset();
+                std::istringstream input(makeScriptText(i));
+                Compiler::Scanner scanner(errorHandler, input, context.getExtensions());
+                scanner.scan(parser);
+                if (!errorHandler.isGood())
+                    throw std::runtime_error("Failed to compile benchmark script " + std::to_string(i));
+                Script script;
+                parser.getCode(script.mCode);
+                script.mLocals = parser.getLocals();
+                result.push_back(std::move(script));
+            }
+            return result;
+        } ();
+        return scripts;
+    }
+
+    void interpreterRunBytecode(benchmark::State& state)
+    {
+        const auto& scripts = getScripts();
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        std::vector<InterpreterContext> contexts;
+        for (const Script& script : scripts)
+            contexts.emplace_back(script.mLocals);
+        for (auto _ : state)
+            for (std::size_t i = 0; i < scripts.size(); ++i)
+                interpreter.run(scripts[i].mCode.data(), static_cast<int>(scripts[i].mCode.size()), contexts[i]);
+        state.SetItemsProcessed(state.iterations() * scripts.size());
+    }
+
+    void interpreterRunDecoded(benchmark::State& state)
+    {
+        const auto& scripts = getScripts();
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        std::vector<Interpreter::Program> programs;
+        std::vector<InterpreterContext> contexts;
+        for (const Script& script : scripts)
+        {
+            programs.push_back(interpreter.decode(script.mCode.data(), static_cast<int>(script.mCode.size())));
+            contexts.emplace_back(script.mLocals);
+        }
+        for (auto _ : state)
+            for (std::size_t i = 0; i < programs.size(); ++i)
+                interpreter.run(programs[i], contexts[i]);
+        state.SetItemsProcessed(state.iterations() * programs.size());
+    }
+}
+
+BENCHMARK(interpreterRunBytecode);
+BENCHMARK(interpreterRunDecoded);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/slotmap.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /// Stands for MWWorld::LiveCellRefBase which is allocated by the cell store and identifies a Ptr.
+    struct Reference
+    {
+        float mPosition[3];
+    };
+
+    /// Stands for MWWorld::Ptr which refers to the live cell ref, the cell and the container store.
+    struct Ptr
+    {
+        const Reference* mRef = nullptr;
+        const void* mCell = nullptr;
+        const void* mContainerStore = nullptr;
+
+        friend bool operator<(const Ptr& lhs, const Ptr& rhs) { return lhs.mRef < rhs.mRef; }
+    };
+
+    /// Stands for MWMechanics::CharacterController which is allocated separately for each actor.
+    struct CharacterController
+    {
+        float mIdleTime = 0;
+    };
+
+    /// Stands for MWMechanics::Actor with the same layout and the per frame state touched by each pass of the
+    /// update.
+    struct ActorState
+    {
+        std::unique_ptr<CharacterController> mCharacterController = std::make_unique<CharacterController>();
+        int mGreetingTimer = 0;
+        float mAngleToPlayer = 0;
+        int mGreetingState = 0;
+        bool mIsTurningToPlayer = false;
+
+        void update(const Reference& reference, float duration)
+        {
+            mGreetingTimer = (mGreetingTimer + 1) % 10;
+            mAngleToPlayer += reference.mPosition[0] * duration;
+            mCharacterController->mIdleTime += reference.mPosition[2] * duration;
+            mIsTurningToPlayer = mAngleToPlayer > 0;
+        }
+    };
+
+    static_assert(sizeof(Ptr) == 3 * sizeof(void*));
+    static_assert(sizeof(ActorState) == sizeof(void*) + 4 * sizeof(int));
+
+    /// References are allocated in shuffled order like the cell stores of several loaded cells do.
+    std::vector<std::unique_ptr<Reference>> generateReferences(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-1, 1);
+        std::vector<std::unique_ptr<Reference>> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(std::make_unique<Reference>(Reference {{distribution(random), distribution(random), distribution(random)}}));
+        std::shuffle(result.begin(), result.end(), random);
+        return result;
+    }
+
+    /// Number of passes over all actors MWMechanics::Actors::update does for each frame.
+    constexpr int updatePasses = 5;
+
+    /// Number of lookups by Ptr done for each actor in a frame by animation and AI queries.
+    constexpr int lookupsPerActor = 4;
+
+    void actorsUpdateMap(benchmark::State& state)
+    {
+        const auto references = generateReferences(static_cast<std::size_t>(state.range(0)));
+        std::map<Ptr, ActorState*> actors;
+        for (const auto& reference : references)
+            actors.emplace(Ptr {reference.get()}, new ActorState);
+
+        for (auto _ : state)
+        {
+            for (int pass = 0; pass < updatePasses; ++pass)
+                for (auto& [ptr, actor] : actors)
+                    actor->update(*ptr.mRef, 0.016f);
+            for (const auto& reference : references)
+                for (int i = 0; i < lookupsPerActor; ++i)
+                    benchmark::DoNotOptimize(actors.find(Ptr {reference.get()})->second->mGreetingTimer);
+        }
+
+        for (auto& [ptr, actor] : actors)
+            delete actor;
+
+        state.SetItemsProcessed(state.iterations() * actors.size());
+    }
+
+    void actorsUpdateSlotMap(benchmark::State& state)
+    {
+        const auto references = generateReferences(static_cast<std::size_t>(state.range(0)));
+        Misc::SlotMap<std::pair<Ptr, ActorState>> actors;
+        std::unordered_map<const Reference*, Misc::SlotMap<std::pair<Ptr, ActorState>>::Handle> index;
+        for (const auto& reference : references)
+            index.emplace(reference.get(), actors.emplace(Ptr {reference.get()}, ActorState()));
+
+        for (auto _ : state)
+        {
+            for (int pass = 0; pass < updatePasses; ++pass)
+                for (auto& [ptr, actor] : actors)
+                    actor.update(*ptr.mRef, 0.016f);
+            for (const auto& reference : references)
+                for (int i = 0; i < lookupsPerActor; ++i)
+                    benchmark::DoNotOptimize(actors.find(index.find(reference.get())->second)->second.mGreetingTimer);
+        }
+
+        state.SetItemsProcessed(state.iterations() * actors.size());
+    }
+}
+
+BENCHMARK(actorsUpdateMap)->Arg(100)->Arg(1000)->Arg(5000);
+BENCHMARK(actorsUpdateSlotMap)->Arg(100)->Arg(1000)->Arg(5000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/spatialhash.hpp>
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Same cell size as MWMechanics::Actors uses for its grid.
+    constexpr float cellSize = 512;
+
+    /// Actors spread over one exterior cell the same way as NPCs spawned in a crowded city or a battle are.
+    std::vector<osg::Vec3f> generateActorPositions(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> horizontal(0, 8192);
+        std::uniform_real_distribution<float> vertical(0, 512);
+        std::vector<osg::Vec3f> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.emplace_back(horizontal(random), horizontal(random), vertical(random));
+        return result;
+    }
+
+    /// Finds neighbors of each actor by checking all actors, like MWMechanics::Actors did for each frame.
+    void actorsProximityLinear(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = generateActorPositions(static_cast<std::size_t>(state.range(0)));
+        const float radius = static_cast<float>(state.range(1));
+        std::vector<std::size_t> neighbors;
+
+        for (auto _ : state)
+        {
+            for (const osg::Vec3f& position : positions)
+            {
+                neighbors.clear();
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                    if ((positions[i] - position).length2() <= radius * radius)
+                        neighbors.push_back(i);
+                benchmark::DoNotOptimize(neighbors.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * positions.size());
+    }
+
+    /// Builds the grid and finds neighbors of each actor, like MWMechanics::Actors does for each frame.
+    void actorsProximitySpatialHash(benchmark::State& state)
+    {
+        const std::vector<osg::Vec3f> positions = generateActorPositions(static_cast<std::size_t>(state.range(0)));
+        const float radius = static_cast<float>(state.range(1));
+        Misc::SpatialHash<std::size_t> grid(cellSize);
+        std::vector<std::size_t> neighbors;
+
+        for (auto _ : state)
+        {
+            grid.clear();
+            for (std::size_t i = 0; i < positions.size(); ++i)
+                grid.insert(positions[i], i);
+            grid.build();
+
+            for (const osg::Vec3f& position : positions)
+            {
+                neighbors.clear();
+                grid.forEachInRange(position, radius,
+                    [&] (std::size_t index, const osg::Vec3f&) { neighbors.push_back(index); });
+                benchmark::DoNotOptimize(neighbors.data());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * positions.size());
+    }
+
+    /// Actors count and query radius: collision avoidance uses up to 200, sneaking checks about 1024 and combat is
+    /// engaged within AI processing range which is 7168 by default.
+    void actorsProximityArguments(benchmark::internal::Benchmark* benchmark)
+    {
+        for (int count : {500, 1000, 2000})
+            for (int radius : {200, 1024, 7168})
+                benchmark->Args({count, radius});
+    }
+}
+
+BENCHMARK(actorsProximityLinear)->Apply(actorsProximityArguments);
+BENCHMARK(actorsProximitySpatialHash)->Apply(actorsProximityArguments);
+
+BENCHMARK_MAIN();
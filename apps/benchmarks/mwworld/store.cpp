@@ -0,0 +1,211 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/esmreader.hpp>
+#include <components/files/collections.hpp>
+#include <components/files/configurationmanager.hpp>
+#include <components/files/escape.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "apps/openmw/mwmechanics/spelllist.hpp"
+#include "apps/openmw/mwworld/esmstore.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace MWMechanics
+{
+    SpellList::SpellList(const std::string& id, int type) : mId(id), mType(type) {}
+}
+
+namespace
+{
+    namespace bpo = boost::program_options;
+
+    /// Reads content files from openmw.cfg the same way as ContentFileTest of openmw_test_suite does.
+    /// Run with Morrowind, Tribunal and Bloodmoon configured to get numbers for the real game data.
+    std::vector<boost::filesystem::path> getContentFiles()
+    {
+        bpo::variables_map variables;
+        bpo::options_description desc("Allowed options");
+        desc.add_options()
+            ("data", bpo::value<Files::EscapePathContainer>()->default_value(Files::EscapePathContainer(), "data")->multitoken()->composing())
+            ("content", bpo::value<Files::EscapeStringVector>()->default_value(Files::EscapeStringVector(), "")
+                ->multitoken()->composing())
+            ("data-local", bpo::value<Files::EscapePath>()->default_value(Files::EscapePath(), ""));
+        bpo::notify(variables);
+
+        Files::ConfigurationManager configurationManager;
+        configurationManager.readConfiguration(variables, desc, true);
+
+        if (variables["content"].empty() || variables["data"].empty())
+            return {};
+
+        Files::PathContainer dataDirs = Files::EscapePath::toPathContainer(variables["data"].as<Files::EscapePathContainer>());
+        const auto local = variables["data-local"].as<Files::EscapePath>().mPath;
+        if (!local.empty())
+            dataDirs.push_back(local);
+        configurationManager.processPaths(dataDirs);
+
+        const Files::Collections collections(dataDirs, true);
+        std::vector<boost::filesystem::path> result;
+        for (const auto& contentFile : variables["content"].as<Files::EscapeStringVector>().toStdStringVector())
+            result.push_back(collections.getPath(contentFile));
+        return result;
+    }
+
+    template <class T>
+    void fillSynthetic(MWWorld::ESMStore& store, std::size_t count)
+    {
+        auto& records = const_cast<MWWorld::Store<T>&>(store.get<T>());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            T record;
+            record.blank();
+            record.mId = "Synthetic_Record_" + std::to_string(i * 7919 % 1000003);
+            records.insertStatic(record);
+        }
+    }
+
+    const MWWorld::ESMStore& getStore()
+    {
+        static const std::unique_ptr<MWWorld::ESMStore> store = []
+        {
+            auto result = std::make_unique<MWWorld::ESMStore>();
+            const auto contentFiles = getContentFiles();
+            if (contentFiles.empty())
+            {
+                // Approximate number of records in Morrowind with both expansions
+                fillSynthetic<ESM::GameSetting>(*result, 1500);
+                fillSynthetic<ESM::NPC>(*result, 3500);
+                fillSynthetic<ESM::Static>(*result, 6000);
+                fillSynthetic<ESM::Script>(*result, 1200);
+                return result;
+            }
+
+            Loading::Listener listener;
+            std::vector<ESM::ESMReader> readers(contentFiles.size());
+            for (std::size_t i = 0; i < contentFiles.size(); ++i)
+            {
+                readers[i].setEncoder(nullptr);
+                readers[i].setIndex(static_cast<int>(i));
+                readers[i].setGlobalReaderList(&readers);
+                readers[i].open(contentFiles[i].string());
+                result->load(readers[i], &listener);
+            }
+            result->setUp();
+            return result;
+        } ();
+        return *store;
+    }
+
+    /// Ids are looked up in the original letter case as they come from scripts and dialogue
+    template <class T>
+    std::vector<std::string> getIds()
+    {
+        std::vector<std::string> result;
+        for (const T& record : getStore().get<T>())
+        {
+            std::string id = record.mId;
+            if (!id.empty())
+                id[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(id[0])));
+            result.push_back(id);
+        }
+        std::shuffle(result.begin(), result.end(), std::mt19937(42));
+        return result;
+    }
+
+    template <class T>
+    void storeSearch(benchmark::State& state)
+    {
+        const auto& store = getStore().get<T>();
+        const auto ids = getIds<T>();
+        if (ids.empty())
+        {
+            state.SkipWithError("Store is empty");
+            return;
+        }
+        std::size_t n = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(store.search(ids[n++ % ids.size()]));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// Previous MWWorld::Store layout: lower case copy of the id per lookup and std::map
+    template <class T>
+    void mapSearch(benchmark::State& state)
+    {
+        std::map<std::string, const T*> map;
+        for (const T& record : getStore().get<T>())
+            map.emplace(Misc::StringUtils::lowerCase(record.mId), &record);
+        const auto ids = getIds<T>();
+        if (ids.empty())
+        {
+            state.SkipWithError("Store is empty");
+            return;
+        }
+        std::size_t n = 0;
+        for (auto _ : state)
+        {
+            const auto it = map.find(Misc::StringUtils::lowerCase(ids[n++ % ids.size()]));
+            benchmark::DoNotOptimize(it == map.end() ? nullptr : it->second);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <class T>
+    void storeSearchMissing(benchmark::State& state)
+    {
+        const auto& store = getStore().get<T>();
+        std::vector<std::string> ids = getIds<T>();
+        for (std::string& id : ids)
+            id += "_missing";
+        if (ids.empty())
+        {
+            state.SkipWithError("Store is empty");
+            return;
+        }
+        std::size_t n = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(store.search(ids[n++ % ids.size()]));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <class T>
+    void storeIterate(benchmark::State& state)
+    {
+        const auto& store = getStore().get<T>();
+        for (auto _ : state)
+        {
+            std::size_t count = 0;
+            for (const T& record : store)
+                count += record.mId.size();
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * store.getSize());
+    }
+}
+
+BENCHMARK_TEMPLATE(storeSearch, ESM::GameSetting);
+BENCHMARK_TEMPLATE(mapSearch, ESM::GameSetting);
+BENCHMARK_TEMPLATE(storeSearch, ESM::NPC);
+BENCHMARK_TEMPLATE(mapSearch, ESM::NPC);
+BENCHMARK_TEMPLATE(storeSearch, ESM::Static);
+BENCHMARK_TEMPLATE(mapSearch, ESM::Static);
+BENCHMARK_TEMPLATE(storeSearch, ESM::Script);
+BENCHMARK_TEMPLATE(mapSearch, ESM::Script);
+BENCHMARK_TEMPLATE(storeSearchMissing, ESM::Static);
+BENCHMARK_TEMPLATE(storeIterate, ESM::Static);
+
+BENCHMARK_MAIN();
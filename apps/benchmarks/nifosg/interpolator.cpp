@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+
+#include <components/nif/nifkey.hpp>
+#include <components/nifosg/controller.hpp>
+
+#include <osg/Quat>
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Interpolator over keys stored in std::map the way NifOsg::ValueInterpolator did before keyframe tracks
+    /// became flat arrays.
+    template <class T>
+    class MapInterpolator
+    {
+    public:
+        using MapType = std::map<float, Nif::KeyT<T>>;
+
+        explicit MapInterpolator(std::shared_ptr<const MapType> keys)
+            : mKeys(std::move(keys))
+            , mLastLowKey(mKeys->end())
+            , mLastHighKey(mKeys->end())
+        {}
+
+        T interpKey(float time) const
+        {
+            const MapType& keys = *mKeys;
+
+            if (time <= keys.begin()->first)
+                return keys.begin()->second.mValue;
+
+            typename MapType::const_iterator it = retrieveKey(time);
+
+            if (it != keys.end())
+            {
+                mLastHighKey = it;
+                mLastLowKey = --it;
+
+                const float a = (time - mLastLowKey->first) / (mLastHighKey->first - mLastLowKey->first);
+
+                return interpolate(mLastLowKey->second.mValue, mLastHighKey->second.mValue, a);
+            }
+
+            return keys.rbegin()->second.mValue;
+        }
+
+    private:
+        std::shared_ptr<const MapType> mKeys;
+        mutable typename MapType::const_iterator mLastLowKey;
+        mutable typename MapType::const_iterator mLastHighKey;
+
+        typename MapType::const_iterator retrieveKey(float time) const
+        {
+            if (mLastHighKey != mKeys->end())
+            {
+                if (time > mLastHighKey->first)
+                {
+                    ++mLastLowKey;
+                    ++mLastHighKey;
+                }
+                if (mLastHighKey != mKeys->end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
+                    return mLastHighKey;
+            }
+
+            return mKeys->lower_bound(time);
+        }
+
+        static osg::Vec3f interpolate(const osg::Vec3f& a, const osg::Vec3f& b, float fraction)
+        {
+            return a + ((b - a) * fraction);
+        }
+
+        static osg::Quat interpolate(const osg::Quat& a, const osg::Quat& b, float fraction)
+        {
+            osg::Quat result;
+            result.slerp(fraction, a, b);
+            return result;
+        }
+    };
+
+    /// Number of bones animated by a typical NPC skeleton and keys per track of a looped animation group. Each NPC
+    /// has own controllers sharing the tracks and plays the animation from a different point.
+    constexpr std::size_t npcsCount = 30;
+    constexpr std::size_t tracksCount = 60;
+    constexpr std::size_t keysCount = 90;
+    constexpr float trackDuration = 3;
+    constexpr float frameDuration = 1.f / 60;
+
+    osg::Vec3f makeValue(std::minstd_rand& random, osg::Vec3f)
+    {
+        std::uniform_real_distribution<float> distribution(-100, 100);
+        return osg::Vec3f(distribution(random), distribution(random), distribution(random));
+    }
+
+    osg::Quat makeValue(std::minstd_rand& random, osg::Quat)
+    {
+        std::uniform_real_distribution<float> distribution(-osg::PI, osg::PI);
+        return osg::Quat(distribution(random), osg::Vec3f(0, 0, 1)) * osg::Quat(distribution(random), osg::Vec3f(1, 0, 0));
+    }
+
+    template <class KeyMap>
+    std::vector<std::shared_ptr<const KeyMap>> makeTracks()
+    {
+        std::minstd_rand random;
+        std::vector<std::shared_ptr<const KeyMap>> result;
+        for (std::size_t i = 0; i < tracksCount; ++i)
+        {
+            auto track = std::make_shared<KeyMap>();
+            for (std::size_t j = 0; j < keysCount; ++j)
+            {
+                track->mTimes.push_back(trackDuration * j / (keysCount - 1));
+                track->mValues.push_back(makeValue(random, typename KeyMap::ValueType()));
+            }
+            result.push_back(std::move(track));
+        }
+        return result;
+    }
+
+    template <class KeyMap>
+    std::shared_ptr<const typename MapInterpolator<typename KeyMap::ValueType>::MapType> toMap(const KeyMap& track)
+    {
+        auto result = std::make_shared<typename MapInterpolator<typename KeyMap::ValueType>::MapType>();
+        for (std::size_t i = 0; i < track.size(); ++i)
+            (*result)[track.mTimes[i]].mValue = track.mValues[i];
+        return result;
+    }
+
+    /// Samples all tracks with time advancing by a frame, like KeyframeControllers of animated skeletons do.
+    template <class Interpolator>
+    void sampleTracks(benchmark::State& state, std::vector<Interpolator>& interpolators)
+    {
+        std::vector<float> times(npcsCount);
+        for (std::size_t i = 0; i < npcsCount; ++i)
+            times[i] = trackDuration * i / npcsCount;
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < interpolators.size(); ++i)
+                benchmark::DoNotOptimize(interpolators[i].interpKey(times[i / tracksCount]));
+            for (float& time : times)
+            {
+                time += frameDuration;
+                if (time > trackDuration)
+                    time = 0;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * interpolators.size());
+    }
+
+    template <class KeyMap>
+    void interpolateMap(benchmark::State& state)
+    {
+        std::vector<std::shared_ptr<const typename MapInterpolator<typename KeyMap::ValueType>::MapType>> maps;
+        for (const auto& track : makeTracks<KeyMap>())
+            maps.push_back(toMap(*track));
+        std::vector<MapInterpolator<typename KeyMap::ValueType>> interpolators;
+        for (std::size_t i = 0; i < npcsCount; ++i)
+            for (const auto& map : maps)
+                interpolators.emplace_back(map);
+        sampleTracks(state, interpolators);
+    }
+
+    template <class KeyMap>
+    void interpolateTrack(benchmark::State& state)
+    {
+        const std::vector<std::shared_ptr<const KeyMap>> tracks = makeTracks<KeyMap>();
+        std::vector<NifOsg::ValueInterpolator<KeyMap>> interpolators;
+        for (std::size_t i = 0; i < npcsCount; ++i)
+            for (const auto& track : tracks)
+                interpolators.emplace_back(track);
+        sampleTracks(state, interpolators);
+    }
+}
+
+BENCHMARK_TEMPLATE(interpolateMap, Nif::Vector3KeyMap);
+BENCHMARK_TEMPLATE(interpolateTrack, Nif::Vector3KeyMap);
+BENCHMARK_TEMPLATE(interpolateMap, Nif::QuaternionKeyMap);
+BENCHMARK_TEMPLATE(interpolateTrack, Nif::QuaternionKeyMap);
+
+BENCHMARK_MAIN();
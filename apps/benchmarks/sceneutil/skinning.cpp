@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/skinning.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// Close to the body parts of a stock NPC: a chain of bones where each vertex is weighted to up to 3 neighbor
+    /// bones, so most vertices share weights with only a few others.
+    constexpr std::size_t bonesCount = 40;
+    constexpr std::size_t verticesCount = 3000;
+
+    struct Mesh
+    {
+        osg::ref_ptr<SceneUtil::SkinningData> mData;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        SceneUtil::SkinningSource mSource;
+    };
+
+    Mesh generateMesh()
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> coordinate(-50, 50);
+        std::uniform_int_distribution<std::size_t> bone(0, bonesCount - 3);
+        std::uniform_int_distribution<int> weightsCount(1, 3);
+        const float weights[3][3] = {{1, 0, 0}, {0.5f, 0.5f, 0}, {0.5f, 0.25f, 0.25f}};
+
+        std::vector<std::pair<std::string, SceneUtil::BoneInfluence>> influences(bonesCount);
+        for (std::size_t i = 0; i < bonesCount; ++i)
+        {
+            influences[i].first = "bone " + std::to_string(i);
+            influences[i].second.mInvBindMatrix = osg::Matrixf::translate(0, 0, -static_cast<float>(i));
+        }
+
+        osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec4Array> tangents(new osg::Vec4Array);
+        for (std::size_t i = 0; i < verticesCount; ++i)
+        {
+            const std::size_t first = bone(random);
+            const int count = weightsCount(random);
+            for (int j = 0; j < count; ++j)
+                influences[first + j].second.mWeights.emplace_back(static_cast<unsigned short>(i), weights[count - 1][j]);
+            positions->push_back(osg::Vec3f(coordinate(random), coordinate(random), coordinate(random)));
+            normals->push_back(osg::Vec3f(0, 0, 1));
+            tangents->push_back(osg::Vec4f(1, 0, 0, 1));
+        }
+
+        Mesh result;
+        result.mData = SceneUtil::makeSkinningData(influences);
+        for (std::size_t i = 0; i < bonesCount; ++i)
+            result.mBoneMatrices.push_back(osg::Matrixf::rotate(0.1f * i, osg::Vec3f(1, 0, 0))
+                * osg::Matrixf::translate(0, 0, static_cast<float>(i)));
+        result.mSource.mPositions = positions;
+        result.mSource.mNormals = normals;
+        result.mSource.mTangents = tangents;
+        return result;
+    }
+
+    SceneUtil::SkinningTarget makeTarget()
+    {
+        SceneUtil::SkinningTarget result;
+        result.mPositions = new osg::Vec3Array(verticesCount);
+        result.mNormals = new osg::Vec3Array(verticesCount);
+        result.mTangents = new osg::Vec4Array(verticesCount);
+        return result;
+    }
+
+    struct SkinningItem : SceneUtil::WorkItem
+    {
+        const Mesh& mMesh;
+        SceneUtil::SkinningTarget mTarget;
+
+        SkinningItem(const Mesh& mesh, const SceneUtil::SkinningTarget& target) : mMesh(mesh), mTarget(target) {}
+
+        void doWork() override
+        {
+            SceneUtil::skin(*mMesh.mData, mMesh.mBoneMatrices, nullptr, mMesh.mSource, mTarget);
+        }
+    };
+
+    /// Skins all copies in the calling thread, like RigGeometry does in the cull traversal without a work queue.
+    void skinningInline(benchmark::State& state)
+    {
+        const Mesh mesh = generateMesh();
+        std::vector<SceneUtil::SkinningTarget> targets(static_cast<std::size_t>(state.range(0)));
+        for (SceneUtil::SkinningTarget& target : targets)
+            target = makeTarget();
+
+        for (auto _ : state)
+        {
+            for (const SceneUtil::SkinningTarget& target : targets)
+                SceneUtil::skin(*mesh.mData, mesh.mBoneMatrices, nullptr, mesh.mSource, target);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * targets.size() * verticesCount);
+    }
+
+    /// Queues a skinning job per copy and waits for all of them, like drawing of a frame waits for RigGeometries
+    /// with a skinning work queue.
+    void skinningWorkQueue(benchmark::State& state)
+    {
+        const Mesh mesh = generateMesh();
+        std::vector<SceneUtil::SkinningTarget> targets(static_cast<std::size_t>(state.range(0)));
+        for (SceneUtil::SkinningTarget& target : targets)
+            target = makeTarget();
+        osg::ref_ptr<SceneUtil::WorkQueue> queue(new SceneUtil::WorkQueue(static_cast<int>(state.range(1))));
+        std::vector<osg::ref_ptr<SceneUtil::WorkItem>> items;
+
+        for (auto _ : state)
+        {
+            items.clear();
+            for (const SceneUtil::SkinningTarget& target : targets)
+            {
+                items.emplace_back(new SkinningItem(mesh, target));
+                queue->addWorkItem(items.back(), SceneUtil::WorkPriority::High);
+            }
+            for (const osg::ref_ptr<SceneUtil::WorkItem>& item : items)
+                item->waitTillDone();
+        }
+
+        state.SetItemsProcessed(state.iterations() * targets.size() * verticesCount);
+    }
+}
+
+BENCHMARK(skinningInline)->Arg(1)->Arg(16)->Arg(64);
+BENCHMARK(skinningWorkQueue)->ArgsProduct({{1, 16, 64}, {1, 2, 4}})->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -12,6 +12,7 @@
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/records.hpp>
+#include <components/esm/storesnapshot.hpp>
 
 #include "record.hpp"
 
@@ -368,6 +369,29 @@ int load(Arguments& info)
             uint32_t flags;
             esm.getRecHeader(flags);
 
+            if (n.intval == ESM::REC_SNAP)
+            {
+                ESM::StoreSnapshot snapshot;
+                snapshot.load(esm);
+                if (!quiet)
+                {
+                    std::cout << "ESM store snapshot format: " << snapshot.mFormat << std::endl
+                              << "  Encoding: " << snapshot.mEncoding << std::endl
+                              << "  Content files:" << std::endl;
+                    for (const auto& file : snapshot.mContentFiles)
+                        std::cout << "    " << file.mPath << ", " << file.mSize << " bytes, modified at "
+                                  << file.mModificationTime << std::endl;
+                }
+                continue;
+            }
+
+            if (n.intval == ESM::REC_SNXT)
+            {
+                // Data of the previous record stored only by ESM store snapshot
+                esm.skipRecord();
+                continue;
+            }
+
             EsmTool::RecordBase *record = EsmTool::RecordBase::create(n);
             if (record == nullptr)
             {
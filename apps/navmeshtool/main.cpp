@@ -0,0 +1,759 @@
+#include <components/debug/debugging.hpp>
+#include <components/debug/debuglog.hpp>
+
+#include <components/detournavigator/navigatorimpl.hpp>
+#include <components/detournavigator/recastglobalallocator.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <components/esm/esmreader.hpp>
+#include <components/esm/loadacti.hpp>
+#include <components/esm/loadcell.hpp>
+#include <components/esm/loadcont.hpp>
+#include <components/esm/loaddoor.hpp>
+#include <components/esm/loadgmst.hpp>
+#include <components/esm/loadland.hpp>
+#include <components/esm/loadligh.hpp>
+#include <components/esm/loadpgrd.hpp>
+#include <components/esm/loadstat.hpp>
+
+#include <components/files/collections.hpp>
+#include <components/files/configurationmanager.hpp>
+#include <components/files/escape.hpp>
+
+#include <components/misc/constants.hpp>
+#include <components/misc/convert.hpp>
+#include <components/misc/stringops.hpp>
+
+#include <components/resource/bulletshape.hpp>
+#include <components/resource/bulletshapemanager.hpp>
+#include <components/resource/resourcesystem.hpp>
+#include <components/resource/scenemanager.hpp>
+
+#include <components/settings/settings.hpp>
+
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <components/vfs/manager.hpp>
+#include <components/vfs/registerarchives.hpp>
+
+#include <osg/Quat>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace NavMeshTool
+{
+    namespace bpo = boost::program_options;
+
+    using StringsVector = std::vector<std::string>;
+
+    bpo::options_description makeOptionsDescription()
+    {
+        bpo::options_description result("Syntax: openmw-navmeshtool <options>\nAllowed options");
+
+        result.add_options()
+            ("help", "print help message")
+
+            ("data", bpo::value<Files::EscapePathContainer>()->default_value(Files::EscapePathContainer(), "data")
+                ->multitoken()->composing(), "set data directories (later directories have higher priority)")
+
+            ("data-local", bpo::value<Files::EscapePath>()->default_value(Files::EscapePath(), ""),
+                "set local data directory (highest priority)")
+
+            ("fallback-archive", bpo::value<Files::EscapeStringVector>()->default_value(Files::EscapeStringVector(), "fallback-archive")
+                ->multitoken()->composing(), "set fallback BSA archives (later archives have higher priority)")
+
+            ("resources", bpo::value<Files::EscapePath>()->default_value(Files::EscapePath(), "resources"),
+                "set resources directory")
+
+            ("content", bpo::value<Files::EscapeStringVector>()->default_value(Files::EscapeStringVector(), "")
+                ->multitoken()->composing(), "content file(s): esm/esp, or omwgame/omwaddon")
+
+            ("fs-strict", bpo::value<bool>()->implicit_value(true)
+                ->default_value(false), "strict file system handling (no case folding)")
+
+            ("encoding", bpo::value<Files::EscapeHashString>()->
+                default_value("win1252"),
+                "Character encoding used in OpenMW game messages:\n"
+                "\n\twin1250 - Central and Eastern European such as Polish, Czech, Slovak, Hungarian, Slovene, Bosnian, Croatian, Serbian (Latin script), Romanian and Albanian languages\n"
+                "\n\twin1251 - Cyrillic alphabet such as Russian, Bulgarian, Serbian Cyrillic and other languages\n"
+                "\n\twin1252 - Western European (Latin) alphabet, used by default")
+
+            ("output", bpo::value<Files::EscapePath>()->default_value(Files::EscapePath(), ""),
+                "directory to write nav mesh tiles to, by default \"[Navigator] nav mesh disk cache path\" setting is used")
+        ;
+
+        return result;
+    }
+
+    struct Cell
+    {
+        ESM::Cell mCell;
+        std::map<ESM::RefNum, ESM::CellRef> mRefs;
+    };
+
+    struct CollisionObject
+    {
+        osg::ref_ptr<Resource::BulletShapeInstance> mShapeInstance;
+        btTransform mTransform;
+        bool mIsDoor;
+        bool mIsTeleportDoor;
+    };
+
+    struct HeightField
+    {
+        std::unique_ptr<btHeightfieldTerrainShape> mShape;
+        btTransform mTransform;
+    };
+
+    class ContentLoader
+    {
+    public:
+        explicit ContentLoader(ToUTF8::Utf8Encoder& encoder) : mEncoder(encoder) {}
+
+        void load(const Files::Collections& fileCollections, const StringsVector& contentFiles)
+        {
+            mReaders.resize(contentFiles.size());
+
+            for (std::size_t i = 0; i < contentFiles.size(); ++i)
+            {
+                const auto& file = contentFiles[i];
+                const Files::MultiDirCollection& collection = fileCollections.getCollection(boost::filesystem::path(file).extension().string());
+                if (!collection.doesExist(file))
+                    throw std::runtime_error("Content file \"" + file + "\" is not found");
+
+                const std::string path = collection.getPath(file).string();
+                Log(Debug::Info) << "Loading content file " << path;
+
+                ESM::ESMReader& reader = mReaders[i];
+                reader.setEncoder(&mEncoder);
+                reader.setIndex(static_cast<int>(i));
+                reader.setGlobalReaderList(&mReaders);
+                reader.open(path);
+
+                loadRecords(reader);
+            }
+
+            for (auto& cell : mCells)
+                loadRefs(cell.second);
+
+            for (auto& cell : mInteriors)
+                loadRefs(cell.second);
+        }
+
+        const std::map<std::pair<int, int>, Cell>& getCells() const { return mCells; }
+
+        const std::map<std::string, Cell>& getInteriors() const { return mInteriors; }
+
+        const std::map<std::pair<int, int>, ESM::Land>& getLands() const { return mLands; }
+
+        /// Same as MWWorld::Store<ESM::Pathgrid>::search(const ESM::Cell&)
+        const ESM::Pathgrid* getPathgrid(const ESM::Cell& cell) const
+        {
+            if (cell.isExterior())
+            {
+                const auto it = mExteriorPathgrids.find(std::make_pair(cell.getGridX(), cell.getGridY()));
+                return it == mExteriorPathgrids.end() ? nullptr : &it->second;
+            }
+            const auto it = mInteriorPathgrids.find(Misc::StringUtils::lowerCase(cell.mName));
+            return it == mInteriorPathgrids.end() ? nullptr : &it->second;
+        }
+
+        std::string getModel(const std::string& id) const
+        {
+            const auto it = mModels.find(Misc::StringUtils::lowerCase(id));
+            if (it == mModels.end())
+                return std::string();
+            return it->second;
+        }
+
+        bool isDoor(const std::string& id) const
+        {
+            return mDoors.count(Misc::StringUtils::lowerCase(id)) > 0;
+        }
+
+        float getFloatGameSetting(const std::string& id, float defaultValue) const
+        {
+            const auto it = mGameSettings.find(Misc::StringUtils::lowerCase(id));
+            if (it == mGameSettings.end())
+                return defaultValue;
+            return it->second.mValue.getFloat();
+        }
+
+        int getIntGameSetting(const std::string& id, int defaultValue) const
+        {
+            const auto it = mGameSettings.find(Misc::StringUtils::lowerCase(id));
+            if (it == mGameSettings.end())
+                return defaultValue;
+            return it->second.mValue.getInteger();
+        }
+
+    private:
+        ToUTF8::Utf8Encoder& mEncoder;
+        std::vector<ESM::ESMReader> mReaders;
+        std::map<std::pair<int, int>, Cell> mCells;
+        std::map<std::string, Cell> mInteriors;
+        std::map<std::pair<int, int>, ESM::Land> mLands;
+        std::map<std::pair<int, int>, ESM::Pathgrid> mExteriorPathgrids;
+        std::map<std::string, ESM::Pathgrid> mInteriorPathgrids;
+        std::map<std::string, std::string> mModels;
+        std::set<std::string> mDoors;
+        std::map<std::string, ESM::GameSetting> mGameSettings;
+
+        template <class T>
+        void loadObject(ESM::ESMReader& reader)
+        {
+            T record;
+            bool isDeleted = false;
+            record.load(reader, isDeleted);
+            const std::string id = Misc::StringUtils::lowerCase(record.mId);
+            if (isDeleted || record.mModel.empty())
+                mModels.erase(id);
+            else
+                mModels[id] = "meshes\\" + record.mModel;
+            if constexpr (std::is_same_v<T, ESM::Door>)
+            {
+                if (isDeleted)
+                    mDoors.erase(id);
+                else
+                    mDoors.insert(id);
+            }
+        }
+
+        void loadRecords(ESM::ESMReader& reader)
+        {
+            while (reader.hasMoreRecs())
+            {
+                const ESM::NAME name = reader.getRecName();
+                reader.getRecHeader();
+
+                switch (name.intval)
+                {
+                    case ESM::REC_GMST:
+                    {
+                        ESM::GameSetting gameSetting;
+                        bool isDeleted = false;
+                        gameSetting.load(reader, isDeleted);
+                        if (isDeleted)
+                            mGameSettings.erase(Misc::StringUtils::lowerCase(gameSetting.mId));
+                        else
+                            mGameSettings[Misc::StringUtils::lowerCase(gameSetting.mId)] = gameSetting;
+                        break;
+                    }
+                    case ESM::REC_STAT:
+                        loadObject<ESM::Static>(reader);
+                        break;
+                    case ESM::REC_ACTI:
+                        loadObject<ESM::Activator>(reader);
+                        break;
+                    case ESM::REC_CONT:
+                        loadObject<ESM::Container>(reader);
+                        break;
+                    case ESM::REC_LIGH:
+                        loadObject<ESM::Light>(reader);
+                        break;
+                    case ESM::REC_DOOR:
+                        loadObject<ESM::Door>(reader);
+                        break;
+                    case ESM::REC_CELL:
+                        loadCell(reader);
+                        break;
+                    case ESM::REC_LAND:
+                    {
+                        ESM::Land land;
+                        bool isDeleted = false;
+                        land.load(reader, isDeleted);
+                        if (isDeleted)
+                            mLands.erase(std::make_pair(land.mX, land.mY));
+                        else
+                            mLands[std::make_pair(land.mX, land.mY)] = land;
+                        break;
+                    }
+                    case ESM::REC_PGRD:
+                        loadPathgrid(reader);
+                        break;
+                    default:
+                        reader.skipRecord();
+                        break;
+                }
+            }
+        }
+
+        void loadCell(ESM::ESMReader& reader)
+        {
+            ESM::Cell cell;
+            bool isDeleted = false;
+            cell.loadNameAndData(reader, isDeleted);
+
+            // Merge like MWWorld::Store<ESM::Cell> does: keep contexts of all content files
+            Cell& result = cell.isExterior()
+                ? mCells[std::make_pair(cell.getGridX(), cell.getGridY())]
+                : mInteriors[Misc::StringUtils::lowerCase(cell.mName)];
+            result.mCell.mData = cell.mData;
+            result.mCell.mName = cell.mName;
+            result.mCell.mCellId = cell.mCellId;
+            result.mCell.loadCell(reader, true);
+        }
+
+        void loadPathgrid(ESM::ESMReader& reader)
+        {
+            ESM::Pathgrid pathgrid;
+            bool isDeleted = false;
+            pathgrid.load(reader, isDeleted);
+
+            // Same heuristic as MWWorld::Store<ESM::Pathgrid>::load uses to tell interior pathgrids
+            const std::string cellId = Misc::StringUtils::lowerCase(pathgrid.mCell);
+            if (mInteriors.count(cellId) > 0)
+                mInteriorPathgrids[cellId] = pathgrid;
+            else
+                mExteriorPathgrids[std::make_pair(pathgrid.mData.mX, pathgrid.mData.mY)] = pathgrid;
+        }
+
+        void loadRefs(Cell& cell)
+        {
+            for (std::size_t i = 0; i < cell.mCell.mContextList.size(); ++i)
+            {
+                const int index = cell.mCell.mContextList[i].index;
+                ESM::ESMReader& reader = mReaders[index];
+                cell.mCell.restore(reader, static_cast<int>(i));
+
+                ESM::CellRef ref;
+                bool isDeleted = false;
+                while (ESM::Cell::getNextRef(reader, ref, isDeleted))
+                {
+                    // References moved into other cells are ignored, as they are relatively rare
+                    if (isDeleted)
+                        cell.mRefs.erase(ref.mRefNum);
+                    else
+                        cell.mRefs[ref.mRefNum] = ref;
+                }
+            }
+        }
+    };
+
+    /// Collision objects used to place door off mesh connections like MWPhysics::PhysicsSystem does
+    class CollisionWorld
+    {
+    public:
+        CollisionWorld()
+            : mDispatcher(&mConfiguration)
+            , mWorld(&mDispatcher, &mBroadphase, &mConfiguration)
+        {
+        }
+
+        ~CollisionWorld()
+        {
+            for (const auto& object : mObjects)
+                mWorld.removeCollisionObject(object.get());
+        }
+
+        void addObject(btCollisionShape& shape, const btTransform& transform)
+        {
+            auto object = std::make_unique<btCollisionObject>();
+            object->setCollisionShape(&shape);
+            object->setWorldTransform(transform);
+            mWorld.addCollisionObject(object.get());
+            mObjects.push_back(std::move(object));
+        }
+
+        void addWater(float level)
+        {
+            mWaterShapes.push_back(std::make_unique<btStaticPlaneShape>(btVector3(0, 0, 1), level));
+            addObject(*mWaterShapes.back(), btTransform::getIdentity());
+        }
+
+        std::optional<osg::Vec3f> castRay(const osg::Vec3f& from, const osg::Vec3f& to) const
+        {
+            const btVector3 btFrom = Misc::Convert::toBullet(from);
+            const btVector3 btTo = Misc::Convert::toBullet(to);
+            btCollisionWorld::ClosestRayResultCallback callback(btFrom, btTo);
+            mWorld.rayTest(btFrom, btTo, callback);
+            if (!callback.hasHit())
+                return std::nullopt;
+            return Misc::Convert::toOsg(callback.m_hitPointWorld);
+        }
+
+    private:
+        btDefaultCollisionConfiguration mConfiguration;
+        btCollisionDispatcher mDispatcher;
+        btDbvtBroadphase mBroadphase;
+        btCollisionWorld mWorld;
+        std::vector<std::unique_ptr<btCollisionObject>> mObjects;
+        std::vector<std::unique_ptr<btStaticPlaneShape>> mWaterShapes;
+    };
+
+    osg::Quat makeObjectOsgQuat(const ESM::Position& position)
+    {
+        const float xr = position.rot[0];
+        const float yr = position.rot[1];
+        const float zr = position.rot[2];
+
+        return osg::Quat(zr, osg::Vec3(0, 0, -1))
+            * osg::Quat(yr, osg::Vec3(0, -1, 0))
+            * osg::Quat(xr, osg::Vec3(-1, 0, 0));
+    }
+
+    HeightField makeHeightField(const ESM::Land* land, int cellX, int cellY)
+    {
+        static std::vector<float> defaultHeights(ESM::Land::LAND_NUM_VERTS, ESM::Land::DEFAULT_HEIGHT);
+
+        const ESM::Land::LandData* data = nullptr;
+        if (land != nullptr)
+        {
+            land->loadData(ESM::Land::DATA_VHGT);
+            data = land->getLandData(ESM::Land::DATA_VHGT);
+        }
+
+        const float* heights = data ? data->mHeights : defaultHeights.data();
+        const float minHeight = data ? data->mMinHeight : ESM::Land::DEFAULT_HEIGHT;
+        const float maxHeight = data ? data->mMaxHeight : ESM::Land::DEFAULT_HEIGHT;
+        const float sqrtVerts = ESM::Land::LAND_SIZE;
+        const float triSize = ESM::Land::REAL_SIZE / (sqrtVerts - 1);
+
+        // Same shape as MWPhysics::HeightField has
+        HeightField result;
+        result.mShape = std::make_unique<btHeightfieldTerrainShape>(sqrtVerts, sqrtVerts, heights, 1,
+            minHeight, maxHeight, 2, PHY_FLOAT, false);
+        result.mShape->setUseDiamondSubdivision(true);
+        result.mShape->setLocalScaling(btVector3(triSize, triSize, 1));
+        result.mTransform = btTransform(btQuaternion::getIdentity(),
+            btVector3((cellX + 0.5f) * triSize * (sqrtVerts - 1), (cellY + 0.5f) * triSize * (sqrtVerts - 1),
+                      (maxHeight + minHeight) * 0.5f));
+        return result;
+    }
+
+    /// Keep in sync with getModel from apps/openmw/mwworld/scene.cpp
+    bool isHiddenMarker(const std::string& id)
+    {
+        const std::string lowerId = Misc::StringUtils::lowerCase(id);
+        return lowerId == "prisonmarker" || lowerId == "divinemarker" || lowerId == "templemarker"
+            || lowerId == "northmarker";
+    }
+
+    std::vector<CollisionObject> makeCollisionObjects(const ContentLoader& contentLoader,
+        Resource::BulletShapeManager& bulletShapeManager, const Cell& cell)
+    {
+        std::vector<CollisionObject> result;
+        for (const auto& [refNum, ref] : cell.mRefs)
+        {
+            if (isHiddenMarker(ref.mRefID))
+                continue;
+
+            const std::string model = contentLoader.getModel(ref.mRefID);
+            if (model.empty())
+                continue;
+
+            const osg::ref_ptr<Resource::BulletShapeInstance> shapeInstance = bulletShapeManager.getInstance(model);
+            if (!shapeInstance || !shapeInstance->getCollisionShape())
+                continue;
+
+            const float scale = ref.mScale;
+            shapeInstance->setLocalScaling(btVector3(scale, scale, scale));
+
+            const btTransform transform(Misc::Convert::toBullet(makeObjectOsgQuat(ref.mPos)),
+                                        Misc::Convert::toBullet(ref.mPos.asVec3()));
+
+            const bool isDoor = contentLoader.isDoor(ref.mRefID);
+            result.push_back(CollisionObject {shapeInstance, transform, isDoor, isDoor && ref.mTeleport});
+        }
+        return result;
+    }
+
+    void addCollisionObjects(CollisionWorld& world, const std::vector<CollisionObject>& objects)
+    {
+        // Doors have own collision type which is not used by MWWorld::Scene to place off mesh connections
+        for (const auto& object : objects)
+            if (!object.mIsDoor)
+                world.addObject(*object.mShapeInstance->getCollisionShape(), object.mTransform);
+    }
+
+    /// Keep in sync with addObject from apps/openmw/mwworld/scene.cpp
+    void addObject(DetourNavigator::Navigator& navigator, const CollisionWorld& world, const CollisionObject& object,
+        float maxActivationDistance)
+    {
+        const btCollisionShape& shape = *object.mShapeInstance->getCollisionShape();
+        const btCollisionShape* const avoid = object.mShapeInstance->getAvoidCollisionShape();
+        const DetourNavigator::ObjectId id(object.mShapeInstance.get());
+
+        if (!object.mIsDoor || object.mIsTeleportDoor)
+        {
+            navigator.addObject(id, DetourNavigator::ObjectShapes(shape, avoid), object.mTransform);
+            return;
+        }
+
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        shape.getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+
+        const auto center = (aabbMax + aabbMin) * 0.5f;
+
+        const auto distanceFromDoor = maxActivationDistance * 0.5f;
+        const auto toPoint = aabbMax.x() - aabbMin.x() < aabbMax.y() - aabbMin.y()
+                ? btVector3(distanceFromDoor, 0, 0)
+                : btVector3(0, distanceFromDoor, 0);
+
+        // Doors are not opened yet, so the reference transform is the closed door transform
+        const auto getConnectionPoint = [&] (const btVector3& point)
+        {
+            const auto start = Misc::Convert::makeOsgVec3f(object.mTransform(point));
+            return world.castRay(start, start - osg::Vec3f(0, 0, 1000)).value_or(start);
+        };
+
+        navigator.addObject(id,
+            DetourNavigator::DoorShapes(shape, avoid, getConnectionPoint(center + toPoint),
+                                        getConnectionPoint(center - toPoint)),
+            object.mTransform);
+    }
+
+    int runNavMeshTool(int argc, char *argv[])
+    {
+        bpo::options_description desc = makeOptionsDescription();
+
+        bpo::parsed_options options = bpo::command_line_parser(argc, argv)
+            .options(desc).allow_unregistered().run();
+        bpo::variables_map variables;
+
+        bpo::store(options, variables);
+        bpo::notify(variables);
+
+        if (variables.find("help") != variables.end())
+        {
+            getRawStdout() << desc << std::endl;
+            return 0;
+        }
+
+        Files::ConfigurationManager config;
+
+        bpo::variables_map composingVariables = config.separateComposingVariables(variables, desc);
+        config.readConfiguration(variables, desc);
+        config.mergeComposingVariables(variables, composingVariables, desc);
+
+        const std::string encoding(variables["encoding"].as<Files::EscapeHashString>().toStdString());
+        Log(Debug::Info) << ToUTF8::encodingUsingMessage(encoding);
+        ToUTF8::Utf8Encoder encoder(ToUTF8::calculateEncoding(encoding));
+
+        Files::PathContainer dataDirs(Files::EscapePath::toPathContainer(variables["data"].as<Files::EscapePathContainer>()));
+
+        const auto local = variables["data-local"].as<Files::EscapePath>().mPath;
+        if (!local.empty())
+            dataDirs.push_back(local);
+
+        config.processPaths(dataDirs);
+
+        const bool fsStrict = variables["fs-strict"].as<bool>();
+        const StringsVector archives = variables["fallback-archive"].as<Files::EscapeStringVector>().toStdStringVector();
+        const StringsVector contentFiles = variables["content"].as<Files::EscapeStringVector>().toStdStringVector();
+
+        if (contentFiles.empty())
+        {
+            Log(Debug::Error) << "No content file given (esm/esp, nor omwgame/omwaddon). Aborting...";
+            return 1;
+        }
+
+        Settings::Manager settings;
+        const std::string localDefault = (config.getLocalPath() / "settings-default.cfg").string();
+        const std::string globalDefault = (config.getGlobalPath() / "settings-default.cfg").string();
+        if (boost::filesystem::exists(localDefault))
+            settings.loadDefault(localDefault);
+        else if (boost::filesystem::exists(globalDefault))
+            settings.loadDefault(globalDefault);
+        else
+            throw std::runtime_error("No default settings file found! Make sure the file \"settings-default.cfg\" was properly installed.");
+
+        const std::string userSettings = (config.getUserConfigPath() / "settings.cfg").string();
+        if (boost::filesystem::exists(userSettings))
+            settings.loadUser(userSettings);
+
+        auto navigatorSettings = DetourNavigator::makeSettingsFromSettingsManager();
+        if (!navigatorSettings)
+            navigatorSettings = DetourNavigator::Settings();
+
+        const auto output = variables["output"].as<Files::EscapePath>().mPath;
+        if (!output.empty())
+            navigatorSettings->mNavMeshDiskCachePath = output.string();
+        else if (navigatorSettings->mNavMeshDiskCachePath.empty())
+            navigatorSettings->mNavMeshDiskCachePath = (config.getUserDataPath() / "navmesh").string();
+        navigatorSettings->mEnableNavMeshDiskCache = true;
+
+        VFS::Manager vfs(fsStrict);
+        VFS::registerArchives(&vfs, Files::Collections(dataDirs, !fsStrict), archives, true,
+            Settings::Manager::getBool("memory map archives", "General"));
+
+        Resource::ResourceSystem resourceSystem(&vfs);
+        Resource::BulletShapeManager bulletShapeManager(&vfs, resourceSystem.getSceneManager(),
+                                                        resourceSystem.getNifFileManager());
+
+        ContentLoader contentLoader(encoder);
+        contentLoader.load(Files::Collections(dataDirs, !fsStrict), contentFiles);
+
+        // Same values as MWWorld::World uses
+        navigatorSettings->mMaxClimb = Constants::StepSizeUp;
+        navigatorSettings->mMaxSlope = Constants::MaxSlope;
+        navigatorSettings->mSwimHeightScale = contentLoader.getFloatGameSetting("fSwimHeightScale", 0.9f);
+        const float maxActivationDistance = static_cast<float>(contentLoader.getIntGameSetting("iMaxActivateDist", 192));
+
+        DetourNavigator::RecastGlobalAllocator::init();
+
+        // Actors use the player half extents in exteriors, see MWWorld::World::getPathfindingHalfExtents.
+        // In interiors each actor has own half extents, only player size agent is generated for them.
+        const auto playerShape = bulletShapeManager.getShape("meshes\\base_anim.nif");
+        if (!playerShape)
+            throw std::runtime_error("Failed to load player collision shape");
+        const osg::Vec3f agentHalfExtents = playerShape->mCollisionBox.extents;
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t total = contentLoader.getCells().size() + contentLoader.getInteriors().size();
+        std::size_t processed = 0;
+
+        {
+            DetourNavigator::NavigatorImpl navigator(*navigatorSettings);
+            navigator.addAgent(agentHalfExtents);
+
+            CollisionWorld world;
+            std::map<std::pair<int, int>, HeightField> heightFields;
+            std::map<std::pair<int, int>, std::vector<CollisionObject>> objects;
+            std::size_t objectsCount = 0;
+
+            // All exterior cells are loaded into physics before the navigator to cast door rays like the game does
+            for (const auto& [position, cell] : contentLoader.getCells())
+            {
+                const auto land = contentLoader.getLands().find(position);
+                const HeightField& heightField = heightFields[position] = makeHeightField(
+                    land == contentLoader.getLands().end() ? nullptr : &land->second, position.first, position.second);
+                world.addObject(*heightField.mShape, heightField.mTransform);
+
+                const auto& cellObjects = objects[position] = makeCollisionObjects(contentLoader, bulletShapeManager, cell);
+                addCollisionObjects(world, cellObjects);
+                objectsCount += cellObjects.size();
+            }
+
+            // See MWWorld::CellStore::getWaterLevel
+            const float exteriorWaterLevel = -1;
+            world.addWater(exteriorWaterLevel);
+
+            Log(Debug::Info) << "Loaded " << contentLoader.getCells().size() << " exterior cells with "
+                             << objectsCount << " collision objects";
+
+            // Same order as MWWorld::Scene::loadCell uses
+            for (const auto& [position, cell] : contentLoader.getCells())
+            {
+                const HeightField& heightField = heightFields.at(position);
+                navigator.addObject(DetourNavigator::ObjectId(heightField.mShape.get()), *heightField.mShape,
+                                    heightField.mTransform);
+
+                if (const auto pathgrid = contentLoader.getPathgrid(cell.mCell))
+                    navigator.addPathgrid(cell.mCell, *pathgrid);
+
+                for (const auto& object : objects.at(position))
+                    addObject(navigator, world, object, maxActivationDistance);
+
+                navigator.addWater(osg::Vec2i(position.first, position.second), ESM::Land::REAL_SIZE,
+                                   exteriorWaterLevel, heightField.mTransform);
+            }
+
+            for (const auto& [position, cell] : contentLoader.getCells())
+            {
+                const osg::Vec3f playerPosition((position.first + 0.5f) * ESM::Land::REAL_SIZE,
+                                                (position.second + 0.5f) * ESM::Land::REAL_SIZE, 0);
+                navigator.update(playerPosition);
+                navigator.wait();
+
+                ++processed;
+                Log(Debug::Verbose) << "Generated nav mesh tiles around cell (" << position.first << ", "
+                                    << position.second << ") " << processed << "/" << total;
+            }
+        }
+
+        {
+            DetourNavigator::NavigatorImpl navigator(*navigatorSettings);
+            navigator.addAgent(agentHalfExtents);
+
+            // Interiors share the same coordinates, so only one is loaded at a time like in the game
+            for (const auto& [id, cell] : contentLoader.getInteriors())
+            {
+                ++processed;
+
+                const std::vector<CollisionObject> objects = makeCollisionObjects(contentLoader, bulletShapeManager, cell);
+                if (objects.empty())
+                    continue;
+
+                CollisionWorld world;
+                addCollisionObjects(world, objects);
+
+                const bool hasWater = cell.mCell.hasWater();
+                if (hasWater)
+                    world.addWater(cell.mCell.mWater);
+
+                const auto pathgrid = contentLoader.getPathgrid(cell.mCell);
+                if (pathgrid)
+                    navigator.addPathgrid(cell.mCell, *pathgrid);
+
+                for (const auto& object : objects)
+                    addObject(navigator, world, object, maxActivationDistance);
+
+                const osg::Vec2i cellPosition(cell.mCell.getGridX(), cell.mCell.getGridY());
+                if (hasWater)
+                    navigator.addWater(cellPosition, std::numeric_limits<int>::max(), cell.mCell.mWater,
+                                       btTransform::getIdentity());
+
+                // Interiors are not limited by cell size, so cover all objects like exterior cells are covered
+                osg::Vec3f min = Misc::Convert::toOsg(objects.front().mTransform.getOrigin());
+                osg::Vec3f max = min;
+                for (const auto& object : objects)
+                {
+                    const osg::Vec3f position = Misc::Convert::toOsg(object.mTransform.getOrigin());
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        min[i] = std::min(min[i], position[i]);
+                        max[i] = std::max(max[i], position[i]);
+                    }
+                }
+                for (float x = min.x(); x < max.x() + ESM::Land::REAL_SIZE; x += ESM::Land::REAL_SIZE)
+                    for (float y = min.y(); y < max.y() + ESM::Land::REAL_SIZE; y += ESM::Land::REAL_SIZE)
+                    {
+                        navigator.update(osg::Vec3f(x, y, (min.z() + max.z()) * 0.5f));
+                        navigator.wait();
+                    }
+
+                for (const auto& object : objects)
+                    navigator.removeObject(DetourNavigator::ObjectId(object.mShapeInstance.get()));
+                if (hasWater)
+                    navigator.removeWater(cellPosition);
+                if (pathgrid)
+                    navigator.removePathgrid(*pathgrid);
+
+                Log(Debug::Verbose) << "Generated nav mesh tiles for cell \"" << cell.mCell.mName << "\" "
+                                    << processed << "/" << total;
+            }
+        }
+
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        Log(Debug::Info) << "Generated nav mesh tiles for " << contentLoader.getCells().size() << " exterior and "
+                         << contentLoader.getInteriors().size() << " interior cells in " << duration.count() << " ms to "
+                         << navigatorSettings->mNavMeshDiskCachePath;
+
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    return wrapApplication(NavMeshTool::runNavMeshTool, argc, argv, "NavMeshTool");
+}
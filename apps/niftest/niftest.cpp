@@ -3,6 +3,8 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <chrono>
+#include <iomanip>
 
 #include <components/nif/niffile.hpp>
 #include <components/files/constrainedfilestream.hpp>
@@ -43,6 +45,43 @@ bool isBSA(const std::string & filename)
     return hasExtension(filename,"bsa");
 }
 
+///Total size and parse time of the checked nif files
+struct ParseStats
+{
+    std::size_t mFiles = 0;
+    std::size_t mBytes = 0;
+    std::chrono::steady_clock::duration mTime {};
+};
+
+ParseStats parseStats;
+
+///Parse the nif file and add it to the parse statistics
+void readNIF(Files::IStreamPtr stream, const std::string& name)
+{
+    stream->seekg(0, std::ios::end);
+    const std::streamoff size = stream->tellg();
+    stream->seekg(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    Nif::NIFFile temp_nif(stream, name);
+    parseStats.mTime += std::chrono::steady_clock::now() - start;
+    parseStats.mFiles += 1;
+    if (size > 0)
+        parseStats.mBytes += static_cast<std::size_t>(size);
+}
+
+///Print total parse throughput of successfully parsed files
+void printParseStats()
+{
+    const double seconds = std::chrono::duration<double>(parseStats.mTime).count();
+    const double megabytes = parseStats.mBytes / (1024.0 * 1024.0);
+    std::cout << "Parsed " << parseStats.mFiles << " nif files, " << std::fixed << std::setprecision(3)
+              << megabytes << " MiB in " << seconds << " s";
+    if (seconds > 0)
+        std::cout << " (" << megabytes / seconds << " MiB/s)";
+    std::cout << std::endl;
+}
+
 /// Check all the nif files in a given VFS::Archive
 /// \note Takes ownership!
 /// \note Can not read a bsa file inside of a bsa file.
@@ -61,7 +100,7 @@ void readVFS(VFS::Archive* anArchive,std::string archivePath = "")
             if(isNIF(name))
             {
             //           std::cout << "Decoding: " << name << std::endl;
-                Nif::NIFFile temp_nif(myManager.get(name),archivePath+name);
+                readNIF(myManager.get(name),archivePath+name);
             }
             else if(isBSA(name))
             {
@@ -85,7 +124,7 @@ bool parseOptions (int argc, char** argv, std::vector<std::string>& files)
     bpo::options_description desc("Ensure that OpenMW can use the provided NIF and BSA files\n\n"
         "Usages:\n"
         "  niftool <nif files, BSA files, or directories>\n"
-        "      Scan the file or directories for nif errors.\n\n"
+        "      Scan the file or directories for nif errors and report the parse throughput.\n\n"
         "Allowed options");
     desc.add_options()
         ("help,h", "print help message.")
@@ -143,7 +182,7 @@ int main(int argc, char **argv)
             if(isNIF(name))
             {
                 //std::cout << "Decoding: " << name << std::endl;
-                Nif::NIFFile temp_nif(Files::openConstrainedFileStream(name.c_str()),name);
+                readNIF(Files::openConstrainedFileStream(name.c_str()),name);
              }
              else if(isBSA(name))
              {
@@ -165,5 +204,6 @@ int main(int argc, char **argv)
             std::cerr << "ERROR, an exception has occurred:  " << e.what() << std::endl;
         }
      }
+     printParseStats();
      return 0;
 }
@@ -1,8 +1,12 @@
 #include "operation.hpp"
 
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <QRunnable>
+#include <QThreadPool>
 #include <QTimer>
 
 #include "../world/universalid.hpp"
@@ -10,6 +14,23 @@
 #include "state.hpp"
 #include "stage.hpp"
 
+namespace
+{
+    class StageTask : public QRunnable
+    {
+            std::function<void()> mFunction;
+
+        public:
+
+            StageTask (std::function<void()> function) : mFunction (std::move (function)) {}
+
+            void run() override
+            {
+                mFunction();
+            }
+    };
+}
+
 void CSMDoc::Operation::prepareStages()
 {
     mCurrentStage = mStages.begin();
@@ -29,13 +50,20 @@ CSMDoc::Operation::Operation (int type, bool ordered, bool finalAlways)
 : mType (type), mStages(std::vector<std::pair<Stage *, int> >()), mCurrentStage(mStages.begin()),
   mCurrentStep(0), mCurrentStepTotal(0), mTotalSteps(0), mOrdered (ordered),
   mFinalAlways (finalAlways), mError(false), mConnected (false), mPrepared (false),
-  mDefaultSeverity (Message::Severity_Error)
+  mDefaultSeverity (Message::Severity_Error), mThreadPool (nullptr), mAborted (false), mParallelStepsDone (0),
+  mParallelFailed (false), mNextReportedStage (0)
 {
     mTimer = new QTimer (this);
 }
 
 CSMDoc::Operation::~Operation()
 {
+    if (mThreadPool)
+    {
+        mAborted = true;
+        mThreadPool->waitForDone();
+    }
+
     for (std::vector<std::pair<Stage *, int> >::iterator iter (mStages.begin()); iter!=mStages.end(); ++iter)
         delete iter->first;
 }
@@ -52,7 +80,8 @@ void CSMDoc::Operation::run()
 
     mPrepared = false;
 
-    mTimer->start (0);
+    // Parallel stages don't need the operation thread, so only poll them for progress and messages
+    mTimer->start (mThreadPool ? 10 : 0);
 }
 
 void CSMDoc::Operation::appendStage (Stage *stage)
@@ -65,6 +94,17 @@ void CSMDoc::Operation::setDefaultSeverity (Message::Severity severity)
     mDefaultSeverity = severity;
 }
 
+void CSMDoc::Operation::setParallel (bool parallel)
+{
+    if (parallel && !mThreadPool)
+        mThreadPool = new QThreadPool (this);
+    else if (!parallel && mThreadPool)
+    {
+        delete mThreadPool;
+        mThreadPool = nullptr;
+    }
+}
+
 bool CSMDoc::Operation::hasError() const
 {
     return mError;
@@ -77,6 +117,13 @@ void CSMDoc::Operation::abort()
 
     mError = true;
 
+    if (mThreadPool)
+    {
+        // Stages that are already running finish their current step
+        mAborted = true;
+        return;
+    }
+
     if (mFinalAlways)
     {
         if (mStages.begin()!=mStages.end() && mCurrentStage!=--mStages.end())
@@ -95,6 +142,15 @@ void CSMDoc::Operation::executeStage()
     {
         prepareStages();
         mPrepared = true;
+
+        if (mThreadPool)
+            startParallelStages();
+    }
+
+    if (mThreadPool)
+    {
+        executeParallelStages();
+        return;
     }
 
     Messages messages (mDefaultSeverity);
@@ -132,6 +188,75 @@ void CSMDoc::Operation::executeStage()
         operationDone();
 }
 
+void CSMDoc::Operation::startParallelStages()
+{
+    mAborted = false;
+    mParallelStepsDone = 0;
+    mParallelFailed = false;
+    mNextReportedStage = 0;
+
+    mStageMessages.clear();
+    for (std::size_t i = 0; i<mStages.size(); ++i)
+        mStageMessages.push_back (std::make_unique<Messages> (mDefaultSeverity));
+
+    mStagesDone.assign (mStages.size(), false);
+
+    for (std::size_t i = 0; i<mStages.size(); ++i)
+        mThreadPool->start (new StageTask ([this, i] { performParallelStage (i); }));
+}
+
+void CSMDoc::Operation::performParallelStage (std::size_t index)
+{
+    Stage& stage = *mStages[index].first;
+    const int steps = mStages[index].second;
+    Messages& messages = *mStageMessages[index];
+    bool failed = false;
+
+    try
+    {
+        for (int step = 0; step<steps && !mAborted; ++step)
+        {
+            stage.perform (step, messages);
+            ++mParallelStepsDone;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        messages.add (CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError);
+        failed = true;
+        mAborted = true;
+    }
+
+    std::lock_guard<std::mutex> lock (mParallelMutex);
+    mStagesDone[index] = true;
+    mParallelFailed = mParallelFailed || failed;
+}
+
+void CSMDoc::Operation::executeParallelStages()
+{
+    std::vector<std::unique_ptr<Messages> > finished;
+
+    {
+        std::lock_guard<std::mutex> lock (mParallelMutex);
+
+        // Report only a prefix of finished stages to keep the order of messages independent of scheduling
+        while (mNextReportedStage<mStages.size() && mStagesDone[mNextReportedStage])
+            finished.push_back (std::move (mStageMessages[mNextReportedStage++]));
+
+        if (mParallelFailed)
+            mError = true;
+    }
+
+    emit progress (mParallelStepsDone, mTotalSteps ? mTotalSteps : 1, mType);
+
+    for (const std::unique_ptr<Messages>& messages : finished)
+        for (Messages::Iterator iter (messages->begin()); iter!=messages->end(); ++iter)
+            emit reportMessage (*iter, mType);
+
+    if (mNextReportedStage==mStages.size())
+        operationDone();
+}
+
 void CSMDoc::Operation::operationDone()
 {
     mTimer->stop();
@@ -1,13 +1,18 @@
 #ifndef CSM_DOC_OPERATION_H
 #define CSM_DOC_OPERATION_H
 
-#include <vector>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <QObject>
 #include <QTimer>
 #include <QStringList>
 
+class QThreadPool;
+
 #include "messages.hpp"
 
 namespace CSMWorld
@@ -36,9 +41,24 @@ namespace CSMDoc
             QTimer *mTimer;
             bool mPrepared;
             Message::Severity mDefaultSeverity;
+            QThreadPool *mThreadPool;
+            std::atomic_bool mAborted;
+            std::atomic_int mParallelStepsDone;
+            std::mutex mParallelMutex;
+            std::vector<std::unique_ptr<Messages> > mStageMessages; // guarded by mParallelMutex
+            std::vector<bool> mStagesDone; // guarded by mParallelMutex
+            bool mParallelFailed; // guarded by mParallelMutex
+            std::size_t mNextReportedStage;
 
             void prepareStages();
 
+            void startParallelStages();
+
+            /// Called from a thread of mThreadPool.
+            void performParallelStage (std::size_t index);
+
+            void executeParallelStages();
+
         public:
 
             Operation (int type, bool ordered, bool finalAlways = false);
@@ -55,6 +75,15 @@ namespace CSMDoc
             /// \attention Do no call this function while this Operation is running.
             void setDefaultSeverity (Message::Severity severity);
 
+            /// Execute all stages concurrently on a thread pool. Each stage still performs its steps in order and
+            /// messages are reported in the order of stages, so the result doesn't depend on scheduling. Stage::setup
+            /// is called from the operation thread before any stage is performed.
+            ///
+            /// Only valid for unordered operations whose stages don't modify any shared state in Stage::perform.
+            ///
+            /// \attention Do no call this function while this Operation is running.
+            void setParallel (bool parallel);
+
             bool hasError() const;
 
         signals:
@@ -205,11 +205,11 @@ int CSMTools::CleanupLandTexturesMergeStage::setup()
 void CSMTools::CleanupLandTexturesMergeStage::perform (int stage, CSMDoc::Messages& messages)
 {
     auto& landTextures = mState.mTarget->getData().getLandTextures();
-    for (int i = 0; i < landTextures.getSize(); )
+    std::vector<int> unmodified;
+    for (int i = 0; i < landTextures.getSize(); ++i)
     {
         if (!landTextures.getRecord(i).isModified())
-            landTextures.removeRows(i, 1);
-        else
-            ++i;
+            unmodified.push_back(i);
     }
+    landTextures.removeRecords(unmodified);
 }
@@ -57,6 +57,9 @@ CSMDoc::OperationHolder *CSMTools::Tools::getVerifier()
     {
         mVerifierOperation = new CSMDoc::Operation (CSMDoc::State_Verifying, false);
 
+        // The document is locked while verifying, so all stages can read the data at the same time
+        mVerifierOperation->setParallel (true);
+
         connect (&mVerifier, SIGNAL (progress (int, int, int)), this, SIGNAL (progress (int, int, int)));
         connect (&mVerifier, SIGNAL (done (int, bool)), this, SIGNAL (done (int, bool)));
         connect (&mVerifier, SIGNAL (reportMessage (const CSMDoc::Message&, int)),
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 #include <cctype>
 #include <stdexcept>
@@ -75,7 +76,11 @@ namespace CSMWorld
     }
 
     /// \brief Single-type record collection
-    template<typename ESXRecordT, typename IdAccessorT = IdAccessor<ESXRecordT> >
+    ///
+    /// \param IndexT Map from lower case ID to record index. Hash map by default, collections that depend on the
+    /// order of IDs can use std::map.
+    template<typename ESXRecordT, typename IdAccessorT = IdAccessor<ESXRecordT>,
+        typename IndexT = std::unordered_map<std::string, int> >
     class Collection : public CollectionBase
     {
         public:
@@ -85,7 +90,7 @@ namespace CSMWorld
         private:
 
             std::vector<Record<ESXRecordT> > mRecords;
-            std::map<std::string, int> mIndex;
+            IndexT mIndex;
             std::vector<Column<ESXRecordT> *> mColumns;
 
             // not implemented
@@ -94,7 +99,7 @@ namespace CSMWorld
 
         protected:
 
-            const std::map<std::string, int>& getIdMap() const;
+            const IndexT& getIdMap() const;
 
             const std::vector<Record<ESXRecordT> >& getRecords() const;
 
@@ -142,6 +147,9 @@ namespace CSMWorld
 
             void removeRows (int index, int count) override;
 
+            void removeRecords (const std::vector<int>& indices) override;
+            ///< Remove records at \a indices in a single pass over the collection.
+
             void appendBlankRecord (const std::string& id,
                 UniversalId::Type type = UniversalId::Type_None) override;
             ///< \param type Will be ignored, unless the collection supports multiple record types
@@ -204,20 +212,20 @@ namespace CSMWorld
             NestableColumn *getNestableColumn (int column) const;
     };
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    const std::map<std::string, int>& Collection<ESXRecordT, IdAccessorT>::getIdMap() const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    const IndexT& Collection<ESXRecordT, IdAccessorT, IndexT>::getIdMap() const
     {
         return mIndex;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    const std::vector<Record<ESXRecordT> >& Collection<ESXRecordT, IdAccessorT>::getRecords() const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    const std::vector<Record<ESXRecordT> >& Collection<ESXRecordT, IdAccessorT, IndexT>::getRecords() const
     {
         return mRecords;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    bool Collection<ESXRecordT, IdAccessorT>::reorderRowsImp (int baseIndex,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    bool Collection<ESXRecordT, IdAccessorT, IndexT>::reorderRowsImp (int baseIndex,
         const std::vector<int>& newOrder)
     {
         if (!newOrder.empty())
@@ -242,8 +250,7 @@ namespace CSMWorld
             std::copy (buffer.begin(), buffer.end(), mRecords.begin()+baseIndex);
 
             // adjust index
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                 ++iter)
+            for (typename IndexT::iterator iter (mIndex.begin()); iter!=mIndex.end(); ++iter)
                 if (iter->second>=baseIndex && iter->second<baseIndex+size)
                     iter->second = newOrder.at (iter->second-baseIndex)+baseIndex;
         }
@@ -251,8 +258,8 @@ namespace CSMWorld
         return true;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int Collection<ESXRecordT, IdAccessorT>::cloneRecordImp(const std::string& origin,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int Collection<ESXRecordT, IdAccessorT, IndexT>::cloneRecordImp(const std::string& origin,
         const std::string& destination, UniversalId::Type type)
     {
         Record<ESXRecordT> copy;
@@ -271,8 +278,8 @@ namespace CSMWorld
         return index;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int Collection<ESXRecordT, IdAccessorT>::touchRecordImp(const std::string& id)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int Collection<ESXRecordT, IdAccessorT, IndexT>::touchRecordImp(const std::string& id)
     {
         int index = getIndex(id);
         Record<ESXRecordT>& record = mRecords.at(index);
@@ -290,8 +297,8 @@ namespace CSMWorld
         return -1;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::cloneRecord(const std::string& origin,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::cloneRecord(const std::string& origin,
         const std::string& destination, const UniversalId::Type type)
     {
         cloneRecordImp(origin, destination, type);
@@ -305,8 +312,8 @@ namespace CSMWorld
         mRecords.at(index).get().mPlugin = 0;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    bool Collection<ESXRecordT, IdAccessorT>::touchRecord(const std::string& id)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    bool Collection<ESXRecordT, IdAccessorT, IndexT>::touchRecord(const std::string& id)
     {
         return touchRecordImp(id) != -1;
     }
@@ -324,23 +331,23 @@ namespace CSMWorld
         return false;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    Collection<ESXRecordT, IdAccessorT>::Collection()
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    Collection<ESXRecordT, IdAccessorT, IndexT>::Collection()
     {}
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    Collection<ESXRecordT, IdAccessorT>::~Collection()
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    Collection<ESXRecordT, IdAccessorT, IndexT>::~Collection()
     {
         for (typename std::vector<Column<ESXRecordT> *>::iterator iter (mColumns.begin()); iter!=mColumns.end(); ++iter)
             delete *iter;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::add (const ESXRecordT& record)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::add (const ESXRecordT& record)
     {
         std::string id = Misc::StringUtils::lowerCase (IdAccessorT().getId (record));
 
-        std::map<std::string, int>::iterator iter = mIndex.find (id);
+        typename IndexT::iterator iter = mIndex.find (id);
 
         if (iter==mIndex.end())
         {
@@ -356,20 +363,20 @@ namespace CSMWorld
         }
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int Collection<ESXRecordT, IdAccessorT>::getSize() const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int Collection<ESXRecordT, IdAccessorT, IndexT>::getSize() const
     {
         return mRecords.size();
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    std::string Collection<ESXRecordT, IdAccessorT>::getId (int index) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    std::string Collection<ESXRecordT, IdAccessorT, IndexT>::getId (int index) const
     {
         return IdAccessorT().getId (mRecords.at (index).get());
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int  Collection<ESXRecordT, IdAccessorT>::getIndex (const std::string& id) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int  Collection<ESXRecordT, IdAccessorT, IndexT>::getIndex (const std::string& id) const
     {
         int index = searchId (id);
 
@@ -379,32 +386,32 @@ namespace CSMWorld
         return index;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int Collection<ESXRecordT, IdAccessorT>::getColumns() const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int Collection<ESXRecordT, IdAccessorT, IndexT>::getColumns() const
     {
         return mColumns.size();
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    QVariant Collection<ESXRecordT, IdAccessorT>::getData (int index, int column) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    QVariant Collection<ESXRecordT, IdAccessorT, IndexT>::getData (int index, int column) const
     {
         return mColumns.at (column)->get (mRecords.at (index));
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::setData (int index, int column, const QVariant& data)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::setData (int index, int column, const QVariant& data)
     {
         return mColumns.at (column)->set (mRecords.at (index), data);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    const ColumnBase& Collection<ESXRecordT, IdAccessorT>::getColumn (int column) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    const ColumnBase& Collection<ESXRecordT, IdAccessorT, IndexT>::getColumn (int column) const
     {
         return *mColumns.at (column);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    NestableColumn *Collection<ESXRecordT, IdAccessorT>::getNestableColumn (int column) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    NestableColumn *Collection<ESXRecordT, IdAccessorT, IndexT>::getNestableColumn (int column) const
     {
         if (column < 0 || column >= static_cast<int>(mColumns.size()))
             throw std::runtime_error("column index out of range");
@@ -412,14 +419,14 @@ namespace CSMWorld
         return mColumns.at (column);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::addColumn (Column<ESXRecordT> *column)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::addColumn (Column<ESXRecordT> *column)
     {
         mColumns.push_back (column);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::merge()
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::merge()
     {
         for (typename std::vector<Record<ESXRecordT> >::iterator iter (mRecords.begin()); iter!=mRecords.end(); ++iter)
             iter->merge();
@@ -427,26 +434,67 @@ namespace CSMWorld
         purge();
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void  Collection<ESXRecordT, IdAccessorT>::purge()
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void  Collection<ESXRecordT, IdAccessorT, IndexT>::purge()
     {
-        int i = 0;
+        std::vector<int> erased;
 
-        while (i<static_cast<int> (mRecords.size()))
-        {
+        for (int i=0; i<static_cast<int> (mRecords.size()); ++i)
             if (mRecords[i].isErased())
-                removeRows (i, 1);
+                erased.push_back (i);
+
+        removeRecords (erased);
+    }
+
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::removeRecords (const std::vector<int>& indices)
+    {
+        if (indices.empty())
+            return;
+
+        // new index of each record, -1 for removed ones
+        std::vector<int> newIndices (mRecords.size(), 0);
+
+        for (int index : indices)
+            newIndices.at (index) = -1;
+
+        int size = 0;
+
+        for (int i=0; i<static_cast<int> (mRecords.size()); ++i)
+        {
+            if (newIndices[i]==-1)
+                continue;
+
+            if (size!=i)
+                mRecords[size] = std::move (mRecords[i]);
+
+            newIndices[i] = size++;
+        }
+
+        mRecords.erase (mRecords.begin()+size, mRecords.end());
+
+        typename IndexT::iterator iter = mIndex.begin();
+
+        while (iter!=mIndex.end())
+        {
+            if (newIndices[iter->second]==-1)
+            {
+                iter = mIndex.erase (iter);
+            }
             else
-                ++i;
+            {
+                iter->second = newIndices[iter->second];
+                ++iter;
+            }
         }
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::removeRows (int index, int count)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::removeRows (int index, int count)
     {
         mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
 
-        typename std::map<std::string, int>::iterator iter = mIndex.begin();
+        typename IndexT::iterator iter = mIndex.begin();
 
         while (iter!=mIndex.end())
         {
@@ -467,8 +515,8 @@ namespace CSMWorld
         }
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void  Collection<ESXRecordT, IdAccessorT>::appendBlankRecord (const std::string& id,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void  Collection<ESXRecordT, IdAccessorT, IndexT>::appendBlankRecord (const std::string& id,
         UniversalId::Type type)
     {
         ESXRecordT record;
@@ -482,12 +530,12 @@ namespace CSMWorld
         insertRecord (record2, getAppendIndex (id, type), type);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int Collection<ESXRecordT, IdAccessorT>::searchId (const std::string& id) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int Collection<ESXRecordT, IdAccessorT, IndexT>::searchId (const std::string& id) const
     {
         std::string id2 = Misc::StringUtils::lowerCase(id);
 
-        std::map<std::string, int>::const_iterator iter = mIndex.find (id2);
+        typename IndexT::const_iterator iter = mIndex.find (id2);
 
         if (iter==mIndex.end())
             return -1;
@@ -495,14 +543,14 @@ namespace CSMWorld
         return iter->second;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::replace (int index, const RecordBase& record)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::replace (int index, const RecordBase& record)
     {
         mRecords.at (index) = dynamic_cast<const Record<ESXRecordT>&> (record);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::appendRecord (const RecordBase& record,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::appendRecord (const RecordBase& record,
         UniversalId::Type type)
     {
         insertRecord (record,
@@ -510,43 +558,52 @@ namespace CSMWorld
             dynamic_cast<const Record<ESXRecordT>&> (record).get()), type), type);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    int Collection<ESXRecordT, IdAccessorT>::getAppendIndex (const std::string& id,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    int Collection<ESXRecordT, IdAccessorT, IndexT>::getAppendIndex (const std::string& id,
         UniversalId::Type type) const
     {
         return static_cast<int> (mRecords.size());
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    std::vector<std::string> Collection<ESXRecordT, IdAccessorT>::getIds (bool listDeleted) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    std::vector<std::string> Collection<ESXRecordT, IdAccessorT, IndexT>::getIds (bool listDeleted) const
     {
-        std::vector<std::string> ids;
+        // lower case ID and record index, sorted by ID
+        std::vector<std::pair<std::string, int> > sorted;
+        sorted.reserve (mIndex.size());
 
-        for (typename std::map<std::string, int>::const_iterator iter = mIndex.begin();
-            iter!=mIndex.end(); ++iter)
+        for (typename IndexT::const_iterator iter = mIndex.begin(); iter!=mIndex.end(); ++iter)
         {
             if (listDeleted || !mRecords[iter->second].isDeleted())
-                ids.push_back (IdAccessorT().getId (mRecords[iter->second].get()));
+                sorted.push_back (*iter);
         }
 
+        std::sort (sorted.begin(), sorted.end());
+
+        std::vector<std::string> ids;
+        ids.reserve (sorted.size());
+
+        for (const std::pair<std::string, int>& value : sorted)
+            ids.push_back (IdAccessorT().getId (mRecords[value.second].get()));
+
         return ids;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    const Record<ESXRecordT>& Collection<ESXRecordT, IdAccessorT>::getRecord (const std::string& id) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    const Record<ESXRecordT>& Collection<ESXRecordT, IdAccessorT, IndexT>::getRecord (const std::string& id) const
     {
         int index = getIndex (id);
         return mRecords.at (index);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    const Record<ESXRecordT>& Collection<ESXRecordT, IdAccessorT>::getRecord (int index) const
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    const Record<ESXRecordT>& Collection<ESXRecordT, IdAccessorT, IndexT>::getRecord (int index) const
     {
         return mRecords.at (index);
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::insertRecord (const RecordBase& record, int index,
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::insertRecord (const RecordBase& record, int index,
         UniversalId::Type type)
     {
         if (index<0 || index>static_cast<int> (mRecords.size()))
@@ -558,8 +615,7 @@ namespace CSMWorld
 
         if (index<static_cast<int> (mRecords.size())-1)
         {
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                ++iter)
+            for (typename IndexT::iterator iter (mIndex.begin()); iter!=mIndex.end(); ++iter)
                  if (iter->second>=index)
                      ++(iter->second);
         }
@@ -568,8 +624,8 @@ namespace CSMWorld
             record2.get())), index));
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    void Collection<ESXRecordT, IdAccessorT>::setRecord (int index, const Record<ESXRecordT>& record)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    void Collection<ESXRecordT, IdAccessorT, IndexT>::setRecord (int index, const Record<ESXRecordT>& record)
     {
         if (Misc::StringUtils::lowerCase (IdAccessorT().getId (mRecords.at (index).get()))!=
             Misc::StringUtils::lowerCase (IdAccessorT().getId (record.get())))
@@ -578,8 +634,8 @@ namespace CSMWorld
         mRecords.at (index) = record;
     }
 
-    template<typename ESXRecordT, typename IdAccessorT>
-    bool Collection<ESXRecordT, IdAccessorT>::reorderRows (int baseIndex, const std::vector<int>& newOrder)
+    template<typename ESXRecordT, typename IdAccessorT, typename IndexT>
+    bool Collection<ESXRecordT, IdAccessorT, IndexT>::reorderRows (int baseIndex, const std::vector<int>& newOrder)
     {
         return false;
     }
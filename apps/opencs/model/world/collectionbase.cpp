@@ -1,5 +1,7 @@
 #include "collectionbase.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
 
 #include "columnbase.hpp"
@@ -28,3 +30,23 @@ int CSMWorld::CollectionBase::findColumnIndex (Columns::ColumnId id) const
 
     return index;
 }
+
+void CSMWorld::CollectionBase::removeRecords (const std::vector<int>& indices)
+{
+    std::vector<int> sorted (indices);
+    std::sort (sorted.begin(), sorted.end(), std::greater<int>());
+
+    for (int index : sorted)
+        removeRows (index, 1);
+}
+
+std::vector<int> CSMWorld::CollectionBase::touchRecords (const std::vector<std::string>& ids)
+{
+    std::vector<int> changed;
+
+    for (const std::string& id : ids)
+        if (touchRecord (id))
+            changed.push_back (getIndex (id));
+
+    return changed;
+}
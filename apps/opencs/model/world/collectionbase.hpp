@@ -56,6 +56,14 @@ namespace CSMWorld
 
             virtual void removeRows (int index, int count) = 0;
 
+            virtual void removeRecords (const std::vector<int>& indices);
+            ///< Remove records at \a indices (in any order, without duplicates). Prefer this over
+            /// removeRows when removing many records that are not next to each other.
+
+            virtual std::vector<int> touchRecords (const std::vector<std::string>& ids);
+            ///< Touch all records with \a ids.
+            /// \return Indices of the records that have been changed.
+
             virtual void appendBlankRecord (const std::string& id,
                 UniversalId::Type type = UniversalId::Type_None) = 0;
             ///< \param type Will be ignored, unless the collection supports multiple record types
@@ -212,6 +212,18 @@ void CSMWorld::CommandDispatcher::executeDelete()
 
     int columnIndex = model.findColumnIndex (Columns::ColumnId_Id);
 
+    if (mId.getType() != UniversalId::Type_Referenceables && rows.size()>1)
+    {
+        std::vector<std::string> ids;
+        ids.reserve (rows.size());
+
+        for (std::vector<std::string>::const_iterator iter (rows.begin()); iter!=rows.end(); ++iter)
+            ids.push_back (model.data (model.getModelIndex (*iter, columnIndex)).toString().toUtf8().constData());
+
+        mDocument.getUndoStack().push (new CSMWorld::DeleteRecordsCommand (model, ids));
+        return;
+    }
+
     CommandMacro macro (mDocument.getUndoStack(), rows.size()>1 ? "Delete multiple records" : "");
     for (std::vector<std::string>::const_iterator iter (rows.begin()); iter!=rows.end(); ++iter)
     {
@@ -272,6 +284,8 @@ void CSMWorld::CommandDispatcher::executeExtendedDelete()
 
             int size = collection.getSize();
 
+            std::vector<std::string> ids;
+
             for (int i=size-1; i>=0; --i)
             {
                 const Record<CellRef>& record = collection.getRecord (i);
@@ -283,8 +297,11 @@ void CSMWorld::CommandDispatcher::executeExtendedDelete()
                     Misc::StringUtils::lowerCase (record.get().mCell)))
                     continue;
 
-                macro.push (new CSMWorld::DeleteCommand (model, record.get().mId));
+                ids.push_back (record.get().mId);
             }
+
+            if (!ids.empty())
+                macro.push (new CSMWorld::DeleteRecordsCommand (model, ids));
         }
     }
 }
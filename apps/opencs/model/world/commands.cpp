@@ -41,6 +41,33 @@ void CSMWorld::TouchCommand::undo()
     }
 }
 
+CSMWorld::TouchRecordsCommand::TouchRecordsCommand(IdTable& table, const std::vector<std::string>& ids,
+    QUndoCommand* parent)
+    : QUndoCommand(parent)
+    , mTable(table)
+    , mIds(ids)
+{
+    setText(("Touch " + std::to_string(mIds.size()) + " records").c_str());
+    for (const std::string& id : mIds)
+        mOld[Misc::StringUtils::lowerCase(id)].reset(mTable.getRecord(id).clone());
+}
+
+void CSMWorld::TouchRecordsCommand::redo()
+{
+    mChanged = mTable.touchRecords(mIds);
+}
+
+void CSMWorld::TouchRecordsCommand::undo()
+{
+    std::vector<std::pair<std::string, const RecordBase*> > records;
+    records.reserve(mChanged.size());
+    for (const std::string& id : mChanged)
+        records.emplace_back(id, mOld.at(Misc::StringUtils::lowerCase(id)).get());
+
+    mTable.setRecords(records);
+    mChanged.clear();
+}
+
 CSMWorld::ImportLandTexturesCommand::ImportLandTexturesCommand(IdTable& landTable,
     IdTable& ltexTable, QUndoCommand* parent)
     : QUndoCommand(parent)
@@ -361,6 +388,51 @@ void CSMWorld::DeleteCommand::undo()
 }
 
 
+CSMWorld::DeleteRecordsCommand::DeleteRecordsCommand (IdTable& model,
+        const std::vector<std::string>& ids, QUndoCommand* parent)
+: QUndoCommand (parent), mModel (model)
+{
+    setText (("Delete " + std::to_string (ids.size()) + " records").c_str());
+
+    mOld.reserve (ids.size());
+    for (const std::string& id : ids)
+        mOld.emplace_back (id, std::unique_ptr<RecordBase> (model.getRecord (id).clone()));
+}
+
+void CSMWorld::DeleteRecordsCommand::redo()
+{
+    std::vector<std::string> removed;
+    std::vector<std::unique_ptr<RecordBase> > deleted;
+    std::vector<std::pair<std::string, const RecordBase*> > changed;
+
+    for (const auto& [id, record] : mOld)
+    {
+        if (record->mState==RecordBase::State_ModifiedOnly)
+        {
+            removed.push_back (id);
+        }
+        else
+        {
+            deleted.emplace_back (record->clone());
+            deleted.back()->mState = RecordBase::State_Deleted;
+            changed.emplace_back (id, deleted.back().get());
+        }
+    }
+
+    mModel.setRecords (changed);
+    mModel.removeRecords (removed);
+}
+
+void CSMWorld::DeleteRecordsCommand::undo()
+{
+    std::vector<std::pair<std::string, const RecordBase*> > records;
+    records.reserve (mOld.size());
+    for (const auto& [id, record] : mOld)
+        records.emplace_back (id, record.get());
+
+    mModel.setRecords (records);
+}
+
 CSMWorld::ReorderRowsCommand::ReorderRowsCommand (IdTable& model, int baseIndex,
         const std::vector<int>& newOrder)
 : mModel (model), mBaseIndex (baseIndex), mNewOrder (newOrder)
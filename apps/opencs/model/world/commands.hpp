@@ -44,6 +44,24 @@ namespace CSMWorld
             bool mChanged;
     };
 
+    /// \brief Touches many records at once, so views are updated once instead of once per record
+    class TouchRecordsCommand : public QUndoCommand
+    {
+        public:
+
+            TouchRecordsCommand(IdTable& model, const std::vector<std::string>& ids, QUndoCommand* parent=nullptr);
+
+            void redo() override;
+            void undo() override;
+
+        private:
+
+            IdTable& mTable;
+            std::vector<std::string> mIds;
+            std::map<std::string, std::unique_ptr<RecordBase> > mOld;
+            std::vector<std::string> mChanged;
+    };
+
     /// \brief Adds LandTexture records and modifies texture indices as needed.
     ///
     /// LandTexture records are different from other types of records, because
@@ -243,6 +261,24 @@ namespace CSMWorld
             void undo() override;
     };
 
+    /// \brief Deletes many records at once, so views are updated once instead of once per record
+    ///
+    /// \note Not suitable for referenceables, which need a type to restore removed records.
+    class DeleteRecordsCommand : public QUndoCommand
+    {
+            IdTable& mModel;
+            std::vector<std::pair<std::string, std::unique_ptr<RecordBase> > > mOld;
+
+        public:
+
+            DeleteRecordsCommand (IdTable& model, const std::vector<std::string>& ids,
+                QUndoCommand *parent = nullptr);
+
+            void redo() override;
+
+            void undo() override;
+    };
+
     class ReorderRowsCommand : public QUndoCommand
     {
             IdTable& mModel;
@@ -213,6 +213,108 @@ bool CSMWorld::IdTable::touchRecord(const std::string& id)
     return changed;
 }
 
+std::vector<std::string> CSMWorld::IdTable::touchRecords(const std::vector<std::string>& ids)
+{
+    std::vector<int> rows = mIdCollection->touchRecords(ids);
+
+    std::vector<std::string> changed;
+    changed.reserve(rows.size());
+    for (int row : rows)
+        changed.push_back(mIdCollection->getId(row));
+
+    int column = mIdCollection->searchColumnIndex(Columns::ColumnId_RecordType);
+    if (!rows.empty() && column != -1)
+    {
+        const auto [first, last] = std::minmax_element(rows.begin(), rows.end());
+        emit dataChanged(index(*first, column), index(*last, column));
+    }
+
+    return changed;
+}
+
+void CSMWorld::IdTable::setRecords (const std::vector<std::pair<std::string, const RecordBase*> >& records,
+    CSMWorld::UniversalId::Type type)
+{
+    if (records.empty())
+        return;
+
+    std::vector<const std::pair<std::string, const RecordBase*>*> added;
+
+    int first = std::numeric_limits<int>::max();
+    int last = -1;
+
+    for (const auto& record : records)
+    {
+        int index = mIdCollection->searchId (record.first);
+
+        if (index==-1)
+        {
+            added.push_back (&record);
+            continue;
+        }
+
+        mIdCollection->replace (index, *record.second);
+        first = std::min (first, index);
+        last = std::max (last, index);
+    }
+
+    if (last!=-1)
+        emit dataChanged (CSMWorld::IdTable::index (first, 0),
+            CSMWorld::IdTable::index (last, mIdCollection->getColumns()-1));
+
+    // Records sharing an append index end up next to each other, insert each such group at once
+    for (std::size_t begin = 0; begin<added.size();)
+    {
+        int index = mIdCollection->getAppendIndex (added[begin]->first, type);
+
+        std::size_t end = begin + 1;
+
+        while (end<added.size() && mIdCollection->getAppendIndex (added[end]->first, type)==index)
+            ++end;
+
+        beginInsertRows (QModelIndex(), index, index + static_cast<int> (end - begin) - 1);
+
+        for (; begin<end; ++begin)
+            mIdCollection->appendRecord (*added[begin]->second, type);
+
+        endInsertRows();
+    }
+}
+
+void CSMWorld::IdTable::removeRecords (const std::vector<std::string>& ids)
+{
+    if (ids.empty())
+        return;
+
+    std::vector<int> rows;
+    rows.reserve (ids.size());
+
+    for (const std::string& id : ids)
+        rows.push_back (mIdCollection->getIndex (id));
+
+    std::sort (rows.begin(), rows.end());
+    rows.erase (std::unique (rows.begin(), rows.end()), rows.end());
+
+    // Remove contiguous ranges from the back, so rows of the remaining ranges keep their index
+    for (std::size_t end = rows.size(); end>0;)
+    {
+        std::size_t begin = end - 1;
+
+        while (begin>0 && rows[begin-1]==rows[begin]-1)
+            --begin;
+
+        const int count = static_cast<int> (end - begin);
+
+        beginRemoveRows (QModelIndex(), rows[begin], rows[begin] + count - 1);
+
+        mIdCollection->removeRows (rows[begin], count);
+
+        endRemoveRows();
+
+        end = begin;
+    }
+}
+
 std::string CSMWorld::IdTable::getId(int row) const
 {
     return mIdCollection->getId(row);
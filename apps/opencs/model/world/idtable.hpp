@@ -1,6 +1,8 @@
 #ifndef CSM_WOLRD_IDTABLE_H
 #define CSM_WOLRD_IDTABLE_H
 
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "idtablebase.hpp"
@@ -63,6 +65,18 @@ namespace CSMWorld
             bool touchRecord(const std::string& id);
             ///< Will change the record state to modified, if it is not already.
 
+            std::vector<std::string> touchRecords(const std::vector<std::string>& ids);
+            ///< Touch all records with \a ids and emit a single signal for all of them.
+            /// \return IDs of the changed records
+
+            void setRecords (const std::vector<std::pair<std::string, const RecordBase*> >& records,
+                    UniversalId::Type type = UniversalId::Type_None);
+            ///< Add records or overwrite existing records. Views are updated with a single signal for the
+            /// overwritten records and one for each range of added records.
+
+            void removeRecords (const std::vector<std::string>& ids);
+            ///< Remove records with \a ids and update views with one signal for each range of removed records.
+
             std::string getId(int row) const;
 
             QModelIndex getModelIndex (const std::string& id, int column) const override;
@@ -80,7 +80,7 @@ int CSMWorld::InfoCollection::getAppendIndex (const std::string& id, UniversalId
     std::pair<RecordConstIterator, RecordConstIterator> range = getTopicRange (id.substr (0, separator));
 
     if (range.first==range.second)
-        return Collection<Info, IdAccessor<Info> >::getAppendIndex (id, type);
+        return Collection<Info, IdAccessor<Info>, std::map<std::string, int> >::getAppendIndex (id, type);
 
     return std::distance (getRecords().begin(), range.second);
 }
@@ -217,9 +217,5 @@ void CSMWorld::InfoCollection::removeDialogueInfos(const std::string& dialogueId
         }
     }
 
-    while (!erasedRecords.empty())
-    {
-        removeRows(erasedRecords.back(), 1);
-        erasedRecords.pop_back();
-    }
+    removeRecords(erasedRecords);
 }
@@ -1,6 +1,9 @@
 #ifndef CSM_WOLRD_INFOCOLLECTION_H
 #define CSM_WOLRD_INFOCOLLECTION_H
 
+#include <map>
+#include <string>
+
 #include "collection.hpp"
 #include "info.hpp"
 
@@ -11,7 +14,8 @@ namespace ESM
 
 namespace CSMWorld
 {
-    class InfoCollection : public Collection<Info, IdAccessor<Info> >
+    // Topic ranges are looked up by their first ID, so the ID index must be ordered
+    class InfoCollection : public Collection<Info, IdAccessor<Info>, std::map<std::string, int> >
     {
         public:
 
@@ -36,75 +36,75 @@ namespace CSMWorld
     void NestedInfoCollection::addNestedRow(int row, int column, int position)
     {
         Record<Info> record;
-        record.assign(Collection<Info, IdAccessor<Info> >::getRecord(row));
+        record.assign(InfoCollection::getRecord(row));
 
-        getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).addRow(record, position);
+        getAdapter(InfoCollection::getColumn(column)).addRow(record, position);
 
-        Collection<Info, IdAccessor<Info> >::setRecord(row, record);
+        InfoCollection::setRecord(row, record);
     }
 
     void NestedInfoCollection::removeNestedRows(int row, int column, int subRow)
     {
         Record<Info> record;
-        record.assign(Collection<Info, IdAccessor<Info> >::getRecord(row));
+        record.assign(InfoCollection::getRecord(row));
 
-        getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).removeRow(record, subRow);
+        getAdapter(InfoCollection::getColumn(column)).removeRow(record, subRow);
 
-        Collection<Info, IdAccessor<Info> >::setRecord(row, record);
+        InfoCollection::setRecord(row, record);
     }
 
     QVariant NestedInfoCollection::getNestedData (int row,
             int column, int subRow, int subColumn) const
     {
-        return getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).getData(
-                Collection<Info, IdAccessor<Info> >::getRecord(row), subRow, subColumn);
+        return getAdapter(InfoCollection::getColumn(column)).getData(
+                InfoCollection::getRecord(row), subRow, subColumn);
     }
 
     void NestedInfoCollection::setNestedData(int row,
             int column, const QVariant& data, int subRow, int subColumn)
     {
         Record<Info> record;
-        record.assign(Collection<Info, IdAccessor<Info> >::getRecord(row));
+        record.assign(InfoCollection::getRecord(row));
 
-        getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).setData(
+        getAdapter(InfoCollection::getColumn(column)).setData(
                 record, data, subRow, subColumn);
 
-        Collection<Info, IdAccessor<Info> >::setRecord(row, record);
+        InfoCollection::setRecord(row, record);
     }
 
     CSMWorld::NestedTableWrapperBase* NestedInfoCollection::nestedTable(int row,
             int column) const
     {
-        return getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).table(
-                Collection<Info, IdAccessor<Info> >::getRecord(row));
+        return getAdapter(InfoCollection::getColumn(column)).table(
+                InfoCollection::getRecord(row));
     }
 
     void NestedInfoCollection::setNestedTable(int row,
             int column, const CSMWorld::NestedTableWrapperBase& nestedTable)
     {
         Record<Info> record;
-        record.assign(Collection<Info, IdAccessor<Info> >::getRecord(row));
+        record.assign(InfoCollection::getRecord(row));
 
-        getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).setTable(
+        getAdapter(InfoCollection::getColumn(column)).setTable(
                 record, nestedTable);
 
-        Collection<Info, IdAccessor<Info> >::setRecord(row, record);
+        InfoCollection::setRecord(row, record);
     }
 
     int NestedInfoCollection::getNestedRowsCount(int row, int column) const
     {
-        return getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).getRowsCount(
-                Collection<Info, IdAccessor<Info> >::getRecord(row));
+        return getAdapter(InfoCollection::getColumn(column)).getRowsCount(
+                InfoCollection::getRecord(row));
     }
 
     int NestedInfoCollection::getNestedColumnsCount(int row, int column) const
     {
-        return getAdapter(Collection<Info, IdAccessor<Info> >::getColumn(column)).getColumnsCount(
-                Collection<Info, IdAccessor<Info> >::getRecord(row));
+        return getAdapter(InfoCollection::getColumn(column)).getColumnsCount(
+                InfoCollection::getRecord(row));
     }
 
     CSMWorld::NestableColumn *NestedInfoCollection::getNestableColumn(int column)
     {
-        return Collection<Info, IdAccessor<Info> >::getNestableColumn(column);
+        return InfoCollection::getNestableColumn(column);
     }
 }
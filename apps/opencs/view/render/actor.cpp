@@ -107,7 +107,7 @@ namespace CSVRender
 
         // Attach to skeleton
         std::string boneName = ESM::getBoneName(type);
-        auto node = mNodeMap.find(boneName);
+        auto node = mNodeMap.find(Misc::InternedString::find(boneName));
         if (!mesh.empty() && node != mNodeMap.end())
         {
             auto instance = sceneMgr->getInstance(mesh);
@@ -261,18 +261,21 @@ void CSVWorld::GenericCreator::cloneMode(const std::string& originId,
 
 void CSVWorld::GenericCreator::touch(const std::vector<CSMWorld::UniversalId>& ids)
 {
-    // Combine multiple touch commands into one "macro" command
-    mUndoStack.beginMacro("Touch Records");
-
     CSMWorld::IdTable& table = dynamic_cast<CSMWorld::IdTable&>(*mData.getTableModel(mListId));
-    for (const CSMWorld::UniversalId& uid : ids)
+
+    if (ids.size() == 1)
     {
-        CSMWorld::TouchCommand* touchCmd = new CSMWorld::TouchCommand(table, uid.getId());
-        mUndoStack.push(touchCmd);
+        mUndoStack.push(new CSMWorld::TouchCommand(table, ids.front().getId()));
+        return;
     }
 
-    // Execute
-    mUndoStack.endMacro();
+    // Touch all records with one command, so views are updated once
+    std::vector<std::string> touchIds;
+    touchIds.reserve(ids.size());
+    for (const CSMWorld::UniversalId& uid : ids)
+        touchIds.push_back(uid.getId());
+
+    mUndoStack.push(new CSMWorld::TouchRecordsCommand(table, touchIds));
 }
 
 void CSVWorld::GenericCreator::toggleWidgets(bool active)
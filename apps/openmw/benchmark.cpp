@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+
+#include <osg/Math>
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace OMW
+{
+    std::vector<CameraPathPoint> readCameraPath(std::istream& stream)
+    {
+        std::vector<CameraPathPoint> result;
+        std::string line;
+        std::size_t lineNumber = 0;
+        while (std::getline(stream, line))
+        {
+            ++lineNumber;
+            const std::size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string::npos || line[start] == '#')
+                continue;
+
+            std::istringstream lineStream(line);
+            CameraPathPoint point;
+            float yaw = 0;
+            if (!(lineStream >> point.mFrame >> point.mPosition.x() >> point.mPosition.y() >> point.mPosition.z() >> yaw))
+                throw std::runtime_error("Invalid camera path point at line " + std::to_string(lineNumber));
+            if (!result.empty() && point.mFrame <= result.back().mFrame)
+                throw std::runtime_error("Camera path frame is not increasing at line " + std::to_string(lineNumber));
+            point.mYaw = osg::DegreesToRadians(yaw);
+            result.push_back(point);
+        }
+        return result;
+    }
+
+    CameraPathPoint getCameraPathPoint(const std::vector<CameraPathPoint>& path, unsigned frame)
+    {
+        const auto next = std::upper_bound(path.begin(), path.end(), frame,
+            [] (unsigned lhs, const CameraPathPoint& rhs) { return lhs < rhs.mFrame; });
+        if (next == path.begin())
+            return path.front();
+        if (next == path.end())
+            return path.back();
+        const CameraPathPoint& prev = *(next - 1);
+        const float factor = static_cast<float>(frame - prev.mFrame) / static_cast<float>(next->mFrame - prev.mFrame);
+        return CameraPathPoint {
+            frame,
+            prev.mPosition + (next->mPosition - prev.mPosition) * factor,
+            prev.mYaw + (next->mYaw - prev.mYaw) * factor,
+        };
+    }
+
+    void BenchmarkTimings::add(const std::string& phase, double seconds)
+    {
+        auto it = std::find_if(mPhases.begin(), mPhases.end(), [&] (const auto& v) { return v.first == phase; });
+        if (it == mPhases.end())
+            it = mPhases.emplace(mPhases.end(), phase, std::vector<double>());
+        it->second.push_back(seconds * 1000);
+    }
+
+    void BenchmarkTimings::write(std::ostream& stream) const
+    {
+        stream << "phase\tframes\ttotal\tmean\tmedian\tp95\tmax\n" << std::fixed << std::setprecision(3);
+        for (const auto& [phase, values] : mPhases)
+        {
+            std::vector<double> sorted = values;
+            std::sort(sorted.begin(), sorted.end());
+            const double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+            const auto percentile = [&] (std::size_t percent) { return sorted[(sorted.size() - 1) * percent / 100]; };
+            stream << phase << '\t' << sorted.size() << '\t' << total << '\t' << total / sorted.size()
+                   << '\t' << percentile(50) << '\t' << percentile(95) << '\t' << sorted.back() << '\n';
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef OPENMW_BENCHMARK_H
+#define OPENMW_BENCHMARK_H
+
+#include <osg/Vec3f>
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OMW
+{
+    /// Player position and rotation around Z axis in radians at a frame of a benchmark run.
+    struct CameraPathPoint
+    {
+        unsigned mFrame;
+        osg::Vec3f mPosition;
+        float mYaw;
+    };
+
+    /// Read a camera path from lines "<frame> <x> <y> <z> <yaw in degrees>". Empty lines and lines starting with #
+    /// are ignored. Frames must be increasing. Throws std::runtime_error on invalid input.
+    std::vector<CameraPathPoint> readCameraPath(std::istream& stream);
+
+    /// Interpolate the path linearly. Frames before the first point and after the last point use these points.
+    /// \param path Must be not empty.
+    CameraPathPoint getCameraPathPoint(const std::vector<CameraPathPoint>& path, unsigned frame);
+
+    /// Durations of named frame phases collected over a benchmark run.
+    class BenchmarkTimings
+    {
+        public:
+            void add(const std::string& phase, double seconds);
+
+            /// Write a tab separated table with a row per phase in order of the first addition. Columns are number
+            /// of frames with the phase, total, mean, median, 95th percentile and maximum duration in milliseconds.
+            void write(std::ostream& stream) const;
+
+        private:
+            std::vector<std::pair<std::string, std::vector<double>>> mPhases;
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <chrono>
 #include <thread>
 
@@ -15,6 +16,7 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/tracing.hpp>
 
 #include <components/misc/rng.hpp>
 
@@ -30,6 +32,7 @@
 
 #include <components/compiler/extensions0.hpp>
 
+#include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/workqueue.hpp>
 
 #include <components/files/configurationmanager.hpp>
@@ -63,6 +66,8 @@
 
 #include "mwstate/statemanagerimp.hpp"
 
+#include "benchmark.hpp"
+
 namespace
 {
     void checkSDLError(int ret)
@@ -164,7 +169,8 @@ namespace
     {
         public:
             ScopedProfile(osg::Timer_t frameStart, unsigned int frameNumber, const osg::Timer& timer, osg::Stats& stats)
-                : mScopeStart(timer.tick()),
+                : mTrace(UserStatsValue<sType>::sValue.mLabel.c_str(), "Frame"),
+                  mScopeStart(timer.tick()),
                   mFrameStart(frameStart),
                   mFrameNumber(frameNumber),
                   mTimer(timer),
@@ -186,6 +192,7 @@ namespace
             }
 
         private:
+            const Debug::ScopedTrace mTrace;
             const osg::Timer_t mScopeStart;
             const osg::Timer_t mFrameStart;
             const unsigned int mFrameNumber;
@@ -212,6 +219,16 @@ namespace
         if (Settings::Manager::getInt("async num threads", "Physics") == 0)
             profiler.removeUserStatsLine(" -Async");
     }
+
+    void collectBenchmarkTimings(unsigned int frameNumber, osg::Stats& stats, OMW::BenchmarkTimings& timings)
+    {
+        forEachUserStatsValue([&] (const UserStats& v)
+        {
+            double value = 0;
+            if (stats.getAttribute(frameNumber, v.mTaken, value))
+                timings.add(v.mTaken, value);
+        });
+    }
 }
 
 void OMW::Engine::executeLocalScripts()
@@ -284,6 +301,8 @@ bool OMW::Engine::frame(float frametime)
                 {
                     if (mEnvironment.getWorld()->getScriptsEnabled())
                     {
+                        mEnvironment.getScriptManager()->startFrame();
+
                         // local scripts
                         executeLocalScripts();
 
@@ -352,8 +371,7 @@ bool OMW::Engine::frame(float frametime)
 
             mResourceSystem->reportStats(frameNumber, stats);
 
-            stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
-            stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
+            mWorkQueue->reportStats(frameNumber, *stats);
 
             mEnvironment.reportStats(frameNumber, *stats);
         }
@@ -380,6 +398,8 @@ OMW::Engine::Engine(Files::ConfigurationManager& configurationManager)
   , mGrab(true)
   , mExportFonts(false)
   , mRandomSeed(0)
+  , mBenchmarkFrames(0)
+  , mBenchmarkFrameDuration(0)
   , mScriptContext (nullptr)
   , mFSStrict (false)
   , mScriptBlacklistUse (true)
@@ -410,6 +430,9 @@ OMW::Engine::~Engine()
 
     mViewer = nullptr;
 
+    // Drawing waits for skinning, so stop the queue after the viewer
+    SceneUtil::RigGeometry::setWorkQueue(nullptr);
+
     mResourceSystem.reset();
 
     delete mEncoder;
@@ -633,9 +656,6 @@ void OMW::Engine::setWindowIcon()
 
 void OMW::Engine::prepareEngine (Settings::Manager & settings)
 {
-    mEnvironment.setStateManager (
-        new MWState::StateManager (mCfgMgr.getUserDataPath() / "saves", mContentFiles.at (0)));
-
     createWindow(settings);
 
     osg::ref_ptr<osg::Group> rootNode (new osg::Group);
@@ -643,7 +663,8 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mVFS.reset(new VFS::Manager(mFSStrict));
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true,
+        Settings::Manager::getBool("memory map archives", "General"));
 
     mResourceSystem.reset(new Resource::ResourceSystem(mVFS.get()));
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(false); // keep to Off for now to allow better state sharing
@@ -657,7 +678,16 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     int numThreads = Settings::Manager::getInt("preload num threads", "Cells");
     if (numThreads <= 0)
         throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
-    mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    mWorkQueue = new SceneUtil::WorkQueue(numThreads, "Preload");
+
+    mEnvironment.setStateManager (
+        new MWState::StateManager (mCfgMgr.getUserDataPath() / "saves", mContentFiles.at (0), *mWorkQueue));
+
+    const int skinningThreads = Settings::Manager::getInt("skinning num threads", "Models");
+    if (skinningThreads < 0)
+        throw std::runtime_error("Invalid setting: 'skinning num threads' must be >=0");
+    if (skinningThreads > 0)
+        SceneUtil::RigGeometry::setWorkQueue(new SceneUtil::WorkQueue(skinningThreads, "Skinning"));
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
@@ -710,7 +740,7 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     mEnvironment.setInputManager (input);
 
     // Create sound system
-    mEnvironment.setSoundManager (new MWSound::SoundManager(mVFS.get(), mUseSound));
+    mEnvironment.setSoundManager (new MWSound::SoundManager(mVFS.get(), mWorkQueue.get(), mUseSound));
 
     if (!mSkipMenu)
     {
@@ -741,9 +771,12 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mEnvironment.setScriptManager (new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(), *mScriptContext, mWarningsMode,
         mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>()));
+    mEnvironment.getScriptManager()->setProfiling(Settings::Manager::getBool("script profiling", "Game"));
+    mEnvironment.getScriptManager()->setFrameBudget(
+        std::max(0.f, Settings::Manager::getFloat("script time budget", "Game")) / 1000.0);
 
     // Create game mechanics system
-    MWMechanics::MechanicsManager* mechanics = new MWMechanics::MechanicsManager;
+    MWMechanics::MechanicsManager* mechanics = new MWMechanics::MechanicsManager(mWorkQueue.get());
     mEnvironment.setMechanicsManager (mechanics);
 
     // Create dialog system
@@ -832,6 +865,20 @@ void OMW::Engine::go()
 
     Misc::Rng::init(mRandomSeed);
 
+    if (const auto path = std::getenv("OPENMW_TRACE_FILE"))
+    {
+        try
+        {
+            Debug::startTracing(path);
+            Debug::setTraceThreadName("Main");
+            Log(Debug::Info) << "Recording trace to " << path;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to start tracing: " << e.what();
+        }
+    }
+
     // Load settings
     Settings::Manager settings;
     std::string settingspath;
@@ -897,6 +944,18 @@ void OMW::Engine::go()
         mEnvironment.getWindowManager()->executeInConsole(mStartupScript);
     }
 
+    const bool benchmark = mBenchmarkFrames != 0;
+    unsigned int benchmarkFrame = 0;
+    OMW::BenchmarkTimings benchmarkTimings;
+    std::vector<OMW::CameraPathPoint> cameraPath;
+    if (!mBenchmarkCameraPath.empty())
+    {
+        boost::filesystem::ifstream stream(mBenchmarkCameraPath);
+        if (!stream)
+            throw std::runtime_error("Failed to open camera path file: " + mBenchmarkCameraPath);
+        cameraPath = OMW::readCameraPath(stream);
+    }
+
     std::ofstream stats;
     if (const auto path = std::getenv("OPENMW_OSG_STATS_FILE"))
     {
@@ -912,7 +971,15 @@ void OMW::Engine::go()
     {
         double dt = frameTimer.time_s();
         frameTimer.setStartTick();
-        dt = std::min(dt, 0.2);
+        dt = benchmark ? mBenchmarkFrameDuration : std::min(dt, 0.2);
+
+        if (!cameraPath.empty() && mEnvironment.getStateManager()->getState() == MWState::StateManager::State_Running)
+        {
+            const OMW::CameraPathPoint point = OMW::getCameraPathPoint(cameraPath, benchmarkFrame);
+            MWBase::World& world = *mEnvironment.getWorld();
+            world.moveObject(world.getPlayerPtr(), point.mPosition.x(), point.mPosition.y(), point.mPosition.z());
+            world.rotateObject(world.getPlayerPtr(), 0, 0, point.mYaw);
+        }
 
         mViewer->advance(simulationTime);
 
@@ -923,12 +990,23 @@ void OMW::Engine::go()
         }
         else
         {
-            mViewer->eventTraversal();
-            mViewer->updateTraversal();
+            {
+                const Debug::ScopedTrace trace("Event traversal", "Viewer");
+                mViewer->eventTraversal();
+            }
+            {
+                const Debug::ScopedTrace trace("Update traversal", "Viewer");
+                mViewer->updateTraversal();
+            }
 
             mEnvironment.getWorld()->updateWindowManager();
 
-            mViewer->renderingTraversals();
+            // Benchmark measures simulation only, culling and drawing depend on the GPU and its driver
+            if (!benchmark)
+            {
+                const Debug::ScopedTrace trace("Rendering traversals", "Viewer");
+                mViewer->renderingTraversals();
+            }
 
             bool guiActive = mEnvironment.getWindowManager()->isGuiMode();
             if (!guiActive)
@@ -948,7 +1026,41 @@ void OMW::Engine::go()
             }
         }
 
-        mEnvironment.limitFrameRate(frameTimer.time_s());
+        Debug::flushTrace();
+
+        if (benchmark)
+        {
+            const unsigned int frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+            collectBenchmarkTimings(frameNumber, *mViewer->getViewerStats(), benchmarkTimings);
+            benchmarkTimings.add("frame_time_taken", frameTimer.time_s());
+            if (++benchmarkFrame >= mBenchmarkFrames)
+                break;
+        }
+        else
+        {
+            const Debug::ScopedTrace trace("Frame rate limit", "Viewer");
+            mEnvironment.limitFrameRate(frameTimer.time_s());
+        }
+    }
+
+    Debug::stopTracing();
+
+    if (benchmark)
+    {
+        Log(Debug::Info) << "Benchmark finished after " << benchmarkFrame << " frames";
+        if (mBenchmarkOutput.empty())
+        {
+            std::ostringstream stream;
+            benchmarkTimings.write(stream);
+            Log(Debug::Info) << "Benchmark timings:\n" << stream.str();
+        }
+        else
+        {
+            boost::filesystem::ofstream stream(mBenchmarkOutput);
+            benchmarkTimings.write(stream);
+            if (!stream)
+                Log(Debug::Error) << "Failed to write benchmark timings to " << mBenchmarkOutput;
+        }
     }
 
     // Save user settings
@@ -957,6 +1069,15 @@ void OMW::Engine::go()
     Log(Debug::Info) << "Quitting peacefully.";
 }
 
+void OMW::Engine::setBenchmark(unsigned int frames, float frameDuration, const std::string& output,
+                               const std::string& cameraPath)
+{
+    mBenchmarkFrames = frames;
+    mBenchmarkFrameDuration = frameDuration;
+    mBenchmarkOutput = output;
+    mBenchmarkCameraPath = cameraPath;
+}
+
 void OMW::Engine::setCompileAll (bool all)
 {
     mCompileAll = all;
@@ -101,6 +101,11 @@ namespace OMW
             bool mExportFonts;
             unsigned int mRandomSeed;
 
+            unsigned int mBenchmarkFrames;
+            float mBenchmarkFrameDuration;
+            std::string mBenchmarkOutput;
+            std::string mBenchmarkCameraPath;
+
             Compiler::Extensions mExtensions;
             Compiler::Context *mScriptContext;
 
@@ -201,6 +206,12 @@ namespace OMW
 
             void setRandomSeed(unsigned int seed);
 
+            /// Run the given number of frames with a fixed duration and without rendering, then write timings of
+            /// frame phases into the output file (log if empty) and quit. Zero frames disables the benchmark.
+            /// \param cameraPath Optional file with a player path, see OMW::readCameraPath.
+            void setBenchmark(unsigned int frames, float frameDuration, const std::string& output,
+                              const std::string& cameraPath);
+
         private:
             Files::ConfigurationManager& mCfgMgr;
     };
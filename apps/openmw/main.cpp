@@ -122,6 +122,19 @@ bool parseOptions (int argc, char** argv, OMW::Engine& engine, Files::Configurat
         ("random-seed", bpo::value <unsigned int> ()
             ->default_value(Misc::Rng::generateDefaultSeed()),
             "seed value for random number generator")
+
+        ("benchmark-frames", bpo::value<unsigned int>()->default_value(0),
+            "run the given number of frames with a fixed duration and without rendering, "
+            "then write frame phase timings and quit (use with load-savegame and random-seed for repeatable results)")
+
+        ("benchmark-frame-duration", bpo::value<float>()->default_value(1.f / 60, "1/60"),
+            "simulated duration of a benchmark frame in seconds")
+
+        ("benchmark-output", bpo::value<Files::EscapePath>()->default_value(Files::EscapePath(), ""),
+            "file to write benchmark timings to (log if not set)")
+
+        ("benchmark-camera-path", bpo::value<Files::EscapePath>()->default_value(Files::EscapePath(), ""),
+            "file with player path for the benchmark, each line is \"<frame> <x> <y> <z> <yaw in degrees>\"")
     ;
 
     bpo::parsed_options valid_opts = bpo::command_line_parser(argc, argv)
@@ -219,6 +232,10 @@ bool parseOptions (int argc, char** argv, OMW::Engine& engine, Files::Configurat
     engine.setActivationDistanceOverride (variables["activate-dist"].as<int>());
     engine.enableFontExport(variables["export-fonts"].as<bool>());
     engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
+    engine.setBenchmark(variables["benchmark-frames"].as<unsigned int>(),
+                        variables["benchmark-frame-duration"].as<float>(),
+                        variables["benchmark-output"].as<Files::EscapePath>().mPath.string(),
+                        variables["benchmark-camera-path"].as<Files::EscapePath>().mPath.string());
 
     return true;
 }
@@ -1,7 +1,14 @@
 #ifndef GAME_MWBASE_SCRIPTMANAGER_H
 #define GAME_MWBASE_SCRIPTMANAGER_H
 
+#include <cstdint>
 #include <string>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
 
 namespace Interpreter
 {
@@ -31,6 +38,15 @@ namespace MWBase
 
         public:
 
+            /// Accumulated cost of running a script since profiling was enabled
+            struct ScriptProfile
+            {
+                std::string mName;
+                std::uint64_t mCalls = 0;
+                std::uint64_t mInstructions = 0;
+                double mTime = 0; // seconds
+            };
+
             ScriptManager() {}
 
             virtual ~ScriptManager() {}
@@ -52,6 +68,26 @@ namespace MWBase
             ///< Return locals for script \a name.
 
             virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
+
+            virtual void startFrame() = 0;
+            ///< Start counting script time and per frame statistics for a new frame
+
+            virtual void setFrameBudget (double seconds) = 0;
+            ///< Set time that may be spent on scripts per frame before global scripts are deferred.
+            /// 0 disables the limit.
+
+            virtual bool isFrameBudgetExceeded() const = 0;
+
+            virtual void setProfiling (bool enabled) = 0;
+            ///< Enabling profiling resets previously collected profile
+
+            virtual bool getProfiling() const = 0;
+
+            virtual std::vector<ScriptProfile> getProfile (std::size_t& frames) const = 0;
+            ///< Return per script profile sorted by total time descending
+            /// \param frames Set to number of frames profiled
+
+            virtual void reportStats (unsigned int frameNumber, osg::Stats& stats) const = 0;
    };
 }
 
@@ -167,6 +167,9 @@ namespace MWBase
             ///< Is the given sound currently playing on the given object?
             ///  If you want to check if sound played with playSound is playing, use empty Ptr
 
+            virtual void preloadSound(const std::string& soundId) = 0;
+            ///< Start decoding the given sound in background to have it ready when it's played.
+
             virtual void pauseSounds(MWSound::BlockerType blocker, int types=int(Type::Mask)) = 0;
             ///< Pauses all currently playing sounds, including music.
 
@@ -64,6 +64,7 @@ namespace MWDialogue
     void DialogueManager::clear()
     {
         mKnownTopics.clear();
+        mInfoIndices.clear();
         mTalkedTo = false;
         mTemporaryDispositionChange = 0;
         mPermanentDispositionChange = 0;
@@ -127,7 +128,7 @@ namespace MWDialogue
         const MWWorld::Store<ESM::Dialogue> &dialogs =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-        Filter filter (actor, mChoice, mTalkedTo);
+        Filter filter (actor, mChoice, mTalkedTo, mInfoIndices);
 
         for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
         {
@@ -255,7 +256,7 @@ namespace MWDialogue
 
     void DialogueManager::executeTopic (const std::string& topic, ResponseCallback* callback)
     {
-        Filter filter (mActor, mChoice, mTalkedTo);
+        Filter filter (mActor, mChoice, mTalkedTo, mInfoIndices);
 
         const MWWorld::Store<ESM::Dialogue> &dialogues =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
@@ -328,7 +329,7 @@ namespace MWDialogue
 
         const auto& dialogs = MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-        Filter filter (mActor, -1, mTalkedTo);
+        Filter filter (mActor, -1, mTalkedTo, mInfoIndices);
 
         for (const auto& dialog : dialogs)
         {
@@ -420,7 +421,7 @@ namespace MWDialogue
         const ESM::Dialogue* dialogue = searchDialogue(mLastTopic);
         if (dialogue)
         {
-            Filter filter (mActor, mChoice, mTalkedTo);
+            Filter filter (mActor, mChoice, mTalkedTo, mInfoIndices);
 
             if (dialogue->mType == ESM::Dialogue::Topic || dialogue->mType == ESM::Dialogue::Greeting)
             {
@@ -553,7 +554,7 @@ namespace MWDialogue
 
     bool DialogueManager::checkServiceRefused(ResponseCallback* callback, ServiceType service)
     {
-        Filter filter (mActor, service, mTalkedTo);
+        Filter filter (mActor, service, mTalkedTo, mInfoIndices);
 
         const MWWorld::Store<ESM::Dialogue> &dialogues =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
@@ -605,7 +606,7 @@ namespace MWDialogue
         const ESM::Dialogue *dial = store.get<ESM::Dialogue>().find(topic);
 
         const MWMechanics::CreatureStats& creatureStats = actor.getClass().getCreatureStats(actor);
-        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer());
+        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer(), mInfoIndices);
         const ESM::DialInfo *info = filter.search(*dial, false);
         if(info != nullptr)
         {
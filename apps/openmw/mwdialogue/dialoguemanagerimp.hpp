@@ -15,6 +15,8 @@
 
 #include "../mwscript/compilercontext.hpp"
 
+#include "infoindex.hpp"
+
 namespace ESM
 {
     struct Dialogue;
@@ -50,6 +52,8 @@ namespace MWDialogue
             float mTemporaryDispositionChange;
             float mPermanentDispositionChange;
 
+            InfoIndices mInfoIndices;
+
             void parseText (const std::string& text);
 
             void updateActorKnownTopics();
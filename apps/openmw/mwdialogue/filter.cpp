@@ -20,6 +20,23 @@
 #include "../mwmechanics/actorutil.hpp"
 
 #include "selectwrapper.hpp"
+#include "infoindex.hpp"
+
+MWDialogue::InfoIndexActor MWDialogue::Filter::getIndexActor() const
+{
+    InfoIndexActor actor;
+    actor.mId = mActor.getCellRef().getRefId();
+    actor.mIsNpc = (mActor.getTypeName() == typeid (ESM::NPC).name());
+    if (actor.mIsNpc)
+    {
+        const ESM::NPC& npc = *mActor.get<ESM::NPC>()->mBase;
+        actor.mRace = npc.mRace;
+        actor.mClass = npc.mClass;
+        actor.mFaction = mActor.getClass().getPrimaryFaction (mActor);
+        actor.mIsFemale = (npc.mFlags & ESM::NPC::Female) != 0;
+    }
+    return actor;
+}
 
 bool MWDialogue::Filter::testActor (const ESM::DialInfo& info) const
 {
@@ -612,8 +629,8 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements (const MWWorld::Pt
     return stats.getFactionReputation (factionId)>=faction.mData.mRankData[rank].mFactReaction;
 }
 
-MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
-: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer)
+MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, InfoIndices& infoIndices)
+: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer), mInfoIndices (infoIndices)
 {}
 
 const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue, const bool fallbackToInfoRefusal) const
@@ -629,10 +646,10 @@ const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue,
 std::vector<const ESM::DialInfo *> MWDialogue::Filter::listAll (const ESM::Dialogue& dialogue) const
 {
     std::vector<const ESM::DialInfo *> infos;
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
+    for (const ESM::DialInfo* info : mInfoIndices.get (dialogue).getCandidates (getIndexActor(), nullptr))
     {
-        if (testActor (*iter))
-            infos.push_back(&*iter);
+        if (testActor (*info))
+            infos.push_back(info);
     }
     return infos;
 }
@@ -644,14 +661,18 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
     bool infoRefusal = false;
 
-    // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    const InfoIndexActor actor = getIndexActor();
+    const MWWorld::Ptr player = MWMechanics::getPlayer();
+    const std::string playerCell = MWBase::Environment::get().getWorld()->getCellName (player.getCell());
+
+    // Iterate over topic responses to find a matching one. The index only skips responses failing actor and cell
+    // conditions, so the remaining ones are checked completely.
+    for (const ESM::DialInfo* info : mInfoIndices.get (dialogue).getCandidates (actor, &playerCell))
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (*info) && testPlayer (*info) && testSelectStructs (*info))
         {
-            if (testDisposition (*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+            if (testDisposition (*info, invertDisposition)) {
+                infos.push_back(info);
                 if (!searchAll)
                     break;
             }
@@ -670,10 +691,9 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find ("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-            iter!=infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter) && testDisposition(*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+        for (const ESM::DialInfo* info : mInfoIndices.get (infoRefusalDialogue).getCandidates (actor, &playerCell))
+            if (testActor (*info) && testPlayer (*info) && testSelectStructs (*info) && testDisposition(*info, invertDisposition)) {
+                infos.push_back(info);
                 if (!searchAll)
                     break;
             }
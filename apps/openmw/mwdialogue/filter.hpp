@@ -14,12 +14,17 @@ namespace ESM
 namespace MWDialogue
 {
     class SelectWrapper;
+    struct InfoIndexActor;
+    class InfoIndices;
 
     class Filter
     {
             MWWorld::Ptr mActor;
             int mChoice;
             bool mTalkedToPlayer;
+            InfoIndices& mInfoIndices;
+
+            InfoIndexActor getIndexActor() const;
 
             bool testActor (const ESM::DialInfo& info) const;
             ///< Is this the right actor for this \a info?
@@ -53,7 +58,7 @@ namespace MWDialogue
 
         public:
 
-            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
+            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, InfoIndices& infoIndices);
 
             std::vector<const ESM::DialInfo *> list (const ESM::Dialogue& dialogue,
                 bool fallbackToInfoRefusal, bool searchAll, bool invertDisposition=false) const;
@@ -0,0 +1,93 @@
+#include "infoindex.hpp"
+
+#include <components/esm/loaddial.hpp>
+#include <components/misc/stringops.hpp>
+
+#include <algorithm>
+
+namespace MWDialogue
+{
+    InfoIndex::InfoIndex(const ESM::Dialogue& dialogue)
+    {
+        std::size_t position = 0;
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+        {
+            const Entry entry {position++, &info};
+            if (!info.mActor.empty())
+                mByActor[Misc::StringUtils::lowerCase(info.mActor)].push_back(entry);
+            else if (!info.mRace.empty())
+                mByRace[Misc::StringUtils::lowerCase(info.mRace)].push_back(entry);
+            else if (!info.mClass.empty())
+                mByClass[Misc::StringUtils::lowerCase(info.mClass)].push_back(entry);
+            else if (info.mFactionLess)
+                mByFaction[std::string()].push_back(entry);
+            else if (!info.mFaction.empty())
+                mByFaction[Misc::StringUtils::lowerCase(info.mFaction)].push_back(entry);
+            else if (!info.mCell.empty())
+            {
+                const std::string cell = Misc::StringUtils::lowerCase(info.mCell);
+                auto it = std::find_if(mByCell.begin(), mByCell.end(), [&] (const auto& v) { return v.first == cell; });
+                if (it == mByCell.end())
+                    it = mByCell.emplace(mByCell.end(), cell, Entries());
+                it->second.push_back(entry);
+            }
+            else
+                mOther.push_back(entry);
+        }
+    }
+
+    std::vector<const ESM::DialInfo*> InfoIndex::getCandidates(const InfoIndexActor& actor,
+                                                               const std::string* playerCell) const
+    {
+        std::vector<const Entries*> groups;
+
+        const auto addGroup = [&] (const std::unordered_map<std::string, Entries>& map, const std::string& key)
+        {
+            const auto it = map.find(key);
+            if (it != map.end())
+                groups.push_back(&it->second);
+        };
+
+        addGroup(mByActor, Misc::StringUtils::lowerCase(actor.mId));
+
+        // Creatures only use infos for their id
+        if (actor.mIsNpc)
+        {
+            addGroup(mByRace, Misc::StringUtils::lowerCase(actor.mRace));
+            addGroup(mByClass, Misc::StringUtils::lowerCase(actor.mClass));
+            addGroup(mByFaction, Misc::StringUtils::lowerCase(actor.mFaction));
+
+            const std::string cell = playerCell == nullptr ? std::string() : Misc::StringUtils::lowerCase(*playerCell);
+            for (const auto& [key, entries] : mByCell)
+                if (playerCell == nullptr || cell.compare(0, key.size(), key) == 0)
+                    groups.push_back(&entries);
+
+            groups.push_back(&mOther);
+        }
+
+        std::vector<Entry> entries;
+        for (const Entries* group : groups)
+            entries.insert(entries.end(), group->begin(), group->end());
+
+        if (groups.size() > 1)
+            std::sort(entries.begin(), entries.end(), [] (const Entry& l, const Entry& r) { return l.mPosition < r.mPosition; });
+
+        // Infos for the other gender never pass for NPCs
+        const signed char otherGender = actor.mIsFemale ? ESM::DialInfo::Male : ESM::DialInfo::Female;
+
+        std::vector<const ESM::DialInfo*> result;
+        result.reserve(entries.size());
+        for (const Entry& entry : entries)
+            if (!actor.mIsNpc || entry.mInfo->mData.mGender != otherGender)
+                result.push_back(entry.mInfo);
+        return result;
+    }
+
+    const InfoIndex& InfoIndices::get(const ESM::Dialogue& dialogue)
+    {
+        auto it = mIndices.find(&dialogue);
+        if (it == mIndices.end())
+            it = mIndices.emplace(&dialogue, InfoIndex(dialogue)).first;
+        return it->second;
+    }
+}
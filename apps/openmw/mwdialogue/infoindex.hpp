@@ -0,0 +1,71 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// Static properties of the speaker used to narrow down dialogue infos
+    struct InfoIndexActor
+    {
+        std::string mId;
+        bool mIsNpc = false;
+        std::string mRace;
+        std::string mClass;
+        std::string mFaction;
+        bool mIsFemale = false;
+    };
+
+    /// Groups infos of a topic by the most specific of their actor id, race, class, faction and cell conditions.
+    /// Candidates are a superset of the infos passing these conditions in the order of the topic.
+    class InfoIndex
+    {
+        public:
+            explicit InfoIndex(const ESM::Dialogue& dialogue);
+
+            /// \param playerCell if nullptr, infos with any cell condition are included.
+            std::vector<const ESM::DialInfo*> getCandidates(const InfoIndexActor& actor,
+                                                            const std::string* playerCell) const;
+
+        private:
+            struct Entry
+            {
+                std::size_t mPosition;
+                const ESM::DialInfo* mInfo;
+            };
+
+            using Entries = std::vector<Entry>;
+
+            std::unordered_map<std::string, Entries> mByActor;
+            std::unordered_map<std::string, Entries> mByRace;
+            std::unordered_map<std::string, Entries> mByClass;
+            // Factionless infos use the empty key
+            std::unordered_map<std::string, Entries> mByFaction;
+            std::vector<std::pair<std::string, Entries>> mByCell;
+            Entries mOther;
+    };
+
+    /// Indices of topics built on first use. Refers to the dialogue records, so it must be cleared when they are
+    /// reloaded.
+    class InfoIndices
+    {
+        public:
+            const InfoIndex& get(const ESM::Dialogue& dialogue);
+
+            void clear() { mIndices.clear(); }
+
+        private:
+            std::unordered_map<const ESM::Dialogue*, InfoIndex> mIndices;
+    };
+}
+
+#endif
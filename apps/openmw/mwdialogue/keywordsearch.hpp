@@ -1,11 +1,12 @@
 #ifndef GAME_MWDIALOGUE_KEYWORDSEARCH_H
 #define GAME_MWDIALOGUE_KEYWORDSEARCH_H
 
-#include <map>
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <stdexcept>
+#include <utility>
 #include <vector>
-#include <algorithm>    // std::reverse
 
 #include <components/misc/stringops.hpp>
 
@@ -30,42 +31,67 @@ public:
     {
         if (keyword.empty())
             return;
-        seed_impl  (/*std::move*/ (keyword), /*std::move*/ (value), 0, mRoot);
+
+        std::uint32_t node = 0;
+        for (const auto ch : keyword)
+        {
+            const auto lower = Misc::StringUtils::toLower (ch);
+            auto& children = mTrie[node].mChildren;
+            const auto child = std::find_if (children.begin(), children.end(),
+                [&] (const auto& v) { return v.first == lower; });
+            if (child != children.end())
+            {
+                node = child->second;
+                continue;
+            }
+            const auto next = static_cast<std::uint32_t> (mTrie.size());
+            children.emplace_back (lower, next);
+            mTrie.emplace_back ();
+            node = next;
+        }
+
+        std::int32_t& index = mTrie[node].mKeyword;
+        if (index >= 0)
+        {
+            if (mKeywords[index].first == keyword)
+                throw std::runtime_error ("duplicate keyword inserted");
+            mKeywords[index] = std::make_pair (std::move (keyword), std::move (value));
+        }
+        else
+        {
+            index = static_cast<std::int32_t> (mKeywords.size());
+            mKeywords.emplace_back (std::move (keyword), std::move (value));
+        }
+
+        mNodes.clear ();
     }
 
     void clear ()
     {
-        mRoot.mChildren.clear ();
-        mRoot.mKeyword.clear ();
+        mTrie.assign (1, TrieNode ());
+        mKeywords.clear ();
+        mNodes.clear ();
+        mEdges.clear ();
     }
 
-    bool containsKeyword (string_t keyword, value_t& value)
+    bool containsKeyword (const string_t& keyword, value_t& value)
     {
-        typename Entry::childen_t::iterator current;
-        typename Entry::childen_t::iterator next;
+        build ();
 
-        current = mRoot.mChildren.find (Misc::StringUtils::toLower (*keyword.begin()));
-        if (current == mRoot.mChildren.end())
-            return false;
-        else if (current->second.mKeyword.size() && Misc::StringUtils::ciEqual(current->second.mKeyword, keyword))
+        std::uint32_t node = 0;
+        for (const auto ch : keyword)
         {
-            value = current->second.mValue;
-            return true;
-        }
-
-        for (Point i = ++keyword.begin(); i != keyword.end(); ++i)
-        {
-            next = current->second.mChildren.find(Misc::StringUtils::toLower (*i));
-            if (next == current->second.mChildren.end())
+            node = findChild (node, Misc::StringUtils::toLower (ch));
+            if (node == 0)
                 return false;
-            if (Misc::StringUtils::ciEqual(next->second.mKeyword, keyword))
-            {
-                value = next->second.mValue;
-                return true;
-            }
-            current = next;
         }
-        return false;
+
+        const std::int32_t index = mNodes[node].mKeyword;
+        if (index < 0)
+            return false;
+
+        value = mKeywords[index].second;
+        return true;
     }
 
     static bool sortMatches(const Match& left, const Match& right)
@@ -75,86 +101,50 @@ public:
 
     void highlightKeywords (Point beg, Point end, std::vector<Match>& out)
     {
-        std::vector<Match> matches;
+        build ();
+
+        // Keywords are found by their last character, so the automaton can report several keywords starting at the
+        // same position. Only the longest one of them starting at the beginning of a word is used.
+        std::vector<std::int32_t> longest (end - beg, -1);
+
+        std::uint32_t node = 0;
         for (Point i = beg; i != end; ++i)
         {
-            // check if previous character marked start of new word
-            if (i != beg)
+            const auto ch = Misc::StringUtils::toLower (*i);
+            std::uint32_t next = findChild (node, ch);
+            while (next == 0 && node != 0)
             {
-                Point prev = i;
-                --prev;
-                if(isalpha(*prev))
-                    continue;
+                node = mNodes[node].mFail;
+                next = findChild (node, ch);
             }
+            node = next;
 
-
-            // check first character
-            typename Entry::childen_t::iterator candidate = mRoot.mChildren.find (Misc::StringUtils::toLower (*i));
-
-            // no match, on to next character
-            if (candidate == mRoot.mChildren.end ())
-                continue;
-
-            // see how far the match goes
-            Point j = i;
-
-            // some keywords might be longer variations of other keywords, so we definitely need a list of candidates
-            // the first element in the pair is length of the match, i.e. depth from the first character on
-            std::vector< typename std::pair<int, typename Entry::childen_t::iterator> > candidates;
-
-            while ((j + 1) != end)
+            for (std::uint32_t found = mNodes[node].mKeyword >= 0 ? node : mNodes[node].mOutput; found != 0;
+                 found = mNodes[found].mOutput)
             {
-                typename Entry::childen_t::iterator next = candidate->second.mChildren.find (Misc::StringUtils::toLower (*++j));
+                const std::int32_t index = mNodes[found].mKeyword;
+                const std::size_t begin = (i - beg) + 1 - mKeywords[index].first.size ();
 
-                if (next == candidate->second.mChildren.end ())
-                {
-                    if (candidate->second.mKeyword.size() > 0)
-                        candidates.push_back(std::make_pair((j-i), candidate));
-                    break;
-                }
-
-                candidate = next;
+                // check if previous character marked start of new word
+                if (begin != 0 && isalpha (*(beg + begin - 1)))
+                    continue;
 
-                if (candidate->second.mKeyword.size() > 0)
-                    candidates.push_back(std::make_pair((j-i), candidate));
+                if (longest[begin] < 0 || mKeywords[longest[begin]].first.size () < mKeywords[index].first.size ())
+                    longest[begin] = index;
             }
+        }
 
-            if (candidates.empty())
-                continue; // didn't match enough to disambiguate, on to next character
-
-            // shorter candidates will be added to the vector first. however, we want to check against longer candidates first
-            std::reverse(candidates.begin(), candidates.end());
-
-            for (typename std::vector< std::pair<int, typename Entry::childen_t::iterator> >::iterator it = candidates.begin();
-                 it != candidates.end(); ++it)
-            {
-                candidate = it->second;
-                // try to match the rest of the keyword
-                Point k = i + it->first;
-                typename string_t::const_iterator t = candidate->second.mKeyword.begin () + (k - i);
-
-
-                while (k != end && t != candidate->second.mKeyword.end ())
-                {
-                    if (Misc::StringUtils::toLower (*k) != Misc::StringUtils::toLower (*t))
-                        break;
-
-                    ++k, ++t;
-                }
-
-                // didn't match full keyword, try the next candidate
-                if (t != candidate->second.mKeyword.end ())
-                    continue;
+        std::vector<Match> matches;
+        for (std::size_t i = 0; i < longest.size (); ++i)
+        {
+            if (longest[i] < 0)
+                continue;
 
-                // found a keyword, but there might still be longer keywords that start somewhere _within_ this keyword
-                // we will resolve these overlapping keywords later, choosing the longest one in case of conflict
-                Match match;
-                match.mValue = candidate->second.mValue;
-                match.mBeg = i;
-                match.mEnd = k;
-                matches.push_back(match);
-                break;
-            }
+            Match match;
+            match.mValue = mKeywords[longest[i]].second;
+            match.mBeg = beg + i;
+            match.mEnd = match.mBeg + mKeywords[longest[i]].first.size ();
+            matches.push_back(match);
         }
 
         // resolve overlapping keywords
@@ -201,54 +191,107 @@ public:
 
 private:
 
-    struct Entry
+    typedef typename string_t::value_type char_t;
+
+    // Keyword tree, filled by seed
+    struct TrieNode
     {
-        typedef std::map <wchar_t, Entry> childen_t;
+        std::vector<std::pair<char_t, std::uint32_t>> mChildren;
+        std::int32_t mKeyword = -1;
+    };
 
-        string_t mKeyword;
-        value_t mValue;
-        childen_t mChildren;
+    // Aho-Corasick automaton nodes in breadth-first order, root is the first one. Edges of each node are stored
+    // contiguously and sorted by character.
+    struct Node
+    {
+        std::uint32_t mEdgesBegin = 0;
+        std::uint32_t mEdgesEnd = 0;
+        // Node of the longest proper suffix of this node that is present in the tree
+        std::uint32_t mFail = 0;
+        // Closest node by failure links ending a keyword, root if there is none
+        std::uint32_t mOutput = 0;
+        std::int32_t mKeyword = -1;
     };
 
-    void seed_impl (string_t keyword, value_t value, size_t depth, Entry  & entry)
+    struct Edge
     {
-        int ch = Misc::StringUtils::toLower (keyword.at (depth));
+        char_t mChar;
+        std::uint32_t mTarget;
+    };
 
-        typename Entry::childen_t::iterator j = entry.mChildren.find (ch);
+    std::uint32_t findChild (std::uint32_t node, char_t ch) const
+    {
+        const auto begin = mEdges.begin () + mNodes[node].mEdgesBegin;
+        const auto end = mEdges.begin () + mNodes[node].mEdgesEnd;
+        const auto it = std::lower_bound (begin, end, ch, [] (const Edge& edge, char_t v) { return edge.mChar < v; });
+        if (it == end || it->mChar != ch)
+            return 0;
+        return it->mTarget;
+    }
 
-        if (j == entry.mChildren.end ())
-        {
-            entry.mChildren [ch].mValue = /*std::move*/ (value);
-            entry.mChildren [ch].mKeyword = /*std::move*/ (keyword);
-        }
-        else
+    void build ()
+    {
+        if (!mNodes.empty ())
+            return;
+
+        // Number trie nodes in breadth-first order
+        std::vector<std::uint32_t> order;
+        std::vector<std::uint32_t> numbers (mTrie.size ());
+        order.reserve (mTrie.size ());
+        order.push_back (0);
+        for (std::size_t i = 0; i < order.size (); ++i)
         {
-            if (j->second.mKeyword.size () > 0)
+            auto& children = mTrie[order[i]].mChildren;
+            std::sort (children.begin (), children.end ());
+            for (const auto& child : children)
             {
-                if (keyword == j->second.mKeyword)
-                    throw std::runtime_error ("duplicate keyword inserted");
-
-                value_t pushValue = /*std::move*/ (j->second.mValue);
-                string_t pushKeyword = /*std::move*/ (j->second.mKeyword);
+                numbers[child.second] = static_cast<std::uint32_t> (order.size ());
+                order.push_back (child.second);
+            }
+        }
 
-                if (depth >= pushKeyword.size ())
-                    throw std::runtime_error ("unexpected");
+        mNodes.resize (order.size ());
+        mEdges.clear ();
+        mEdges.reserve (order.size () - 1);
+        for (std::size_t i = 0; i < order.size (); ++i)
+        {
+            const TrieNode& trieNode = mTrie[order[i]];
+            Node& node = mNodes[i];
+            node.mKeyword = trieNode.mKeyword;
+            node.mEdgesBegin = static_cast<std::uint32_t> (mEdges.size ());
+            for (const auto& child : trieNode.mChildren)
+                mEdges.push_back (Edge {child.first, numbers[child.second]});
+            node.mEdgesEnd = static_cast<std::uint32_t> (mEdges.size ());
+        }
 
-                if (depth+1 < pushKeyword.size())
+        // Parents are processed before children in breadth-first order
+        for (std::uint32_t i = 0; i < mNodes.size (); ++i)
+        {
+            for (std::uint32_t e = mNodes[i].mEdgesBegin; e < mNodes[i].mEdgesEnd; ++e)
+            {
+                const Edge& edge = mEdges[e];
+                Node& child = mNodes[edge.mTarget];
+                if (i != 0)
                 {
-                    seed_impl (/*std::move*/ (pushKeyword), /*std::move*/ (pushValue), depth+1, j->second);
-                    j->second.mKeyword.clear ();
+                    std::uint32_t fail = mNodes[i].mFail;
+                    std::uint32_t next = findChild (fail, edge.mChar);
+                    while (next == 0 && fail != 0)
+                    {
+                        fail = mNodes[fail].mFail;
+                        next = findChild (fail, edge.mChar);
+                    }
+                    child.mFail = next;
                 }
+                const Node& fail = mNodes[child.mFail];
+                child.mOutput = fail.mKeyword >= 0 ? child.mFail : fail.mOutput;
             }
-            if (depth+1 == keyword.size())
-                j->second.mKeyword = value;
-            else // depth+1 < keyword.size()
-                seed_impl (/*std::move*/ (keyword), /*std::move*/ (value), depth+1, j->second);
         }
-
     }
 
-    Entry mRoot;
+    std::vector<TrieNode> mTrie = std::vector<TrieNode> (1);
+    std::vector<std::pair<string_t, value_t>> mKeywords;
+    std::vector<Node> mNodes;
+    std::vector<Edge> mEdges;
 };
 
 }
@@ -18,13 +18,15 @@
 #include <components/compiler/scriptparser.hpp>
 
 #include "filter.hpp"
+#include "infoindex.hpp"
 
 namespace
 {
 
-void test(const MWWorld::Ptr& actor, int &compiled, int &total, const Compiler::Extensions* extensions, int warningsMode)
+void test(const MWWorld::Ptr& actor, int &compiled, int &total, const Compiler::Extensions* extensions, int warningsMode,
+    MWDialogue::InfoIndices& infoIndices)
 {
-    MWDialogue::Filter filter(actor, 0, false);
+    MWDialogue::Filter filter(actor, 0, false, infoIndices);
 
     MWScript::CompilerContext compilerContext(MWScript::CompilerContext::Type_Dialogue);
     compilerContext.setExtensions(extensions);
@@ -101,18 +103,19 @@ namespace ScriptTest
     std::pair<int, int> compileAll(const Compiler::Extensions *extensions, int warningsMode)
     {
         int compiled = 0, total = 0;
+        InfoIndices infoIndices;
         const MWWorld::Store<ESM::NPC>& npcs = MWBase::Environment::get().getWorld()->getStore().get<ESM::NPC>();
         for (MWWorld::Store<ESM::NPC>::iterator it = npcs.begin(); it != npcs.end(); ++it)
         {
             MWWorld::ManualRef ref(MWBase::Environment::get().getWorld()->getStore(), it->mId);
-            test(ref.getPtr(), compiled, total, extensions, warningsMode);
+            test(ref.getPtr(), compiled, total, extensions, warningsMode, infoIndices);
         }
 
         const MWWorld::Store<ESM::Creature>& creatures = MWBase::Environment::get().getWorld()->getStore().get<ESM::Creature>();
         for (MWWorld::Store<ESM::Creature>::iterator it = creatures.begin(); it != creatures.end(); ++it)
         {
             MWWorld::ManualRef ref(MWBase::Environment::get().getWorld()->getStore(), it->mId);
-            test(ref.getPtr(), compiled, total, extensions, warningsMode);
+            test(ref.getPtr(), compiled, total, extensions, warningsMode, infoIndices);
         }
         return std::make_pair(total, compiled);
     }
@@ -19,6 +19,11 @@ namespace MWMechanics
         return mCharacterController.get();
     }
 
+    const CharacterController* Actor::getCharacterController() const
+    {
+        return mCharacterController.get();
+    }
+
     int Actor::getGreetingTimer() const
     {
         return mGreetingTimer;
@@ -28,6 +28,7 @@ namespace MWMechanics
         void updatePtr(const MWWorld::Ptr& newPtr);
 
         CharacterController* getCharacterController();
+        const CharacterController* getCharacterController() const;
 
         int getGreetingTimer() const;
         void setGreetingTimer(int timer);
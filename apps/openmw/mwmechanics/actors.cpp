@@ -1,5 +1,10 @@
 #include "actors.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <tuple>
+
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 
@@ -7,6 +12,7 @@
 #include <components/debug/debuglog.hpp>
 #include <components/misc/rng.hpp>
 #include <components/misc/mathutil.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 
 #include "../mwworld/esmstore.hpp"
@@ -165,6 +171,36 @@ void forEachFollowingPackage(MWMechanics::Actors::PtrActorMap& actors, const MWW
     }
 }
 
+class RateCombatTargetsItem : public SceneUtil::WorkItem
+{
+public:
+    RateCombatTargetsItem(const MWWorld::Ptr* begin, const MWWorld::Ptr* end)
+        : mBegin(begin), mEnd(end) {}
+
+    /// Returns false if another thread has already taken this item
+    bool claim()
+    {
+        return !mClaimed.exchange(true);
+    }
+
+    void doWork() override
+    {
+        if (claim())
+            run();
+    }
+
+    void run()
+    {
+        for (const MWWorld::Ptr* actor = mBegin; actor != mEnd; ++actor)
+            actor->getClass().getCreatureStats(*actor).getAiSequence().rateCombatTargets(*actor);
+    }
+
+private:
+    const MWWorld::Ptr* mBegin;
+    const MWWorld::Ptr* mEnd;
+    std::atomic_bool mClaimed {false};
+};
+
 }
 
 namespace MWMechanics
@@ -173,6 +209,7 @@ namespace MWMechanics
     static const int GREETING_SHOULD_END = 20;  // how many updates should pass before NPC stops turning to player
     static const int GREETING_COOLDOWN = 40;    // how many updates should pass before NPC can continue movement
     static const float DECELERATE_DISTANCE = 512.f;
+    static const float ACTORS_GRID_CELL_SIZE = 512.f; // proximity queries of collision avoidance use radius up to 200
 
     class GetStuntedMagickaDuration : public MWMechanics::EffectSourceVisitor
     {
@@ -1314,30 +1351,30 @@ namespace MWMechanics
 
     bool Actors::isAttackPreparing(const MWWorld::Ptr& ptr)
     {
-        PtrActorMap::iterator it = mActors.find(ptr);
+        PtrActorMap::iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
-        CharacterController* ctrl = it->second->getCharacterController();
+        CharacterController* ctrl = it->second.getCharacterController();
 
         return ctrl->isAttackPreparing();
     }
 
     bool Actors::isRunning(const MWWorld::Ptr& ptr)
     {
-        PtrActorMap::iterator it = mActors.find(ptr);
+        PtrActorMap::iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
-        CharacterController* ctrl = it->second->getCharacterController();
+        CharacterController* ctrl = it->second.getCharacterController();
 
         return ctrl->isRunning();
     }
 
     bool Actors::isSneaking(const MWWorld::Ptr& ptr)
     {
-        PtrActorMap::iterator it = mActors.find(ptr);
+        PtrActorMap::iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
-        CharacterController* ctrl = it->second->getCharacterController();
+        CharacterController* ctrl = it->second.getCharacterController();
 
         return ctrl->isSneaking();
     }
@@ -1560,10 +1597,22 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors() : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    Actors::Actors(SceneUtil::WorkQueue* workQueue)
+        : mActorsGrid(ACTORS_GRID_CELL_SIZE)
+        , mAiThreads(0)
+        , mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
     {
         mTimerDisposeSummonsCorpses = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
 
+        const int aiThreads = Settings::Manager::getInt("ai num threads", "Game");
+        if (aiThreads < 0)
+            throw std::runtime_error("Invalid setting: 'ai num threads' must be >=0");
+        if (aiThreads > 0 && workQueue != nullptr)
+        {
+            mAiThreads = static_cast<std::size_t>(aiThreads);
+            mAiWorkQueue = workQueue;
+        }
+
         updateProcessingRange();
     }
 
@@ -1572,6 +1621,22 @@ namespace MWMechanics
         clear();
     }
 
+    Actors::PtrActorMap::iterator Actors::findActor(const MWWorld::Ptr& ptr)
+    {
+        const auto it = mActorsIndex.find(ptr.mRef);
+        if (it == mActorsIndex.end())
+            return mActors.end();
+        return mActors.find(it->second);
+    }
+
+    Actors::PtrActorMap::const_iterator Actors::findActor(const MWWorld::Ptr& ptr) const
+    {
+        const auto it = mActorsIndex.find(ptr.mRef);
+        if (it == mActorsIndex.end())
+            return mActors.end();
+        return mActors.find(it->second);
+    }
+
     float Actors::getProcessingRange() const
     {
         return mActorsProcessingRange;
@@ -1596,9 +1661,12 @@ namespace MWMechanics
         MWRender::Animation *anim = MWBase::Environment::get().getWorld()->getAnimation(ptr);
         if (!anim)
             return;
-        mActors.insert(std::make_pair(ptr, new Actor(ptr, anim)));
+        const PtrActorMap::Handle handle = mActors.emplace(std::piecewise_construct,
+            std::forward_as_tuple(ptr), std::forward_as_tuple(ptr, anim));
+        mActorsIndex[ptr.mRef] = handle;
+        mActorsGrid.clear();
 
-        CharacterController* ctrl = mActors[ptr]->getCharacterController();
+        CharacterController* ctrl = mActors.get(handle)->second.getCharacterController();
         if (updateImmediately)
             ctrl->update(0);
 
@@ -1641,19 +1709,21 @@ namespace MWMechanics
 
     void Actors::removeActor (const MWWorld::Ptr& ptr)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
-        if(iter != mActors.end())
+        mActorsGrid.clear();
+
+        const auto index = mActorsIndex.find(ptr.mRef);
+        if (index != mActorsIndex.end())
         {
-            delete iter->second;
-            mActors.erase(iter);
+            mActors.erase(index->second);
+            mActorsIndex.erase(index);
         }
     }
 
     void Actors::castSpell(const MWWorld::Ptr& ptr, const std::string spellId, bool manualSpell)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
+        PtrActorMap::iterator iter = findActor(ptr);
         if(iter != mActors.end())
-            iter->second->getCharacterController()->castSpell(spellId, manualSpell);
+            iter->second.getCharacterController()->castSpell(spellId, manualSpell);
     }
 
     bool Actors::isActorDetected(const MWWorld::Ptr& actor, const MWWorld::Ptr& observer)
@@ -1690,29 +1760,30 @@ namespace MWMechanics
 
     void Actors::updateActor(const MWWorld::Ptr &old, const MWWorld::Ptr &ptr)
     {
-        PtrActorMap::iterator iter = mActors.find(old);
+        mActorsGrid.clear();
+
+        PtrActorMap::iterator iter = findActor(old);
         if(iter != mActors.end())
         {
-            Actor *actor = iter->second;
-            mActors.erase(iter);
+            iter->first = ptr;
+            iter->second.updatePtr(ptr);
 
-            actor->updatePtr(ptr);
-            mActors.insert(std::make_pair(ptr, actor));
+            mActorsIndex.erase(old.mRef);
+            mActorsIndex[ptr.mRef] = iter.getHandle();
         }
     }
 
     void Actors::dropActors (const MWWorld::CellStore *cellStore, const MWWorld::Ptr& ignore)
     {
-        PtrActorMap::iterator iter = mActors.begin();
-        while(iter != mActors.end())
+        mActorsGrid.clear();
+
+        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
         {
             if((iter->first.isInCell() && iter->first.getCell()==cellStore) && iter->first != ignore)
             {
-                delete iter->second;
-                mActors.erase(iter++);
+                mActorsIndex.erase(iter->first.mRef);
+                mActors.erase(iter.getHandle());
             }
-            else
-                ++iter;
         }
     }
 
@@ -1772,6 +1843,7 @@ namespace MWMechanics
 
         MWWorld::Ptr player = getPlayer();
         MWBase::World* world = MWBase::Environment::get().getWorld();
+        std::vector<MWWorld::Ptr> neighbors;
         for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
         {
             const MWWorld::Ptr& ptr = iter->first;
@@ -1824,10 +1896,11 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for(PtrActorMap::iterator otherIter(mActors.begin()); otherIter != mActors.end(); ++otherIter)
+            // Iterate through other actors nearby and predict collisions.
+            neighbors.clear();
+            getObjectsInRange(basePos, maxDistToCheck, neighbors);
+            for (const MWWorld::Ptr& otherPtr : neighbors)
             {
-                const MWWorld::Ptr& otherPtr = otherIter->first;
                 if (otherPtr == ptr || otherPtr == currentTarget)
                     continue;
 
@@ -1936,11 +2009,18 @@ namespace MWMechanics
             }
             bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
+            updateActorsGrid();
+            std::vector<MWWorld::Ptr> neighbors;
+
+            // Rate targets of all actors at once, so the ratings depend only on the state at the start of the update
+            if (aiActive && mAiWorkQueue != nullptr)
+                rateCombatTargets(playerPos);
+
              // AI and magic effects update
             for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
             {
                 bool isPlayer = iter->first == player;
-                CharacterController* ctrl = iter->second->getCharacterController();
+                CharacterController* ctrl = iter->second.getCharacterController();
 
                 float distSqr = (playerPos - iter->first.getRefData().getPosition().asVec3()).length2();
                 // AI processing is only done within given distance to the player.
@@ -1984,6 +2064,7 @@ namespace MWMechanics
 
                     if (!cellChanged && world->hasCellChanged())
                     {
+                        mActorsGrid.clear();
                         return; // for now abort update of the old cell when cell changes by teleportation magic effect
                                 // a better solution might be to apply cell changes at the end of the frame
                     }
@@ -1991,14 +2072,19 @@ namespace MWMechanics
                     {
                         if (timerUpdateAITargets == 0)
                         {
-                            if (!isPlayer)
+                            if (!isPlayer) // player is not AI-controlled
+                            {
                                 adjustCommandedActor(iter->first);
 
-                            for(PtrActorMap::iterator it(mActors.begin()); it != mActors.end(); ++it)
-                            {
-                                if (it->first == iter->first || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(iter->first, it->first, cachedAllies, it->first == player);
+                                // Combat is not engaged with actors outside of processing range
+                                neighbors.clear();
+                                getObjectsInRange(iter->first.getRefData().getPosition().asVec3(), mActorsProcessingRange, neighbors);
+                                for (const MWWorld::Ptr& neighbor : neighbors)
+                                {
+                                    if (neighbor == iter->first)
+                                        continue;
+                                    engageCombat(iter->first, neighbor, cachedAllies, neighbor == player);
+                                }
                             }
                         }
                         if (timerUpdateHeadTrack == 0)
@@ -2046,7 +2132,7 @@ namespace MWMechanics
                             if (isConscious(iter->first))
                             {
                                 stats.getAiSequence().execute(iter->first, *ctrl, duration);
-                                updateGreetingState(iter->first, *iter->second, timerUpdateHello > 0);
+                                updateGreetingState(iter->first, iter->second, timerUpdateHello > 0);
                                 playIdleDialogue(iter->first);
                                 updateMovementSpeed(iter->first);
                             }
@@ -2102,7 +2188,7 @@ namespace MWMechanics
                     activeFlag = 2;
                 int active = inRange ? activeFlag : 0;
 
-                CharacterController* ctrl = iter->second->getCharacterController();
+                CharacterController* ctrl = iter->second.getCharacterController();
                 ctrl->setActive(active);
 
                 if (!inRange)
@@ -2159,6 +2245,8 @@ namespace MWMechanics
 
             killDeadActors();
             updateSneaking(playerCharacter, duration);
+
+            mActorsGrid.clear();
         }
 
         updateCombatMusic();
@@ -2173,14 +2261,14 @@ namespace MWMechanics
 
     void Actors::resurrect(const MWWorld::Ptr &ptr)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
+        PtrActorMap::iterator iter = findActor(ptr);
         if(iter != mActors.end())
         {
-            if(iter->second->getCharacterController()->isDead())
+            if(iter->second.getCharacterController()->isDead())
             {
                 // Actor has been resurrected. Notify the CharacterController and re-enable collision.
                 MWBase::Environment::get().getWorld()->enableActorCollision(iter->first, true);
-                iter->second->getCharacterController()->resurrect();
+                iter->second.getCharacterController()->resurrect();
             }
         }
     }
@@ -2196,7 +2284,7 @@ namespace MWMechanics
                 continue;
 
             MWBase::Environment::get().getWorld()->removeActorPath(iter->first);
-            CharacterController::KillResult killResult = iter->second->getCharacterController()->kill();
+            CharacterController::KillResult killResult = iter->second.getCharacterController()->kill();
             if (killResult == CharacterController::Result_DeathAnimStarted)
             {
                 // Play dying words
@@ -2442,17 +2530,17 @@ namespace MWMechanics
 
     void Actors::forceStateUpdate(const MWWorld::Ptr & ptr)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
+        PtrActorMap::iterator iter = findActor(ptr);
         if(iter != mActors.end())
-            iter->second->getCharacterController()->forceStateUpdate();
+            iter->second.getCharacterController()->forceStateUpdate();
     }
 
     bool Actors::playAnimationGroup(const MWWorld::Ptr& ptr, const std::string& groupName, int mode, int number, bool persist)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
+        PtrActorMap::iterator iter = findActor(ptr);
         if(iter != mActors.end())
         {
-            return iter->second->getCharacterController()->playGroup(groupName, mode, number, persist);
+            return iter->second.getCharacterController()->playGroup(groupName, mode, number, persist);
         }
         else
         {
@@ -2462,36 +2550,116 @@ namespace MWMechanics
     }
     void Actors::skipAnimation(const MWWorld::Ptr& ptr)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
+        PtrActorMap::iterator iter = findActor(ptr);
         if(iter != mActors.end())
-            iter->second->getCharacterController()->skipAnim();
+            iter->second.getCharacterController()->skipAnim();
     }
 
     bool Actors::checkAnimationPlaying(const MWWorld::Ptr& ptr, const std::string& groupName)
     {
-        PtrActorMap::iterator iter = mActors.find(ptr);
+        PtrActorMap::iterator iter = findActor(ptr);
         if(iter != mActors.end())
-            return iter->second->getCharacterController()->isAnimPlaying(groupName);
+            return iter->second.getCharacterController()->isAnimPlaying(groupName);
         return false;
     }
 
     void Actors::persistAnimationStates()
     {
         for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
-            iter->second->getCharacterController()->persistAnimationState();
+            iter->second.getCharacterController()->persistAnimationState();
+    }
+
+    void Actors::rateCombatTargets(const osg::Vec3f& playerPos)
+    {
+        const MWWorld::Ptr player = getPlayer();
+        std::vector<MWWorld::Ptr> raters;
+        std::vector<MWWorld::Ptr> targets;
+        for (const auto& [ptr, actor] : mActors)
+        {
+            if (ptr == player)
+                continue;
+            AiSequence& sequence = ptr.getClass().getCreatureStats(ptr).getAiSequence();
+            const float distSqr = (playerPos - ptr.getRefData().getPosition().asVec3()).length2();
+            if (distSqr > mActorsProcessingRange * mActorsProcessingRange || !isConscious(ptr))
+            {
+                sequence.clearCombatTargetRatings();
+                continue;
+            }
+            const std::size_t targetsCount = targets.size();
+            sequence.prepareCombatTargetRatings(targets);
+            if (targets.size() != targetsCount)
+                raters.push_back(ptr);
+        }
+
+        if (raters.empty())
+            return;
+
+        for (const MWWorld::Ptr& ptr : raters)
+            prepareActionRating(ptr);
+        for (const MWWorld::Ptr& ptr : targets)
+            prepareActionRating(ptr);
+
+        // Main thread takes the first part
+        const std::size_t parts = std::min(raters.size(), mAiThreads + 1);
+        const MWWorld::Ptr* const begin = raters.data();
+        std::vector<osg::ref_ptr<RateCombatTargetsItem>> items;
+        items.reserve(parts - 1);
+        for (std::size_t i = 1; i < parts; ++i)
+        {
+            items.emplace_back(new RateCombatTargetsItem(begin + raters.size() * i / parts,
+                                                         begin + raters.size() * (i + 1) / parts));
+            mAiWorkQueue->addWorkItem(items.back(), SceneUtil::WorkPriority::High);
+        }
+        RateCombatTargetsItem(begin, begin + raters.size() / parts).run();
+        // The queue is shared with preloading, so run the parts no worker thread has started yet instead of
+        // waiting for them
+        for (const osg::ref_ptr<RateCombatTargetsItem>& item : items)
+        {
+            if (item->claim())
+                item->run();
+            else
+                item->waitTillDone();
+        }
+    }
+
+    void Actors::updateActorsGrid()
+    {
+        mActorsGrid.clear();
+        for (const auto& actor : mActors)
+            mActorsGrid.insert(actor.first.getRefData().getPosition().asVec3(), actor.first);
+        mActorsGrid.build();
     }
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out)
     {
-        for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
+        const std::size_t begin = out.size();
+        if (mActorsGrid.isBuilt())
         {
-            if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                out.push_back(iter->first);
+            mActorsGrid.forEachInRange(position, radius,
+                [&] (const MWWorld::Ptr& ptr, const osg::Vec3f& /*position*/) { out.push_back(ptr); });
         }
+        else
+        {
+            for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
+            {
+                if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
+                    out.push_back(iter->first);
+            }
+        }
+        // Sort by Ptr, so results depend neither on grid layout nor on slots the actors were given
+        std::sort(out.begin() + begin, out.end());
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius)
     {
+        if (mActorsGrid.isBuilt())
+        {
+            bool result = false;
+            mActorsGrid.forEachInRange(position, radius,
+                [&] (const MWWorld::Ptr& /*ptr*/, const osg::Vec3f& /*position*/) { result = true; });
+            return result;
+        }
+
         for (PtrActorMap::iterator iter = mActors.begin(); iter != mActors.end(); ++iter)
         {
             if ((iter->first.getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
@@ -2697,13 +2865,9 @@ namespace MWMechanics
 
     void Actors::clear()
     {
-        PtrActorMap::iterator it(mActors.begin());
-        for (; it != mActors.end(); ++it)
-        {
-            delete it->second;
-            it->second = nullptr;
-        }
         mActors.clear();
+        mActorsIndex.clear();
+        mActorsGrid.clear();
         mDeathCount.clear();
     }
 
@@ -2717,66 +2881,66 @@ namespace MWMechanics
 
     bool Actors::isReadyToBlock(const MWWorld::Ptr &ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
 
-        return it->second->getCharacterController()->isReadyToBlock();
+        return it->second.getCharacterController()->isReadyToBlock();
     }
 
     bool Actors::isCastingSpell(const MWWorld::Ptr &ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
 
-        return it->second->getCharacterController()->isCastingSpell();
+        return it->second.getCharacterController()->isCastingSpell();
     }
 
     bool Actors::isAttackingOrSpell(const MWWorld::Ptr& ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
-        CharacterController* ctrl = it->second->getCharacterController();
+        const CharacterController* ctrl = it->second.getCharacterController();
 
         return ctrl->isAttackingOrSpell();
     }
 
     int Actors::getGreetingTimer(const MWWorld::Ptr& ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return 0;
 
-        return it->second->getGreetingTimer();
+        return it->second.getGreetingTimer();
     }
 
     float Actors::getAngleToPlayer(const MWWorld::Ptr& ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return 0.f;
 
-        return it->second->getAngleToPlayer();
+        return it->second.getAngleToPlayer();
     }
 
     GreetingState Actors::getGreetingState(const MWWorld::Ptr& ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return Greet_None;
 
-        return it->second->getGreetingState();
+        return it->second.getGreetingState();
     }
 
     bool Actors::isTurningToPlayer(const MWWorld::Ptr& ptr) const
     {
-        PtrActorMap::const_iterator it = mActors.find(ptr);
+        PtrActorMap::const_iterator it = findActor(ptr);
         if (it == mActors.end())
             return false;
 
-        return it->second->isTurningToPlayer();
+        return it->second.isTurningToPlayer();
     }
 
     void Actors::fastForwardAi()
@@ -2784,11 +2948,13 @@ namespace MWMechanics
         if (!MWBase::Environment::get().getMechanicsManager()->isAIActive())
             return;
 
-        // making a copy since fast-forward could move actor to a different cell and invalidate the mActors iterator
-        PtrActorMap map = mActors;
-        for (PtrActorMap::iterator it = map.begin(); it != map.end(); ++it)
+        // making a copy since fast-forward could move actor to a different cell and change its Ptr in mActors
+        std::vector<MWWorld::Ptr> actors;
+        actors.reserve(mActors.size());
+        for (const auto& actor : mActors)
+            actors.push_back(actor.first);
+        for (MWWorld::Ptr ptr : actors)
         {
-            MWWorld::Ptr ptr = it->first;
             if (ptr == getPlayer()
                     || !isConscious(ptr)
                     || ptr.getClass().getCreatureStats(ptr).isParalyzed())
@@ -6,20 +6,26 @@
 #include <string>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <utility>
+
+#include <osg/ref_ptr>
+
+#include <components/misc/slotmap.hpp>
+#include <components/misc/spatialhash.hpp>
+
+#include "../mwworld/ptr.hpp"
 
 #include "../mwmechanics/actorutil.hpp"
 
+#include "actor.hpp"
+
 namespace ESM
 {
     class ESMReader;
     class ESMWriter;
 }
 
-namespace osg
-{
-    class Vec3f;
-}
-
 namespace Loading
 {
     class Listener;
@@ -27,13 +33,16 @@ namespace Loading
 
 namespace MWWorld
 {
-    class Ptr;
     class CellStore;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWMechanics
 {
-    class Actor;
     class CharacterController;
     class CreatureStats;
 
@@ -65,15 +74,23 @@ namespace MWMechanics
 
             void predictAndAvoidCollisions();
 
+            void updateActorsGrid();
+
+            /// Rates combat targets for AiSequence::execute of actors in processing range on the work queue
+            void rateCombatTargets(const osg::Vec3f& playerPos);
+
         public:
 
-            Actors();
+            /// @param workQueue shared with other background work, combat targets are rated there if
+            /// 'ai num threads' is set
+            explicit Actors(SceneUtil::WorkQueue* workQueue);
             ~Actors();
 
-            typedef std::map<MWWorld::Ptr,Actor*> PtrActorMap;
+            /// Actor state is stored in place and iterated in slot order, use findActor to look up by Ptr
+            typedef Misc::SlotMap<std::pair<MWWorld::Ptr, Actor>> PtrActorMap;
 
-            PtrActorMap::const_iterator begin() { return mActors.begin(); }
-            PtrActorMap::const_iterator end() { return mActors.end(); }
+            PtrActorMap::const_iterator begin() const { return mActors.begin(); }
+            PtrActorMap::const_iterator end() const { return mActors.end(); }
             std::size_t size() const { return mActors.size(); }
 
             void notifyDied(const MWWorld::Ptr &actor);
@@ -209,7 +226,16 @@ namespace MWMechanics
         void updateVisibility (const MWWorld::Ptr& ptr, CharacterController* ctrl);
         void applyCureEffects (const MWWorld::Ptr& actor);
 
+        PtrActorMap::iterator findActor(const MWWorld::Ptr& ptr);
+        PtrActorMap::const_iterator findActor(const MWWorld::Ptr& ptr) const;
+
         PtrActorMap mActors;
+        // Handles of actors by their reference, the Ptr itself may change when the actor moves between cells
+        std::unordered_map<const MWWorld::LiveCellRefBase*, PtrActorMap::Handle> mActorsIndex;
+        // Positions of actors at the start of the update, used by proximity queries while the update is running
+        Misc::SpatialHash<MWWorld::Ptr> mActorsGrid;
+        osg::ref_ptr<SceneUtil::WorkQueue> mAiWorkQueue;
+        std::size_t mAiThreads;
         float mTimerDisposeSummonsCorpses;
         float mActorsProcessingRange;
 
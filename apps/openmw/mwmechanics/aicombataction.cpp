@@ -278,6 +278,15 @@ namespace MWMechanics
         return bestActionRating;
     }
 
+    void prepareActionRating(const MWWorld::Ptr& actor)
+    {
+        const MWWorld::Class& actorClass = actor.getClass();
+        // Rebuilds the cached magic effects after spells were added or removed
+        actorClass.getCreatureStats(actor).getActiveSpells().getMagicEffects();
+        // Updates the cached weight of the inventory
+        actorClass.getEncumbrance(actor);
+    }
+
 
     float getDistanceMinusHalfExtents(const MWWorld::Ptr& actor1, const MWWorld::Ptr& actor2, bool minusZDist)
     {
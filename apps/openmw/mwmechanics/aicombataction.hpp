@@ -88,8 +88,13 @@ namespace MWMechanics
     };
 
     std::shared_ptr<Action> prepareNextAction (const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
+    /// Only reads the state of the actor and the enemy once prepareActionRating was called for both of them.
     float getBestActionRating(const MWWorld::Ptr &actor, const MWWorld::Ptr &enemy);
 
+    /// Updates lazily computed state of the actor read by getBestActionRating, so several actors can be rated at
+    /// once. Has to be called from the main thread.
+    void prepareActionRating(const MWWorld::Ptr& actor);
+
     float getDistanceMinusHalfExtents(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy, bool minusZDist=false);
     float getMaxAttackDistance(const MWWorld::Ptr& actor);
     bool canFight(const MWWorld::Ptr& actor, const MWWorld::Ptr& enemy);
@@ -1,5 +1,6 @@
 #include "aisequence.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #include <components/debug/debuglog.hpp>
@@ -201,8 +202,47 @@ namespace
     }
 }
 
+void AiSequence::prepareCombatTargetRatings(std::vector<MWWorld::Ptr>& targets)
+{
+    mCombatTargetRatings.clear();
+    for (const auto& package : mPackages)
+    {
+        if (package->getTypeId() != AiPackageTypeId::Combat)
+            break;
+        const MWWorld::Ptr target = package->getTarget();
+        if (target.isEmpty())
+            continue;
+        mCombatTargetRatings.push_back(CombatTargetRating {target});
+        targets.push_back(target);
+    }
+}
+
+void AiSequence::rateCombatTargets(const MWWorld::Ptr& actor)
+{
+    for (CombatTargetRating& v : mCombatTargetRatings)
+    {
+        try
+        {
+            v.mRating = MWMechanics::getBestActionRating(actor, v.mTarget);
+            v.mRated = true;
+        }
+        catch (const std::exception&)
+        {
+            // Leave it to execute to rate the target again and report the error
+        }
+    }
+}
+
+void AiSequence::clearCombatTargetRatings()
+{
+    mCombatTargetRatings.clear();
+}
+
 void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange)
 {
+    const std::vector<CombatTargetRating> combatTargetRatings = std::move(mCombatTargetRatings);
+    mCombatTargetRatings.clear();
+
     if(actor != getPlayer())
     {
         if (mPackages.empty())
@@ -243,7 +283,10 @@ void AiSequence::execute (const MWWorld::Ptr& actor, CharacterController& charac
                 }
                 else
                 {
-                    float rating = MWMechanics::getBestActionRating(actor, target);
+                    const auto rated = std::find_if(combatTargetRatings.begin(), combatTargetRatings.end(),
+                        [&] (const CombatTargetRating& v) { return v.mRated && v.mTarget == target; });
+                    const float rating = rated == combatTargetRatings.end()
+                        ? MWMechanics::getBestActionRating(actor, target) : rated->mRating;
 
                     const ESM::Position &targetPos = target.getRefData().getPosition();
 
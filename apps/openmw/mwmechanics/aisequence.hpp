@@ -3,16 +3,14 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "aistate.hpp"
 #include "aipackagetypeid.hpp"
 
 #include <components/esm/loadnpc.hpp>
 
-namespace MWWorld
-{
-    class Ptr;
-}
+#include "../mwworld/ptr.hpp"
 
 namespace ESM
 {
@@ -53,6 +51,16 @@ namespace MWMechanics
             AiPackageTypeId mLastAiPackage;
             AiState mAiState;
 
+            struct CombatTargetRating
+            {
+                MWWorld::Ptr mTarget;
+                float mRating = 0;
+                bool mRated = false;
+            };
+
+            /// Ratings of combat targets computed ahead of execute, used only by the next execute call
+            std::vector<CombatTargetRating> mCombatTargetRatings;
+
         public:
             ///Default constructor
             AiSequence();
@@ -111,6 +119,16 @@ namespace MWMechanics
             /// Removes all pursue packages until first non-pursue or stack empty.
             void stopPursuit();
 
+            /// Collects the targets of the leading combat packages execute rates to choose the target and appends them
+            /// to \a targets. Discards previous ratings. Has to be called from the main thread.
+            void prepareCombatTargetRatings(std::vector<MWWorld::Ptr>& targets);
+
+            /// Rates the targets collected by prepareCombatTargetRatings for execute. Only reads the state of actors, so
+            /// it may be called for several actors at once from other threads.
+            void rateCombatTargets(const MWWorld::Ptr& actor);
+
+            void clearCombatTargetRatings();
+
             /// Execute current package, switching if needed.
             void execute (const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange=false);
 
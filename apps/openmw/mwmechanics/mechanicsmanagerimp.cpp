@@ -236,9 +236,9 @@ namespace MWMechanics
         invStore.autoEquip(ptr);
     }
 
-    MechanicsManager::MechanicsManager()
+    MechanicsManager::MechanicsManager(SceneUtil::WorkQueue* workQueue)
     : mUpdatePlayer (true), mClassSelected (false),
-      mRaceSelected (false), mAI(true)
+      mRaceSelected (false), mAI(true), mActors(workQueue)
     {
         //buildPlayer no longer here, needs to be done explicitly after all subsystems are up and running
     }
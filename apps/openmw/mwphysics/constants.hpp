@@ -1,9 +1,11 @@
 #ifndef OPENMW_MWPHYSICS_CONSTANTS_H
 #define OPENMW_MWPHYSICS_CONSTANTS_H
 
+#include <components/misc/constants.hpp>
+
 namespace MWPhysics
 {
-    static const float sStepSizeUp = 34.0f;
+    static const float sStepSizeUp = Constants::StepSizeUp;
     static const float sStepSizeDown = 62.0f;
 
     static const float sMinStep = 10.0f; // hack to skip over tiny unwalkable slopes
@@ -12,7 +14,7 @@ namespace MWPhysics
     static const bool sDoExtraStairHacks = true;
 
     static const float sGroundOffset = 1.0f;
-    static const float sMaxSlope = 49.0f;
+    static const float sMaxSlope = Constants::MaxSlope;
 
     // Arbitrary number. To prevent infinite loops. They shouldn't happen but it's good to be prepared.
     static const int sMaxIterations = 8;
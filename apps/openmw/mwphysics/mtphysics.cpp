@@ -4,6 +4,7 @@
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/tracing.hpp"
 #include <components/misc/barrier.hpp>
 #include "components/misc/convert.hpp"
 #include "components/settings/settings.hpp"
@@ -445,6 +446,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
+        Debug::setTraceThreadName("Physics worker");
         std::shared_lock lock(mSimulationMutex);
         while (!mQuit)
         {
@@ -454,12 +456,15 @@ namespace MWPhysics
             mPreStepBarrier->wait();
 
             int job = 0;
-            while (mRemainingSteps && (job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
             {
-                if(const auto actor = mActorsFrameData[job].mActor.lock())
+                const Debug::ScopedTrace trace("Move actors", "Physics");
+                while (mRemainingSteps && (job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
                 {
-                    MaybeSharedLock lockColWorld(mCollisionWorldMutex, mThreadSafeBullet);
-                    MovementSolver::move(mActorsFrameData[job], mPhysicsDt, mCollisionWorld.get(), *mWorldFrameData);
+                    if(const auto actor = mActorsFrameData[job].mActor.lock())
+                    {
+                        MaybeSharedLock lockColWorld(mCollisionWorldMutex, mThreadSafeBullet);
+                        MovementSolver::move(mActorsFrameData[job], mPhysicsDt, mCollisionWorld.get(), *mWorldFrameData);
+                    }
                 }
             }
 
@@ -467,17 +472,20 @@ namespace MWPhysics
 
             if (!mRemainingSteps)
             {
-                while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
                 {
-                    if(const auto actor = mActorsFrameData[job].mActor.lock())
+                    const Debug::ScopedTrace trace("Finish simulation", "Physics");
+                    while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
                     {
-                        auto& actorData = mActorsFrameData[job];
-                        handleFall(actorData, mAdvanceSimulation);
+                        if(const auto actor = mActorsFrameData[job].mActor.lock())
+                        {
+                            auto& actorData = mActorsFrameData[job];
+                            handleFall(actorData, mAdvanceSimulation);
+                        }
                     }
-                }
 
-                if (mLOSCacheExpiry >= 0)
-                    refreshLOSCache();
+                    if (mLOSCacheExpiry >= 0)
+                        refreshLOSCache();
+                }
                 mPostSimBarrier->wait();
             }
         }
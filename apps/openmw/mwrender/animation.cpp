@@ -531,7 +531,7 @@ namespace MWRender
     {
         osg::ref_ptr<const SceneUtil::KeyframeHolder> mKeyframes;
 
-        typedef std::map<std::string, osg::ref_ptr<SceneUtil::KeyframeController> > ControllerMap;
+        typedef std::unordered_map<Misc::InternedString, osg::ref_ptr<SceneUtil::KeyframeController> > ControllerMap;
 
         ControllerMap mControllerMap[Animation::sNumBlendMasks];
 
@@ -753,11 +753,11 @@ namespace MWRender
         for (SceneUtil::KeyframeHolder::KeyframeControllerMap::const_iterator it = animsrc->mKeyframes->mKeyframeControllers.begin();
              it != animsrc->mKeyframes->mKeyframeControllers.end(); ++it)
         {
-            std::string bonename = Misc::StringUtils::lowerCase(it->first);
+            const Misc::InternedString bonename = Misc::InternedString::find(it->first);
             NodeMap::const_iterator found = nodeMap.find(bonename);
             if (found == nodeMap.end())
             {
-                Log(Debug::Warning) << "Warning: addAnimSource: can't find bone '" + bonename << "' in " << baseModel << " (referenced by " << kfname << ")";
+                Log(Debug::Warning) << "Warning: addAnimSource: can't find bone '" << it->first << "' in " << baseModel << " (referenced by " << kfname << ")";
                 continue;
             }
 
@@ -779,9 +779,9 @@ namespace MWRender
 
         if (!mAccumRoot)
         {
-            NodeMap::const_iterator found = nodeMap.find("bip01");
+            NodeMap::const_iterator found = nodeMap.find(Misc::InternedString::find("bip01"));
             if (found == nodeMap.end())
-                found = nodeMap.find("root bone");
+                found = nodeMap.find(Misc::InternedString::find("root bone"));
 
             if (found != nodeMap.end())
                 mAccumRoot = found->second;
@@ -1193,15 +1193,12 @@ namespace MWRender
         float velocity = 0.0f;
         const SceneUtil::TextKeyMap &keys = (*animsrc)->getTextKeys();
 
+        const Misc::InternedString accumRootName = Misc::InternedString::find(mAccumRoot->getName());
+
         const AnimSource::ControllerMap& ctrls = (*animsrc)->mControllerMap[0];
-        for (AnimSource::ControllerMap::const_iterator it = ctrls.begin(); it != ctrls.end(); ++it)
-        {
-            if (Misc::StringUtils::ciEqual(it->first, mAccumRoot->getName()))
-            {
-                velocity = calcAnimVelocity(keys, it->second, mAccumulate, groupname);
-                break;
-            }
-        }
+        const AnimSource::ControllerMap::const_iterator found = ctrls.find(accumRootName);
+        if (found != ctrls.end())
+            velocity = calcAnimVelocity(keys, found->second, mAccumulate, groupname);
 
         // If there's no velocity, keep looking
         if(!(velocity > 1.0f))
@@ -1215,14 +1212,9 @@ namespace MWRender
                 const SceneUtil::TextKeyMap &keys2 = (*animiter)->getTextKeys();
 
                 const AnimSource::ControllerMap& ctrls2 = (*animiter)->mControllerMap[0];
-                for (AnimSource::ControllerMap::const_iterator it = ctrls2.begin(); it != ctrls2.end(); ++it)
-                {
-                    if (Misc::StringUtils::ciEqual(it->first, mAccumRoot->getName()))
-                    {
-                        velocity = calcAnimVelocity(keys2, it->second, mAccumulate, groupname);
-                        break;
-                    }
-                }
+                const AnimSource::ControllerMap::const_iterator found2 = ctrls2.find(accumRootName);
+                if (found2 != ctrls2.end())
+                    velocity = calcAnimVelocity(keys2, found2->second, mAccumulate, groupname);
             }
         }
 
@@ -1640,7 +1632,7 @@ namespace MWRender
             parentNode = mInsert;
         else
         {
-            NodeMap::const_iterator found = getNodeMap().find(Misc::StringUtils::lowerCase(bonename));
+            NodeMap::const_iterator found = getNodeMap().find(Misc::InternedString::find(bonename));
             if (found == getNodeMap().end())
                 throw std::runtime_error("Can't find bone " + bonename);
 
@@ -1743,8 +1735,7 @@ namespace MWRender
 
     const osg::Node* Animation::getNode(const std::string &name) const
     {
-        std::string lowerName = Misc::StringUtils::lowerCase(name);
-        NodeMap::const_iterator found = getNodeMap().find(lowerName);
+        NodeMap::const_iterator found = getNodeMap().find(Misc::InternedString::find(name));
         if (found == getNodeMap().end())
             return nullptr;
         else
@@ -1827,7 +1818,7 @@ namespace MWRender
 
     RotateController* Animation::addRotateController(std::string bone)
     {
-        auto iter = getNodeMap().find(bone);
+        auto iter = getNodeMap().find(Misc::InternedString::find(bone));
         if (iter == getNodeMap().end())
             return nullptr;
         osg::MatrixTransform* node = iter->second;
@@ -6,7 +6,9 @@
 #include <components/sceneutil/controller.hpp>
 #include <components/sceneutil/textkeymap.hpp>
 #include <components/sceneutil/util.hpp>
+#include <components/misc/internedstring.hpp>
 
+#include <unordered_map>
 #include <vector>
 
 namespace ESM
@@ -249,8 +251,8 @@ protected:
 
     std::shared_ptr<AnimationTime> mAnimationTimePtr[sNumBlendMasks];
 
-    // Stored in all lowercase for a case-insensitive lookup
-    typedef std::map<std::string, osg::ref_ptr<osg::MatrixTransform> > NodeMap;
+    // Keys are interned for a case-insensitive lookup
+    typedef std::unordered_map<Misc::InternedString, osg::ref_ptr<osg::MatrixTransform> > NodeMap;
     mutable NodeMap mNodeMap;
     mutable bool mNodeMapCreated;
 
@@ -126,7 +126,7 @@ void CreatureWeaponAnimation::updatePart(PartHolderPtr& scene, int slot)
             if (bonename != "Weapon Bone")
             {
                 const NodeMap& nodeMap = getNodeMap();
-                NodeMap::const_iterator found = nodeMap.find(Misc::StringUtils::lowerCase(bonename));
+                NodeMap::const_iterator found = nodeMap.find(Misc::InternedString::find(bonename));
                 if (found == nodeMap.end())
                     bonename = "Weapon Bone";
             }
@@ -161,7 +161,7 @@ void CreatureWeaponAnimation::updatePart(PartHolderPtr& scene, int slot)
         osg::ref_ptr<osg::Node> node = mResourceSystem->getSceneManager()->getInstance(itemModel);
 
         const NodeMap& nodeMap = getNodeMap();
-        NodeMap::const_iterator found = nodeMap.find(Misc::StringUtils::lowerCase(bonename));
+        NodeMap::const_iterator found = nodeMap.find(Misc::InternedString::find(bonename));
         if (found == nodeMap.end())
             throw std::runtime_error("Can't find attachment node " + bonename);
         osg::ref_ptr<osg::Node> attached = SceneUtil::attach(node, mObjectRoot, bonename, found->second.get());
@@ -717,7 +717,7 @@ PartHolderPtr NpcAnimation::insertBoundedPart(const std::string& model, const st
     osg::ref_ptr<osg::Node> instance = mResourceSystem->getSceneManager()->getInstance(model);
 
     const NodeMap& nodeMap = getNodeMap();
-    NodeMap::const_iterator found = nodeMap.find(Misc::StringUtils::lowerCase(bonename));
+    NodeMap::const_iterator found = nodeMap.find(Misc::InternedString::find(bonename));
     if (found == nodeMap.end())
         throw std::runtime_error("Can't find attachment node " + bonename);
 
@@ -817,7 +817,7 @@ bool NpcAnimation::addOrReplaceIndividualPart(ESM::PartReferenceType type, int g
                 if (weaponBonename != bonename)
                 {
                     const NodeMap& nodeMap = getNodeMap();
-                    NodeMap::const_iterator found = nodeMap.find(Misc::StringUtils::lowerCase(weaponBonename));
+                    NodeMap::const_iterator found = nodeMap.find(Misc::InternedString::find(weaponBonename));
                     if (found != nodeMap.end())
                         bonename = weaponBonename;
                 }
@@ -950,7 +950,7 @@ void NpcAnimation::addControllers()
 
     if (mViewMode == VM_FirstPerson)
     {
-        NodeMap::iterator found = mNodeMap.find("bip01 neck");
+        NodeMap::iterator found = mNodeMap.find(Misc::InternedString::find("bip01 neck"));
         if (found != mNodeMap.end())
         {
             osg::MatrixTransform* node = found->second.get();
@@ -172,14 +172,14 @@ void WeaponAnimation::releaseArrow(MWWorld::Ptr actor, float attackStrength)
     }
 }
 
-void WeaponAnimation::addControllers(const std::map<std::string, osg::ref_ptr<osg::MatrixTransform> >& nodes,
+void WeaponAnimation::addControllers(const std::unordered_map<Misc::InternedString, osg::ref_ptr<osg::MatrixTransform> >& nodes,
     std::vector<std::pair<osg::ref_ptr<osg::Node>, osg::ref_ptr<osg::NodeCallback>>> &map, osg::Node* objectRoot)
 {
     for (int i=0; i<2; ++i)
     {
         mSpineControllers[i] = nullptr;
 
-        std::map<std::string, osg::ref_ptr<osg::MatrixTransform> >::const_iterator found = nodes.find(i == 0 ? "bip01 spine1" : "bip01 spine2");
+        const auto found = nodes.find(Misc::InternedString::find(i == 0 ? "bip01 spine1" : "bip01 spine2"));
         if (found != nodes.end())
         {
             osg::Node* node = found->second;
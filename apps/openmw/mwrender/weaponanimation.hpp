@@ -42,7 +42,7 @@ namespace MWRender
         void releaseArrow(MWWorld::Ptr actor, float attackStrength);
 
         /// Add WeaponAnimation-related controllers to \a nodes and store the added controllers in \a map.
-        void addControllers(const std::map<std::string, osg::ref_ptr<osg::MatrixTransform> >& nodes,
+        void addControllers(const std::unordered_map<Misc::InternedString, osg::ref_ptr<osg::MatrixTransform> >& nodes,
                 std::vector<std::pair<osg::ref_ptr<osg::Node>, osg::ref_ptr<osg::NodeCallback>>>& map, osg::Node* objectRoot);
 
         void deleteControllers();
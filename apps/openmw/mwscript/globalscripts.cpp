@@ -114,7 +114,7 @@ namespace MWScript
 
 
     GlobalScripts::GlobalScripts (const MWWorld::ESMStore& store)
-    : mStore (store)
+    : mStore (store), mDeferredCount (0)
     {}
 
     void GlobalScripts::addScript (const std::string& name, const MWWorld::Ptr& target)
@@ -165,20 +165,57 @@ namespace MWScript
 
     void GlobalScripts::run()
     {
-        for (const auto& script : mScripts)
+        MWBase::ScriptManager& scriptManager = *MWBase::Environment::get().getScriptManager();
+
+        // Continue from the first script deferred in the previous frame, so every script gets its turn
+        const std::string start = std::move(mNextScript);
+        mNextScript.clear();
+        mDeferredCount = 0;
+
+        bool ran = false;
+        bool deferring = false;
+
+        const auto runScript = [&] (const std::pair<const std::string, std::shared_ptr<GlobalScriptDesc>>& script)
         {
-            if (script.second->mRunning)
+            if (!script.second->mRunning)
+                return;
+
+            // At least one script is run per frame even if local scripts have used the whole budget
+            if (!deferring && ran && scriptManager.isFrameBudgetExceeded())
             {
-                MWScript::InterpreterContext context(script.second);
-                if (!MWBase::Environment::get().getScriptManager()->run(script.first, context))
-                    script.second->mRunning = false;
+                deferring = true;
+                mNextScript = script.first;
             }
-        }
+
+            if (deferring)
+            {
+                ++mDeferredCount;
+                return;
+            }
+
+            ran = true;
+            MWScript::InterpreterContext context(script.second);
+            if (!scriptManager.run(script.first, context))
+                script.second->mRunning = false;
+        };
+
+        for (auto iter = mScripts.lower_bound(start); iter != mScripts.end(); ++iter)
+            runScript(*iter);
+
+        for (auto iter = mScripts.begin(); iter != mScripts.end() && iter->first < start; ++iter)
+            runScript(*iter);
+    }
+
+    std::size_t GlobalScripts::getDeferredCount() const
+    {
+        return mDeferredCount;
     }
 
     void GlobalScripts::clear()
     {
         mScripts.clear();
+        mNextScript.clear();
+        mDeferredCount = 0;
     }
 
     void GlobalScripts::addStartup()
@@ -50,6 +50,8 @@ namespace MWScript
     {
             const MWWorld::ESMStore& mStore;
             std::map<std::string, std::shared_ptr<GlobalScriptDesc> > mScripts;
+            std::string mNextScript;
+            std::size_t mDeferredCount;
 
         public:
 
@@ -62,7 +64,11 @@ namespace MWScript
             bool isRunning (const std::string& name) const;
 
             void run();
-            ///< run all active global scripts
+            ///< run all active global scripts. When the script frame budget is exceeded, the remaining scripts are
+            /// deferred to the next frame. Any global script may be deferred, there is no priority between them.
+
+            std::size_t getDeferredCount() const;
+            ///< Number of scripts deferred by the last run
 
             void clear();
 
@@ -1,7 +1,9 @@
 #include "miscextensions.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iomanip>
+#include <sstream>
 
 #include <components/compiler/opcodes.hpp>
 #include <components/compiler/locals.hpp>
@@ -1580,6 +1582,58 @@ namespace MWScript
                 }
         };
 
+        class OpScriptProfile : public Interpreter::Opcode1
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime, unsigned int arg0) override
+                {
+                    Interpreter::Type_Integer count = 10;
+                    if (arg0==1)
+                    {
+                        count = runtime[0].mInteger;
+                        runtime.pop();
+                    }
+
+                    MWBase::ScriptManager& scriptManager = *MWBase::Environment::get().getScriptManager();
+
+                    if (count <= 0)
+                    {
+                        scriptManager.setProfiling (false);
+                        runtime.getContext().report ("Script Profiling -> Off");
+                        return;
+                    }
+
+                    if (!scriptManager.getProfiling())
+                    {
+                        scriptManager.setProfiling (true);
+                        runtime.getContext().report ("Script Profiling -> On");
+                        return;
+                    }
+
+                    std::size_t frames = 0;
+                    const std::vector<MWBase::ScriptManager::ScriptProfile> profile = scriptManager.getProfile (frames);
+
+                    std::ostringstream stream;
+                    stream << "Script profile for " << frames << " frames"
+                           << " (script: total ms, ms per frame, calls per frame, instructions per call):";
+
+                    const double frameCount = static_cast<double> (std::max<std::size_t> (frames, 1));
+                    stream << std::fixed << std::setprecision (3);
+
+                    for (std::size_t i = 0; i < profile.size() && i < static_cast<std::size_t> (count); ++i)
+                    {
+                        const MWBase::ScriptManager::ScriptProfile& script = profile[i];
+                        stream << "\n" << script.mName << ": " << script.mTime * 1000
+                               << ", " << script.mTime * 1000 / frameCount
+                               << ", " << script.mCalls / frameCount
+                               << ", " << script.mInstructions / static_cast<double> (script.mCalls);
+                    }
+
+                    runtime.getContext().report (stream.str());
+                }
+        };
+
         void installOpcodes (Interpreter::Interpreter& interpreter)
         {
             interpreter.installSegment5 (Compiler::Misc::opcodeMenuMode, new OpMenuMode);
@@ -1699,6 +1753,7 @@ namespace MWScript
             interpreter.installSegment5 (Compiler::Misc::opcodeRepairedOnMe, new OpRepairedOnMe<ImplicitRef>);
             interpreter.installSegment5 (Compiler::Misc::opcodeRepairedOnMeExplicit, new OpRepairedOnMe<ExplicitRef>);
             interpreter.installSegment5 (Compiler::Misc::opcodeToggleRecastMesh, new OpToggleRecastMesh);
+            interpreter.installSegment3 (Compiler::Misc::opcodeScriptProfile, new OpScriptProfile);
         }
     }
 }
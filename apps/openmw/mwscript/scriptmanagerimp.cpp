@@ -5,6 +5,8 @@
 #include <exception>
 #include <algorithm>
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm/loadscpt.hpp>
@@ -28,7 +30,8 @@ namespace MWScript
         const std::vector<std::string>& scriptBlacklist)
     : mErrorHandler(), mStore (store),
       mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
-      mOpcodesInstalled (false), mGlobalScripts (store)
+      mOpcodesInstalled (false), mGlobalScripts (store), mFrameBudget (0), mFrameCalls (0),
+      mFrameInstructions (0), mProfiling (false), mProfiledFrames (0)
     {
         mErrorHandler.setWarningsMode (warningsMode);
 
@@ -109,29 +112,58 @@ namespace MWScript
         }
 
         // execute script
-        if (!iter->second.mByteCode.empty() && iter->second.mActive)
-            try
-            {
-                if (!mOpcodesInstalled)
-                {
-                    installOpcodes (mInterpreter);
-                    mOpcodesInstalled = true;
-                }
+        if (iter->second.mByteCode.empty() || !iter->second.mActive)
+            return false;
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
-                return true;
-            }
-            catch (const MissingImplicitRefError& e)
+        bool success = false;
+        const std::uint64_t instructions = mInterpreter.getInstructionsCount();
+        const auto start = mProfiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+        try
+        {
+            if (!mOpcodesInstalled)
             {
-                Log(Debug::Error) << "Execution of script " << name << " failed: "  << e.what();
+                installOpcodes (mInterpreter);
+                mOpcodesInstalled = true;
             }
-            catch (const std::exception& e)
-            {
-                Log(Debug::Error) << "Execution of script " << name << " failed: "  << e.what();
 
-                iter->second.mActive = false; // don't execute again.
-            }
-        return false;
+            if (!iter->second.mProgram)
+                iter->second.mProgram = mInterpreter.decode (iter->second.mByteCode.data(), iter->second.mByteCode.size());
+
+            mInterpreter.run (*iter->second.mProgram, interpreterContext);
+            success = true;
+        }
+        catch (const MissingImplicitRefError& e)
+        {
+            Log(Debug::Error) << "Execution of script " << name << " failed: "  << e.what();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Execution of script " << name << " failed: "  << e.what();
+
+            iter->second.mActive = false; // don't execute again.
+        }
+
+        updateProfile (iter->second, instructions, start);
+
+        return success;
+    }
+
+    void ScriptManager::updateProfile (CompiledScript& script, std::uint64_t instructions,
+        std::chrono::steady_clock::time_point start)
+    {
+        // Instructions of scripts run from inside this script are included
+        const std::uint64_t executed = mInterpreter.getInstructionsCount() - instructions;
+
+        ++mFrameCalls;
+        mFrameInstructions += executed;
+
+        if (!mProfiling)
+            return;
+
+        ++script.mProfile.mCalls;
+        script.mProfile.mInstructions += executed;
+        script.mProfile.mTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     }
 
     void ScriptManager::clear()
@@ -206,4 +238,69 @@ namespace MWScript
     {
         return mGlobalScripts;
     }
+
+    void ScriptManager::startFrame()
+    {
+        mFrameStart = std::chrono::steady_clock::now();
+        mFrameCalls = 0;
+        mFrameInstructions = 0;
+
+        if (mProfiling)
+            ++mProfiledFrames;
+    }
+
+    void ScriptManager::setFrameBudget (double seconds)
+    {
+        mFrameBudget = seconds;
+    }
+
+    bool ScriptManager::isFrameBudgetExceeded() const
+    {
+        return mFrameBudget > 0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - mFrameStart).count() > mFrameBudget;
+    }
+
+    void ScriptManager::setProfiling (bool enabled)
+    {
+        if (enabled && !mProfiling)
+        {
+            for (auto& script : mScripts)
+                script.second.mProfile = ScriptProfile();
+            mProfiledFrames = 0;
+        }
+
+        mProfiling = enabled;
+    }
+
+    bool ScriptManager::getProfiling() const
+    {
+        return mProfiling;
+    }
+
+    std::vector<MWBase::ScriptManager::ScriptProfile> ScriptManager::getProfile (std::size_t& frames) const
+    {
+        std::vector<ScriptProfile> result;
+
+        for (const auto& script : mScripts)
+        {
+            if (script.second.mProfile.mCalls == 0)
+                continue;
+            result.push_back (script.second.mProfile);
+            result.back().mName = script.first;
+        }
+
+        std::sort (result.begin(), result.end(),
+            [] (const ScriptProfile& lhs, const ScriptProfile& rhs) { return lhs.mTime > rhs.mTime; });
+
+        frames = mProfiledFrames;
+
+        return result;
+    }
+
+    void ScriptManager::reportStats (unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute (frameNumber, "Script Calls", static_cast<double>(mFrameCalls));
+        stats.setAttribute (frameNumber, "Script Instructions", static_cast<double>(mFrameInstructions));
+        stats.setAttribute (frameNumber, "Script Deferred", mGlobalScripts.getDeferredCount());
+    }
 }
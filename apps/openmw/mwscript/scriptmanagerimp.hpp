@@ -1,7 +1,10 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 
 #include <components/compiler/streamerrorhandler.hpp>
@@ -44,8 +47,10 @@ namespace MWScript
             struct CompiledScript
             {
                 std::vector<Interpreter::Type_Code> mByteCode;
+                std::optional<Interpreter::Program> mProgram; // decoded on first run
                 Compiler::Locals mLocals;
                 bool mActive;
+                ScriptProfile mProfile;
 
                 CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
                 {
@@ -62,6 +67,16 @@ namespace MWScript
             std::map<std::string, Compiler::Locals> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
 
+            std::chrono::steady_clock::time_point mFrameStart;
+            double mFrameBudget;
+            std::uint64_t mFrameCalls;
+            std::uint64_t mFrameInstructions;
+            bool mProfiling;
+            std::size_t mProfiledFrames;
+
+            void updateProfile (CompiledScript& script, std::uint64_t instructions,
+                std::chrono::steady_clock::time_point start);
+
         public:
 
             ScriptManager (const MWWorld::ESMStore& store,
@@ -85,6 +100,26 @@ namespace MWScript
             ///< Return locals for script \a name.
 
             GlobalScripts& getGlobalScripts() override;
+
+            void startFrame() override;
+            ///< Start counting script time and per frame statistics for a new frame
+
+            void setFrameBudget (double seconds) override;
+            ///< Set time that may be spent on scripts per frame before global scripts are deferred.
+            /// 0 disables the limit.
+
+            bool isFrameBudgetExceeded() const override;
+
+            void setProfiling (bool enabled) override;
+            ///< Enabling profiling resets previously collected profile
+
+            bool getProfiling() const override;
+
+            std::vector<ScriptProfile> getProfile (std::size_t& frames) const override;
+            ///< Return per script profile sorted by total time descending
+            /// \param frames Set to number of frames profiled
+
+            void reportStats (unsigned int frameNumber, osg::Stats& stats) const override;
     };
 }
 
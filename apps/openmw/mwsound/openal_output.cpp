@@ -943,13 +943,9 @@ void OpenAL_Output::setHrtf(const std::string &hrtfname, HrtfMode hrtfmode)
 }
 
 
-std::pair<Sound_Handle,size_t> OpenAL_Output::loadSound(const std::string &fname)
+DecodedSound OpenAL_Output::decodeSound(const std::string &fname)
 {
-    getALError();
-
-    std::vector<char> data;
-    ALenum format = AL_NONE;
-    int srate = 0;
+    DecodedSound result;
 
     try
     {
@@ -966,29 +962,40 @@ std::pair<Sound_Handle,size_t> OpenAL_Output::loadSound(const std::string &fname
             decoder->open(file);
         }
 
-        ChannelConfig chans;
-        SampleType type;
-        decoder->getInfo(&srate, &chans, &type);
-        format = getALFormat(chans, type);
-        if(format) decoder->readAll(data);
+        decoder->getInfo(&result.mSampleRate, &result.mChannelConfig, &result.mSampleType);
+        decoder->readAll(result.mData);
     }
     catch(std::exception &e)
     {
         Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+        result.mData.clear();
     }
 
-    if(data.empty())
+    return result;
+}
+
+std::pair<Sound_Handle,size_t> OpenAL_Output::loadSound(const DecodedSound &sound)
+{
+    getALError();
+
+    const std::vector<char> *data = &sound.mData;
+    ALenum format = data->empty() ? AL_NONE : getALFormat(sound.mChannelConfig, sound.mSampleType);
+    int srate = sound.mSampleRate;
+
+    std::vector<char> silence;
+    if(!format)
     {
         // If we failed to get any usable audio, substitute with silence.
         format = AL_FORMAT_MONO8;
         srate = 8000;
-        data.assign(8000, -128);
+        silence.assign(8000, -128);
+        data = &silence;
     }
 
     ALint size;
     ALuint buf = 0;
     alGenBuffers(1, &buf);
-    alBufferData(buf, format, data.data(), data.size(), srate);
+    alBufferData(buf, format, data->data(), data->size(), srate);
     alGetBufferi(buf, AL_SIZE, &size);
     if(getALError() != AL_NO_ERROR)
     {
@@ -66,7 +66,8 @@ namespace MWSound
         std::vector<std::string> enumerateHrtf() override;
         void setHrtf(const std::string &hrtfname, HrtfMode hrtfmode) override;
 
-        std::pair<Sound_Handle,size_t> loadSound(const std::string &fname) override;
+        DecodedSound decodeSound(const std::string &fname) override;
+        std::pair<Sound_Handle,size_t> loadSound(const DecodedSound &sound) override;
         size_t unloadSound(Sound_Handle data) override;
 
         bool playSound(Sound *sound, Sound_Handle data, float offset) override;
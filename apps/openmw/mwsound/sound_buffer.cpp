@@ -5,6 +5,7 @@
 #include "../mwworld/esmstore.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -35,9 +36,30 @@ namespace MWSound
         }
     }
 
-    SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output) :
+    class SoundBufferPool::DecodeItem : public SceneUtil::WorkItem
+    {
+        public:
+            DecodeItem(Sound_Output& output, const std::string& resourceName)
+                : mOutput(output), mResourceName(resourceName)
+            {}
+
+            void doWork() override
+            {
+                mResult = mOutput.decodeSound(mResourceName);
+            }
+
+            const DecodedSound& getResult() const { return mResult; }
+
+        private:
+            Sound_Output& mOutput;
+            const std::string mResourceName;
+            DecodedSound mResult;
+    };
+
+    SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output, SceneUtil::WorkQueue& workQueue) :
         mVfs(&vfs),
         mOutput(&output),
+        mWorkQueue(&workQueue),
         mBufferCacheMax(std::max(Settings::Manager::getInt("buffer cache max", "Sound"), 1) * 1024 * 1024),
         mBufferCacheMin(std::min(static_cast<std::size_t>(std::max(Settings::Manager::getInt("buffer cache min", "Sound"), 1)) * 1024 * 1024, mBufferCacheMax))
     {
@@ -54,13 +76,13 @@ namespace MWSound
         if (it != mBufferNameMap.end())
         {
             Sound_Buffer* sfx = it->second;
-            if (sfx->getHandle() != nullptr)
+            if (sfx->getHandle() != nullptr || sfx->isLoading())
                 return sfx;
         }
         return nullptr;
     }
 
-    Sound_Buffer* SoundBufferPool::load(const std::string& soundId)
+    Sound_Buffer* SoundBufferPool::find(const std::string& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -80,29 +102,49 @@ namespace MWSound
             sfx = insertSound(soundId, *sound);
         }
 
-        if (sfx->getHandle() == nullptr)
+        return sfx;
+    }
+
+    Sound_Buffer* SoundBufferPool::request(const std::string& soundId, bool preload)
+    {
+        Sound_Buffer* const sfx = find(soundId);
+        if (sfx == nullptr)
+            return nullptr;
+
+        if (sfx->getHandle() == nullptr && !sfx->isLoading())
         {
-            auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
-            if (handle == nullptr)
-                return {};
+            osg::ref_ptr<DecodeItem> item(new DecodeItem(*mOutput, sfx->getResourceName()));
+            mWorkQueue->addWorkItem(item, preload ? SceneUtil::WorkPriority::Low : SceneUtil::WorkPriority::Normal);
+            mDecodeItems.emplace(sfx, std::move(item));
+            sfx->mLoading = true;
+        }
 
-            sfx->mHandle = handle;
+        return sfx;
+    }
 
-            mBufferCacheSize += size;
-            if (mBufferCacheSize > mBufferCacheMax)
+    void SoundBufferPool::update()
+    {
+        for (auto it = mDecodeItems.begin(); it != mDecodeItems.end();)
+        {
+            if (!it->second->isDone())
             {
-                unloadUnused();
-                if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
-                    Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+                ++it;
+                continue;
             }
-            mUnusedBuffers.push_front(sfx);
+            finishLoading(*it->first, it->second->getResult());
+            it = mDecodeItems.erase(it);
         }
-
-        return sfx;
     }
 
     void SoundBufferPool::clear()
     {
+        for (auto& [sfx, item] : mDecodeItems)
+        {
+            item->waitTillDone();
+            sfx->mLoading = false;
+        }
+        mDecodeItems.clear();
+
         for (auto &sfx : mSoundBuffers)
         {
             if(sfx.mHandle)
@@ -137,6 +179,27 @@ namespace MWSound
         return &sfx;
     }
 
+    void SoundBufferPool::finishLoading(Sound_Buffer& sfx, const DecodedSound& sound)
+    {
+        sfx.mLoading = false;
+
+        auto [handle, size] = mOutput->loadSound(sound);
+        if (handle == nullptr)
+            return;
+
+        sfx.mHandle = handle;
+
+        mBufferCacheSize += size;
+        if (mBufferCacheSize > mBufferCacheMax)
+        {
+            unloadUnused();
+            if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
+                Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+        }
+        if (sfx.mUses == 0)
+            mUnusedBuffers.push_front(&sfx);
+    }
+
     void SoundBufferPool::unloadUnused()
     {
         while (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMin)
@@ -6,6 +6,8 @@
 #include <deque>
 #include <unordered_map>
 
+#include <osg/ref_ptr>
+
 #include "sound_output.hpp"
 
 namespace ESM
@@ -18,6 +20,11 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWSound
 {
     class SoundBufferPool;
@@ -40,6 +47,9 @@ namespace MWSound
 
             float getMaxDist() const noexcept { return mMaxDist; }
 
+            /// Sound data is being decoded in background, the handle is not available yet.
+            bool isLoading() const noexcept { return mLoading; }
+
         private:
             std::string mResourceName;
             float mVolume;
@@ -47,6 +57,7 @@ namespace MWSound
             float mMaxDist;
             Sound_Handle mHandle = nullptr;
             std::size_t mUses = 0;
+            bool mLoading = false;
 
             friend class SoundBufferPool;
     };
@@ -54,19 +65,25 @@ namespace MWSound
     class SoundBufferPool
     {
         public:
-            SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output);
+            /// @param workQueue shared with other background work, sounds are decoded there
+            SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output, SceneUtil::WorkQueue& workQueue);
 
             SoundBufferPool(const SoundBufferPool&) = delete;
 
             ~SoundBufferPool();
 
             /// Lookup a soundId for its sound data (resource name, local volume,
-            /// minRange, and maxRange)
+            /// minRange, and maxRange). Returns only loaded or loading sounds.
             Sound_Buffer* lookup(const std::string& soundId) const;
 
             /// Lookup a soundId for its sound data (resource name, local volume,
-            /// minRange, and maxRange), and ensure it's ready for use.
-            Sound_Buffer* load(const std::string& soundId);
+            /// minRange, and maxRange), and start decoding it in background if it's not loaded.
+            /// The handle is available after one of the following update calls unless isLoading() is true.
+            /// @param preload decode with low priority, the sound isn't going to be played yet
+            Sound_Buffer* request(const std::string& soundId, bool preload = false);
+
+            /// Load buffers of sounds decoded in background.
+            void update();
 
             void use(Sound_Buffer& sfx)
             {
@@ -80,15 +97,19 @@ namespace MWSound
 
             void release(Sound_Buffer& sfx)
             {
-                if (--sfx.mUses == 0)
+                if (--sfx.mUses == 0 && sfx.mHandle != nullptr)
                     mUnusedBuffers.push_front(&sfx);
             }
 
             void clear();
 
         private:
+            class DecodeItem;
+
             const VFS::Manager* const mVfs;
             Sound_Output* mOutput;
+            osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+            std::unordered_map<Sound_Buffer*, osg::ref_ptr<DecodeItem>> mDecodeItems;
             std::deque<Sound_Buffer> mSoundBuffers;
             std::unordered_map<std::string, Sound_Buffer*> mBufferNameMap;
             std::size_t mBufferCacheMax;
@@ -99,6 +120,10 @@ namespace MWSound
 
             inline Sound_Buffer* insertSound(const std::string& soundId, const ESM::Sound& sound);
 
+            inline Sound_Buffer* find(const std::string& soundId);
+
+            inline void finishLoading(Sound_Buffer& sfx, const DecodedSound& sound);
+
             inline void unloadUnused();
     };
 }
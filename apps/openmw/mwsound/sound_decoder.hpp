@@ -30,6 +30,15 @@ namespace MWSound
     size_t framesToBytes(size_t frames, ChannelConfig config, SampleType type);
     size_t bytesToFrames(size_t bytes, ChannelConfig config, SampleType type);
 
+    // Whole sound decoded into memory. Empty data means decoding failed.
+    struct DecodedSound
+    {
+        std::vector<char> mData;
+        int mSampleRate = 0;
+        ChannelConfig mChannelConfig = ChannelConfig_Mono;
+        SampleType mSampleType = SampleType_UInt8;
+    };
+
     struct Sound_Decoder
     {
         const VFS::Manager* mResourceMgr;
@@ -52,11 +52,11 @@ namespace MWSound
     // For combining PlayMode and Type flags
     inline int operator|(PlayMode a, Type b) { return static_cast<int>(a) | static_cast<int>(b); }
 
-    SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound)
+    SoundManager::SoundManager(const VFS::Manager* vfs, SceneUtil::WorkQueue* workQueue, bool useSound)
         : mVFS(vfs)
         , mOutput(new DEFAULT_OUTPUT(*this))
         , mWaterSoundUpdater(makeWaterSoundUpdaterSettings())
-        , mSoundBuffers(*vfs, *mOutput)
+        , mSoundBuffers(*vfs, *mOutput, *workQueue)
         , mListenerUnderwater(false)
         , mListenerPos(0,0,0)
         , mListenerDir(1,0,0)
@@ -495,7 +495,7 @@ namespace MWSound
         if(!mOutput->isInitialized())
             return nullptr;
 
-        Sound_Buffer *sfx = mSoundBuffers.load(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId));
         if(!sfx) return nullptr;
 
         // Only one copy of given sound can be played at time, so stop previous copy
@@ -510,13 +510,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_2D;
             return params;
         } ());
-        if(!mOutput->playSound(sound.get(), sfx->getHandle(), offset))
-            return nullptr;
-
-        Sound* result = sound.get();
-        mActiveSounds[MWWorld::ConstPtr()].emplace_back(std::move(sound), sfx);
-        mSoundBuffers.use(*sfx);
-        return result;
+        return startSound(std::move(sound), sfx, MWWorld::ConstPtr(), offset);
     }
 
     Sound *SoundManager::playSound3D(const MWWorld::ConstPtr &ptr, const std::string& soundId,
@@ -531,13 +525,12 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound in the ESM data
-        Sound_Buffer *sfx = mSoundBuffers.load(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId));
         if(!sfx) return nullptr;
 
         // Only one copy of given sound can be played at time on ptr, so stop previous copy
         stopSound(sfx, ptr);
 
-        bool played;
         SoundPtr sound = getSoundRef();
         if(!(mode&PlayMode::NoPlayerLocal) && ptr == MWMechanics::getPlayer())
         {
@@ -549,7 +542,6 @@ namespace MWSound
                 params.mFlags = mode | type | Play_2D;
                 return params;
             } ());
-            played = mOutput->playSound(sound.get(), sfx->getHandle(), offset);
         }
         else
         {
@@ -564,15 +556,8 @@ namespace MWSound
                 params.mFlags = mode | type | Play_3D;
                 return params;
             } ());
-            played = mOutput->playSound3D(sound.get(), sfx->getHandle(), offset);
         }
-        if(!played)
-            return nullptr;
-
-        Sound* result = sound.get();
-        mActiveSounds[ptr].emplace_back(std::move(sound), sfx);
-        mSoundBuffers.use(*sfx);
-        return result;
+        return startSound(std::move(sound), sfx, ptr, offset);
     }
 
     Sound *SoundManager::playSound3D(const osg::Vec3f& initialPos, const std::string& soundId,
@@ -583,7 +568,7 @@ namespace MWSound
             return nullptr;
 
         // Look up the sound in the ESM data
-        Sound_Buffer *sfx = mSoundBuffers.load(Misc::StringUtils::lowerCase(soundId));
+        Sound_Buffer *sfx = mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId));
         if(!sfx) return nullptr;
 
         SoundPtr sound = getSoundRef();
@@ -598,23 +583,107 @@ namespace MWSound
             params.mFlags = mode | type | Play_3D;
             return params;
         } ());
-        if(!mOutput->playSound3D(sound.get(), sfx->getHandle(), offset))
-            return nullptr;
+        return startSound(std::move(sound), sfx, MWWorld::ConstPtr(), offset);
+    }
 
+    Sound* SoundManager::startSound(SoundPtr sound, Sound_Buffer* sfx, const MWWorld::ConstPtr& ptr, float offset)
+    {
         Sound* result = sound.get();
-        mActiveSounds[MWWorld::ConstPtr()].emplace_back(std::move(sound), sfx);
+        if(sfx->getHandle() == nullptr)
+        {
+            if(!sfx->isLoading())
+                return nullptr;
+            mPendingSounds.push_back(PendingSound {ptr, std::move(sound), sfx, offset});
+            mSoundBuffers.use(*sfx);
+            return result;
+        }
+
+        const bool played = sound->getIs3D()
+            ? mOutput->playSound3D(sound.get(), sfx->getHandle(), offset)
+            : mOutput->playSound(sound.get(), sfx->getHandle(), offset);
+        if(!played)
+            return nullptr;
+
+        mActiveSounds[ptr].emplace_back(std::move(sound), sfx);
         mSoundBuffers.use(*sfx);
         return result;
     }
 
+    bool SoundManager::isSoundPending(const Sound* sound) const
+    {
+        return std::any_of(mPendingSounds.begin(), mPendingSounds.end(),
+                           [&] (const PendingSound& v) { return v.mSound.get() == sound; });
+    }
+
+    template <class Function>
+    void SoundManager::stopPendingSounds(Function&& filter)
+    {
+        const auto it = std::stable_partition(mPendingSounds.begin(), mPendingSounds.end(),
+                                              [&] (const PendingSound& v) { return !filter(v); });
+        for(auto pending = it; pending != mPendingSounds.end(); ++pending)
+        {
+            if(pending->mSound.get() == mUnderwaterSound)
+                mUnderwaterSound = nullptr;
+            if(pending->mSound.get() == mNearWaterSound)
+                mNearWaterSound = nullptr;
+            mSoundBuffers.release(*pending->mBuffer);
+        }
+        mPendingSounds.erase(it, mPendingSounds.end());
+    }
+
+    void SoundManager::updatePendingSounds()
+    {
+        mSoundBuffers.update();
+
+        auto pending = mPendingSounds.begin();
+        while(pending != mPendingSounds.end())
+        {
+            Sound_Buffer* const sfx = pending->mBuffer;
+            if(sfx->isLoading())
+            {
+                ++pending;
+                continue;
+            }
+
+            Sound* const sound = pending->mSound.get();
+            bool played = false;
+            if(sfx->getHandle() != nullptr)
+            {
+                if(!pending->mPtr.isEmpty() && sound->getIs3D())
+                    sound->setPosition(pending->mPtr.getRefData().getPosition().asVec3());
+                played = sound->getIs3D()
+                    ? mOutput->playSound3D(sound, sfx->getHandle(), pending->mOffset)
+                    : mOutput->playSound(sound, sfx->getHandle(), pending->mOffset);
+            }
+
+            if(played)
+            {
+                // The buffer use is moved from the pending to the active sound
+                mActiveSounds[pending->mPtr].emplace_back(std::move(pending->mSound), sfx);
+            }
+            else
+            {
+                if(sound == mUnderwaterSound)
+                    mUnderwaterSound = nullptr;
+                if(sound == mNearWaterSound)
+                    mNearWaterSound = nullptr;
+                mSoundBuffers.release(*sfx);
+            }
+            pending = mPendingSounds.erase(pending);
+        }
+    }
+
     void SoundManager::stopSound(Sound *sound)
     {
-        if(sound)
-            mOutput->finishSound(sound);
+        if(!sound)
+            return;
+        mOutput->finishSound(sound);
+        stopPendingSounds([&] (const PendingSound& v) { return v.mSound.get() == sound; });
     }
 
     void SoundManager::stopSound(Sound_Buffer *sfx, const MWWorld::ConstPtr &ptr)
     {
+        stopPendingSounds([&] (const PendingSound& v) { return v.mBuffer == sfx && v.mPtr == ptr; });
         SoundMap::iterator snditer = mActiveSounds.find(ptr);
         if(snditer != mActiveSounds.end())
         {
@@ -639,6 +708,7 @@ namespace MWSound
 
     void SoundManager::stopSound3D(const MWWorld::ConstPtr &ptr)
     {
+        stopPendingSounds([&] (const PendingSound& v) { return v.mPtr == ptr; });
         SoundMap::iterator snditer = mActiveSounds.find(ptr);
         if(snditer != mActiveSounds.end())
         {
@@ -655,6 +725,10 @@ namespace MWSound
 
     void SoundManager::stopSound(const MWWorld::CellStore *cell)
     {
+        stopPendingSounds([&] (const PendingSound& v)
+        {
+            return !v.mPtr.isEmpty() && v.mPtr != MWMechanics::getPlayer() && v.mPtr.getCell() == cell;
+        });
         for(SoundMap::value_type &snd : mActiveSounds)
         {
             if(!snd.first.isEmpty() && snd.first != MWMechanics::getPlayer() && snd.first.getCell() == cell)
@@ -680,12 +754,17 @@ namespace MWSound
     void SoundManager::fadeOutSound3D(const MWWorld::ConstPtr &ptr,
             const std::string& soundId, float duration)
     {
+        Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
+        if (sfx == nullptr)
+            return;
+        for(PendingSound &pending : mPendingSounds)
+        {
+            if(pending.mPtr == ptr && pending.mBuffer == sfx)
+                pending.mSound->setFadeout(duration);
+        }
         SoundMap::iterator snditer = mActiveSounds.find(ptr);
         if(snditer != mActiveSounds.end())
         {
-            Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
-            if (sfx == nullptr)
-                return;
             for(SoundBufferRefPair &sndbuf : snditer->second)
             {
                 if(sndbuf.second == sfx)
@@ -696,10 +775,15 @@ namespace MWSound
 
     bool SoundManager::getSoundPlaying(const MWWorld::ConstPtr &ptr, const std::string& soundId) const
     {
+        Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
+        if (sfx == nullptr)
+            return false;
+        if(std::any_of(mPendingSounds.begin(), mPendingSounds.end(),
+                       [&] (const PendingSound& v) { return v.mPtr == ptr && v.mBuffer == sfx; }))
+            return true;
         SoundMap::const_iterator snditer = mActiveSounds.find(ptr);
         if(snditer != mActiveSounds.end())
         {
-            Sound_Buffer *sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
             return std::find_if(snditer->second.cbegin(), snditer->second.cend(),
                 [this,sfx](const SoundBufferRefPair &snd) -> bool
                 { return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get()); }
@@ -708,6 +792,13 @@ namespace MWSound
         return false;
     }
 
+    void SoundManager::preloadSound(const std::string& soundId)
+    {
+        if(!mOutput->isInitialized())
+            return;
+        mSoundBuffers.request(Misc::StringUtils::lowerCase(soundId), true);
+    }
+
     void SoundManager::pauseSounds(BlockerType blocker, int types)
     {
         if(mOutput->isInitialized())
@@ -763,7 +854,7 @@ namespace MWSound
 
         if (!cell->isExterior())
             return;
-        if (mCurrentRegionSound && mOutput->isSoundPlaying(mCurrentRegionSound))
+        if (mCurrentRegionSound && (mOutput->isSoundPlaying(mCurrentRegionSound) || isSoundPending(mCurrentRegionSound)))
             return;
 
         if (const auto next = mRegionSoundSelector.getNextRandom(duration, cell->mRegion, *world))
@@ -789,12 +880,12 @@ namespace MWSound
                 mNearWaterSound->setVolume(update.mVolume * sfx->getVolume());
                 break;
             case WaterSoundAction::FinishSound:
-                mOutput->finishSound(mNearWaterSound);
+                stopSound(mNearWaterSound);
                 mNearWaterSound = nullptr;
                 break;
             case WaterSoundAction::PlaySound:
                 if (mNearWaterSound)
-                    mOutput->finishSound(mNearWaterSound);
+                    stopSound(mNearWaterSound);
                 mNearWaterSound = playSound(update.mId, update.mVolume, 1.0f, Type::Sfx, PlayMode::Loop);
                 break;
         }
@@ -855,6 +946,8 @@ namespace MWSound
             mSaySoundsQueue.erase(queuesayiter++);
         }
 
+        updatePendingSounds();
+
         mTimePassed += duration;
         if (mTimePassed < sMinUpdateInterval)
             return;
@@ -870,7 +963,7 @@ namespace MWSound
             env = Env_Underwater;
         else if(mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            stopSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -1039,6 +1132,8 @@ namespace MWSound
                 mOutput->updateSound(sound);
             }
         }
+        for(PendingSound &pending : mPendingSounds)
+            pending.mSound->setBaseVolume(volumeFromType(pending.mSound->getPlayType()));
         for(SaySoundMap::value_type &snd : mActiveSaySounds)
         {
             Stream *sound = snd.second.get();
@@ -1085,6 +1180,12 @@ namespace MWSound
             mActiveSounds.emplace(updated, std::move(sndlist));
         }
 
+        for(PendingSound &pending : mPendingSounds)
+        {
+            if(pending.mPtr == old)
+                pending.mPtr = updated;
+        }
+
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(old);
         if(sayiter != mSaySoundsQueue.end())
         {
@@ -1180,6 +1281,9 @@ namespace MWSound
             }
         }
         mActiveSounds.clear();
+        for(PendingSound &pending : mPendingSounds)
+            mSoundBuffers.release(*pending.mBuffer);
+        mPendingSounds.clear();
         mUnderwaterSound = nullptr;
         mNearWaterSound = nullptr;
 
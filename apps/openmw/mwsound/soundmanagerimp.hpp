@@ -66,6 +66,16 @@ namespace MWSound
         typedef std::map<MWWorld::ConstPtr,SoundBufferRefPairList> SoundMap;
         SoundMap mActiveSounds;
 
+        // Sounds waiting for their buffers to be decoded in background
+        struct PendingSound
+        {
+            MWWorld::ConstPtr mPtr;
+            SoundPtr mSound;
+            Sound_Buffer* mBuffer;
+            float mOffset;
+        };
+        std::vector<PendingSound> mPendingSounds;
+
         typedef std::map<MWWorld::ConstPtr, StreamPtr> SaySoundMap;
         SaySoundMap mSaySoundsQueue;
         SaySoundMap mActiveSaySounds;
@@ -107,6 +117,16 @@ namespace MWSound
 
         StreamPtr playVoice(DecoderPtr decoder, const osg::Vec3f &pos, bool playlocal);
 
+        // Plays the sound or defers it until the buffer is loaded. Returns nullptr if the sound can't be played.
+        Sound* startSound(SoundPtr sound, Sound_Buffer* sfx, const MWWorld::ConstPtr& ptr, float offset);
+
+        bool isSoundPending(const Sound* sound) const;
+
+        template <class Function>
+        void stopPendingSounds(Function&& filter);
+
+        void updatePendingSounds();
+
         void streamMusicFull(const std::string& filename);
         void advanceMusic(const std::string& filename);
         void startRandomTitle();
@@ -140,7 +160,7 @@ namespace MWSound
         ///< Stop the given object from playing given sound buffer.
 
     public:
-        SoundManager(const VFS::Manager* vfs, bool useSound);
+        SoundManager(const VFS::Manager* vfs, SceneUtil::WorkQueue* workQueue, bool useSound);
         virtual ~SoundManager();
 
         void processChangedSettings(const Settings::CategorySettingVector& settings) override;
@@ -232,6 +252,9 @@ namespace MWSound
         bool getSoundPlaying(const MWWorld::ConstPtr &reference, const std::string& soundId) const override;
         ///< Is the given sound currently playing on the given object?
 
+        void preloadSound(const std::string& soundId) override;
+        ///< Start decoding the given sound in background to have it ready when it's played.
+
         void pauseSounds(MWSound::BlockerType blocker, int types=int(Type::Mask)) override;
         ///< Pauses all currently playing sounds, including music.
 
@@ -1,5 +1,6 @@
 #include "character.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <sstream>
 
@@ -55,9 +56,14 @@ void MWState::Character::addSlot (const ESM::SavedGame& profile)
     const std::string ext = ".omwsave";
     slot.mPath = mPath / (stream.str() + ext);
 
-    // Append an index if necessary to ensure a unique file
+    // Append an index if necessary to ensure a unique file. Files of new slots may be not written yet.
+    const auto isUsed = [this] (const boost::filesystem::path& path)
+    {
+        return boost::filesystem::exists(path)
+            || std::any_of(mSlots.begin(), mSlots.end(), [&] (const Slot& other) { return other.mPath == path; });
+    };
     int i=0;
-    while (boost::filesystem::exists(slot.mPath))
+    while (isUsed(slot.mPath))
     {
         const std::string test = stream.str() + " - " + std::to_string(++i);
         slot.mPath = mPath / (test + ext);
@@ -83,6 +89,14 @@ MWState::Character::Character (const boost::filesystem::path& saves, const std::
         {
             boost::filesystem::path slotPath = *iter;
 
+            // Left by a save interrupted before the rename, the complete save file wasn't written
+            if (slotPath.extension() == ".tmp")
+            {
+                boost::system::error_code ec;
+                boost::filesystem::remove (slotPath, ec);
+                continue;
+            }
+
             try
             {
                 addSlot (slotPath, game);
@@ -0,0 +1,127 @@
+#include "savefilewriter.hpp"
+
+#include <stdexcept>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/compressedrecords.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+void MWState::writeSaveFile (const boost::filesystem::path& path, const std::string& data)
+{
+    const boost::filesystem::path temporaryPath = path.string() + ".tmp";
+
+    {
+        boost::filesystem::ofstream filestream (temporaryPath, std::ios::binary);
+        filestream.write (data.data(), static_cast<std::streamsize> (data.size()));
+        filestream.close();
+
+        if (filestream.fail())
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove (temporaryPath, ec);
+            throw std::runtime_error ("Write operation failed (file stream)");
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename (temporaryPath, path, ec);
+
+    if (ec)
+    {
+        boost::system::error_code removeEc;
+        boost::filesystem::remove (temporaryPath, removeEc);
+        throw std::runtime_error ("Write operation failed (rename): " + ec.message());
+    }
+}
+
+class MWState::SaveFileWriter::WriteItem : public SceneUtil::WorkItem
+{
+    public:
+
+        WriteItem (const boost::filesystem::path& path, std::string&& data, std::size_t compressedRecordsOffset)
+        : mCompressedRecordsOffset (compressedRecordsOffset)
+        {
+            mResult.mPath = path;
+            mData = std::move (data);
+        }
+
+        void doWork() override
+        {
+            try
+            {
+                ESM::compressRecords (mData, mCompressedRecordsOffset);
+                writeSaveFile (mResult.mPath, mData);
+            }
+            catch (const std::exception& e)
+            {
+                mResult.mError = e.what();
+            }
+
+            mData = std::string();
+        }
+
+        const Result& getResult() const
+        {
+            return mResult;
+        }
+
+    private:
+
+        std::string mData;
+        std::size_t mCompressedRecordsOffset;
+        Result mResult;
+};
+
+MWState::SaveFileWriter::SaveFileWriter (SceneUtil::WorkQueue& workQueue)
+: mWorkQueue (&workQueue)
+{}
+
+MWState::SaveFileWriter::~SaveFileWriter()
+{
+    // Items still queued are written before the shared queue is destroyed
+    wait();
+
+    // Nobody is left to show failures to the player
+    for (const Result& result : takeResults())
+        if (!result.mError.empty())
+            Log(Debug::Error) << "Failed to save game to " << result.mPath.string() << ": " << result.mError;
+}
+
+void MWState::SaveFileWriter::write (const boost::filesystem::path& path, std::string&& data,
+    std::size_t compressedRecordsOffset)
+{
+    osg::ref_ptr<WriteItem> item (new WriteItem (path, std::move (data), compressedRecordsOffset));
+    // The queue may run items in parallel, a later save to the same file must not be written first
+    if (!mItems.empty())
+        item->addDependency (mItems.back());
+    mItems.push_back (item);
+    mWorkQueue->addWorkItem (item, SceneUtil::WorkPriority::Low);
+}
+
+bool MWState::SaveFileWriter::isWriting() const
+{
+    for (const osg::ref_ptr<WriteItem>& item : mItems)
+        if (!item->isDone())
+            return true;
+    return false;
+}
+
+void MWState::SaveFileWriter::wait()
+{
+    for (const osg::ref_ptr<WriteItem>& item : mItems)
+        item->waitTillDone();
+}
+
+std::vector<MWState::SaveFileWriter::Result> MWState::SaveFileWriter::takeResults()
+{
+    std::vector<Result> results;
+    while (!mItems.empty() && mItems.front()->isDone())
+    {
+        results.push_back (mItems.front()->getResult());
+        mItems.pop_front();
+    }
+    return results;
+}
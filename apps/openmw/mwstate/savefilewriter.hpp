@@ -0,0 +1,63 @@
+#ifndef GAME_STATE_SAVEFILEWRITER_H
+#define GAME_STATE_SAVEFILEWRITER_H
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include <osg/ref_ptr>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace MWState
+{
+    ///< Write \a data to a temporary file next to \a path and replace the file at \a path with it, so a failed write
+    /// doesn't destroy the existing file.
+    /// \throw std::runtime_error on failure
+    void writeSaveFile (const boost::filesystem::path& path, const std::string& data);
+
+    class SaveFileWriter
+    {
+        public:
+
+            struct Result
+            {
+                boost::filesystem::path mPath;
+                std::string mError;
+                ///< Empty if the file is written
+            };
+
+        private:
+
+            class WriteItem;
+
+            osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+            std::deque<osg::ref_ptr<WriteItem>> mItems;
+
+        public:
+
+            explicit SaveFileWriter (SceneUtil::WorkQueue& workQueue);
+            ///< Files are written by \a workQueue with low priority, one after another in the order they were queued.
+
+            ~SaveFileWriter();
+            ///< Waits for all queued files to be written and logs results which are not taken yet.
+
+            void write (const boost::filesystem::path& path, std::string&& data, std::size_t compressedRecordsOffset);
+            ///< Records after \a compressedRecordsOffset are compressed before writing, see ESM::compressRecords.
+
+            bool isWriting() const;
+
+            void wait();
+            ///< Block until all queued files are written.
+
+            std::vector<Result> takeResults();
+            ///< Results of finished writes in the order they were queued. Doesn't block.
+    };
+}
+
+#endif
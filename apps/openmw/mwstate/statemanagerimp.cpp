@@ -2,6 +2,7 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <components/esm/compressedrecords.hpp>
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/esmreader.hpp>
 #include <components/esm/cellid.hpp>
@@ -39,6 +40,7 @@
 #include "../mwscript/globalscripts.hpp"
 
 #include "quicksavemanager.hpp"
+#include "savefilewriter.hpp"
 
 void MWState::StateManager::cleanup (bool force)
 {
@@ -86,8 +88,10 @@ std::map<int, int> MWState::StateManager::buildContentFileIndexMap (const ESM::E
     return map;
 }
 
-MWState::StateManager::StateManager (const boost::filesystem::path& saves, const std::string& game)
-: mQuitRequest (false), mAskLoadRecent(false), mState (State_NoGame), mCharacterManager (saves, game), mTimePlayed (0)
+MWState::StateManager::StateManager (const boost::filesystem::path& saves, const std::string& game,
+    SceneUtil::WorkQueue& workQueue)
+: mQuitRequest (false), mAskLoadRecent(false), mState (State_NoGame), mCharacterManager (saves, game), mTimePlayed (0),
+  mSaveFileWriter (workQueue)
 {
 
 }
@@ -271,6 +275,10 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         slot->mProfile.save (writer);
         writer.endRecord (ESM::REC_SAVE);
 
+        // The header and the profile stay uncompressed, so saved games can be listed quickly
+        const std::size_t compressedRecordsOffset = Settings::Manager::getBool("compress", "Saves")
+            ? static_cast<std::size_t>(stream.tellp()) : std::string::npos;
+
         MWBase::Environment::get().getJournal()->write (writer, listener);
         MWBase::Environment::get().getDialogueManager()->write (writer, listener);
         MWBase::Environment::get().getWorld()->write (writer, listener);
@@ -288,26 +296,24 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         if (stream.fail())
             throw std::runtime_error("Write operation failed (memory stream)");
 
-        // All good, write to file
-        boost::filesystem::ofstream filestream (slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
+        // Writing a large file may take a while, leave it to the background thread
+        if (Settings::Manager::getBool("write in background", "Saves"))
+        {
+            mSaveFileWriter.write(slot->mPath, stream.str(), compressedRecordsOffset);
+            return;
+        }
 
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
+        // All good, write to file
+        std::string data = stream.str();
+        ESM::compressRecords(data, compressedRecordsOffset);
+        writeSaveFile(slot->mPath, data);
 
         Settings::Manager::setString ("character", "Saves",
             slot->mPath.parent_path().filename().string());
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
-
-        Log(Debug::Error) << error.str();
-
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{sOk}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+        reportSaveFailure(e.what());
 
         // If no file was written, clean up the slot
         if (character && slot && !boost::filesystem::exists(slot->mPath))
@@ -318,6 +324,48 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
     }
 }
 
+void MWState::StateManager::reportSaveFailure (const std::string& error) const
+{
+    std::stringstream message;
+    message << "Failed to save game: " << error;
+
+    Log(Debug::Error) << message.str();
+
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{sOk}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(message.str(), buttons);
+}
+
+void MWState::StateManager::handleSaveFileResults()
+{
+    for (const SaveFileWriter::Result& result : mSaveFileWriter.takeResults())
+    {
+        if (result.mError.empty())
+        {
+            Log(Debug::Info) << "Written saved game " << result.mPath.string();
+            Settings::Manager::setString ("character", "Saves", result.mPath.parent_path().filename().string());
+            continue;
+        }
+
+        reportSaveFailure(result.mError);
+
+        if (boost::filesystem::exists(result.mPath))
+            continue;
+
+        // The slot may be deleted or belong to another character than the current one by now
+        for (const Character& character : mCharacterManager)
+        {
+            const auto slot = std::find_if(character.begin(), character.end(),
+                [&] (const Slot& candidate) { return candidate.mPath == result.mPath; });
+            if (slot != character.end())
+            {
+                mCharacterManager.deleteSlot(&character, &*slot);
+                break;
+            }
+        }
+    }
+}
+
 void MWState::StateManager::quickSave (std::string name)
 {
     if (!(mState==State_Running &&
@@ -370,6 +418,9 @@ void MWState::StateManager::loadGame(const std::string& filepath)
 
 void MWState::StateManager::loadGame (const Character *character, const std::string& filepath)
 {
+    // The file may be still being written, failures are reported by the next update
+    mSaveFileWriter.wait();
+
     try
     {
         cleanup();
@@ -394,7 +445,6 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
 
         bool firstPersonCam = false;
 
-        size_t total = reader.getFileSize();
         int currentPercent = 0;
         while (reader.hasMoreRecs())
         {
@@ -488,7 +538,8 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
                     Log(Debug::Warning) << "Warning: Ignoring unknown record: " << n.toString();
                     reader.skipRecord();
             }
-            int progressPercent = static_cast<int>(float(reader.getFileOffset())/total*100);
+            // File size changes when compressed records are reached
+            int progressPercent = static_cast<int>(float(reader.getFileOffset())/reader.getFileSize()*100);
             if (progressPercent > currentPercent)
             {
                 listener.increaseProgress(progressPercent-currentPercent);
@@ -575,6 +626,8 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character *character, const MWState::Slot *slot)
 {
+    mSaveFileWriter.wait();
+
     mCharacterManager.deleteSlot(character, slot);
 }
 
@@ -597,6 +650,8 @@ void MWState::StateManager::update (float duration)
 {
     mTimePlayed += duration;
 
+    handleSaveFileResults();
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
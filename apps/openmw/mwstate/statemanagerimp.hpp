@@ -8,6 +8,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include "charactermanager.hpp"
+#include "savefilewriter.hpp"
 
 namespace MWState
 {
@@ -18,6 +19,7 @@ namespace MWState
             State mState;
             CharacterManager mCharacterManager;
             double mTimePlayed;
+            SaveFileWriter mSaveFileWriter;
 
         private:
 
@@ -29,9 +31,14 @@ namespace MWState
 
             std::map<int, int> buildContentFileIndexMap (const ESM::ESMReader& reader) const;
 
+            void reportSaveFailure (const std::string& error) const;
+
+            void handleSaveFileResults();
+            ///< Report files written by the background writer since the last call.
+
         public:
 
-            StateManager (const boost::filesystem::path& saves, const std::string& game);
+            StateManager (const boost::filesystem::path& saves, const std::string& game, SceneUtil::WorkQueue& workQueue);
 
             void requestQuit() override;
 
@@ -307,7 +307,7 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
-        mWorkQueue->addWorkItem(item);
+        mWorkQueue->addWorkItem(item, SceneUtil::WorkPriority::Normal);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
     }
@@ -363,7 +363,7 @@ namespace MWWorld
         {
             // the resource cache is cleared from the worker thread so that we're not holding up the main thread with delete operations
             mUpdateCacheItem = new UpdateCacheItem(mResourceSystem, timestamp);
-            mWorkQueue->addWorkItem(mUpdateCacheItem, true);
+            mWorkQueue->addWorkItem(mUpdateCacheItem, SceneUtil::WorkPriority::Low);
             mLastResourceCacheUpdate = timestamp;
         }
 
@@ -503,7 +503,7 @@ namespace MWWorld
             if (!positions.empty())
             {
                 mTerrainPreloadItem = new TerrainPreloadItem(mTerrainViews, mTerrain, positions);
-                mWorkQueue->addWorkItem(mTerrainPreloadItem);
+                mWorkQueue->addWorkItem(mTerrainPreloadItem, SceneUtil::WorkPriority::Low);
             }
         }
     }
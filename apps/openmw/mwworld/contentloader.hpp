@@ -21,6 +21,11 @@ struct ContentLoader
     {
     }
 
+    /// Called for all content files in the load order before any of them is loaded
+    virtual void prepare(const boost::filesystem::path& filepath, int index)
+    {
+    }
+
     virtual void load(const boost::filesystem::path& filepath, int& index)
     {
         Log(Debug::Info) << "Loading content file " << filepath.string();
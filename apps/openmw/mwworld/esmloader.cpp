@@ -1,8 +1,12 @@
 #include "esmloader.hpp"
+#include "esmparser.hpp"
 #include "esmstore.hpp"
 
 #include <components/esm/esmreader.hpp>
 
+#include <algorithm>
+#include <thread>
+
 namespace MWWorld
 {
 
@@ -15,17 +19,39 @@ EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& read
 {
 }
 
+EsmLoader::~EsmLoader() = default;
+
+void EsmLoader::prepare(const boost::filesystem::path& filepath, int index)
+{
+  if (mParser == nullptr)
+  {
+    const std::size_t threadsNumber = std::max(1u, std::thread::hardware_concurrency());
+    // Keep a few files per thread ready for the merge, but not all of them
+    mParser = std::make_unique<EsmParser>(mStore, mEncoder, threadsNumber, 2 * threadsNumber);
+  }
+  mParser->enqueue(index, filepath);
+}
+
 void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
 {
   ContentLoader::load(filepath.filename(), index);
 
+  open(filepath, index);
+
+  std::vector<std::unique_ptr<ParsedRecord>> parsed;
+  if (mParser != nullptr)
+    parsed = mParser->take(index);
+  mStore.load(mEsm[index], &mListener, parsed);
+}
+
+void EsmLoader::open(const boost::filesystem::path& filepath, int index)
+{
   ESM::ESMReader lEsm;
   lEsm.setEncoder(mEncoder);
   lEsm.setIndex(index);
   lEsm.setGlobalReaderList(&mEsm);
   lEsm.open(filepath.string());
   mEsm[index] = lEsm;
-  mStore.load(mEsm[index], &mListener);
 }
 
 } /* namespace MWWorld */
@@ -1,6 +1,7 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <memory>
 #include <vector>
 
 #include "contentloader.hpp"
@@ -19,18 +20,27 @@ namespace MWWorld
 {
 
 class ESMStore;
+class EsmParser;
 
 struct EsmLoader : public ContentLoader
 {
     EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
       ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener);
+    ~EsmLoader();
+
+    /// Starts reading records of the file on a background thread
+    void prepare(const boost::filesystem::path& filepath, int index) override;
 
     void load(const boost::filesystem::path& filepath, int& index) override;
 
+    /// Open the file to read cell references and land data from it, without loading its records into the store
+    void open(const boost::filesystem::path& filepath, int index);
+
     private:
       std::vector<ESM::ESMReader>& mEsm;
       MWWorld::ESMStore& mStore;
       ToUTF8::Utf8Encoder* mEncoder;
+      std::unique_ptr<EsmParser> mParser;
 };
 
 } /* namespace MWWorld */
@@ -0,0 +1,117 @@
+#include "esmparser.hpp"
+#include "esmstore.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <algorithm>
+
+namespace MWWorld
+{
+    EsmParser::EsmParser(const ESMStore& store, const ToUTF8::Utf8Encoder* encoder, std::size_t threadsNumber,
+            std::size_t maxPending)
+        : mStore(store)
+        , mEncoder(encoder)
+        , mMaxPending(std::max<std::size_t>(maxPending, 1))
+    {
+        for (std::size_t i = 0; i < threadsNumber; ++i)
+            mThreads.emplace_back([this] { process(); });
+    }
+
+    EsmParser::~EsmParser()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mShouldStop = true;
+            mJobs.clear();
+        }
+        mHasJob.notify_all();
+        for (auto& thread : mThreads)
+            thread.join();
+    }
+
+    void EsmParser::enqueue(int index, const boost::filesystem::path& filepath)
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mJobs.push_back(Job {index, filepath});
+            mResults[index];
+        }
+        mHasJob.notify_one();
+    }
+
+    std::vector<std::unique_ptr<ParsedRecord>> EsmParser::take(int index)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        const auto it = mResults.find(index);
+        if (it == mResults.end())
+            return {};
+        const auto job = std::find_if(mJobs.begin(), mJobs.end(), [&] (const Job& v) { return v.mIndex == index; });
+        if (job != mJobs.end())
+        {
+            const Job current = std::move(*job);
+            mJobs.erase(job);
+            mResults.erase(it);
+            lock.unlock();
+            return parse(current);
+        }
+        mDone.wait(lock, [&] { return it->second.mDone; });
+        std::vector<std::unique_ptr<ParsedRecord>> result = std::move(it->second.mRecords);
+        mResults.erase(it);
+        --mPending;
+        lock.unlock();
+        mHasJob.notify_one();
+        return result;
+    }
+
+    void EsmParser::process()
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mHasJob.wait(lock, [&] { return mShouldStop || (!mJobs.empty() && mPending < mMaxPending); });
+                if (mShouldStop)
+                    return;
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+                ++mPending;
+            }
+
+            std::vector<std::unique_ptr<ParsedRecord>> records = parse(job);
+
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                Result& result = mResults[job.mIndex];
+                result.mRecords = std::move(records);
+                result.mDone = true;
+            }
+            mDone.notify_all();
+        }
+    }
+
+    std::vector<std::unique_ptr<ParsedRecord>> EsmParser::parse(const Job& job) const
+    {
+        try
+        {
+            // Encoder keeps conversion buffer, so each thread needs its own one
+            std::unique_ptr<ToUTF8::Utf8Encoder> encoder;
+            if (mEncoder != nullptr)
+                encoder = std::make_unique<ToUTF8::Utf8Encoder>(mEncoder->getEncoding());
+
+            ESM::ESMReader reader;
+            reader.setEncoder(encoder.get());
+            reader.setIndex(job.mIndex);
+            reader.open(job.mFilepath.string());
+            return mStore.parse(reader);
+        }
+        catch (const std::exception& e)
+        {
+            // Errors are reported by the main thread loading the file the usual way
+            Log(Debug::Verbose) << "Failed to parse content file " << job.mFilepath.string() << " in advance: " << e.what();
+            return {};
+        }
+    }
+}
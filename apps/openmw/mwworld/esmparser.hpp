@@ -0,0 +1,72 @@
+#ifndef OPENMW_MWWORLD_ESMPARSER_H
+#define OPENMW_MWWORLD_ESMPARSER_H
+
+#include <boost/filesystem/path.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+    struct ParsedRecord;
+
+    /// Reads records of content files on background threads using ESMStore::parse, so only the order dependent
+    /// merge into the store is left for the main thread.
+    class EsmParser
+    {
+    public:
+        /// @param maxPending how many files may be parsed ahead of the merge, parsed records can take a lot of memory
+        EsmParser(const ESMStore& store, const ToUTF8::Utf8Encoder* encoder, std::size_t threadsNumber,
+            std::size_t maxPending);
+        ~EsmParser();
+
+        void enqueue(int index, const boost::filesystem::path& filepath);
+
+        /// Waits until the content file is parsed, parses it on the calling thread if no other thread has started yet.
+        /// @return Empty list if the file was not enqueued or failed to parse, so it has to be loaded the usual way.
+        std::vector<std::unique_ptr<ParsedRecord>> take(int index);
+
+    private:
+        struct Job
+        {
+            int mIndex;
+            boost::filesystem::path mFilepath;
+        };
+
+        struct Result
+        {
+            bool mDone = false;
+            std::vector<std::unique_ptr<ParsedRecord>> mRecords;
+        };
+
+        const ESMStore& mStore;
+        const ToUTF8::Utf8Encoder* mEncoder;
+        const std::size_t mMaxPending;
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mDone;
+        bool mShouldStop = false;
+        std::deque<Job> mJobs;
+        std::map<int, Result> mResults;
+        // Files being parsed or parsed and not taken yet
+        std::size_t mPending = 0;
+        std::vector<std::thread> mThreads;
+
+        void process();
+
+        std::vector<std::unique_ptr<ParsedRecord>> parse(const Job& job) const;
+    };
+}
+
+#endif
@@ -68,6 +68,33 @@ static bool isCacheableRecord(int id)
 }
 
 void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
+{
+    std::vector<std::unique_ptr<ParsedRecord>> parsed;
+    load(esm, listener, parsed);
+}
+
+std::vector<std::unique_ptr<ParsedRecord>> ESMStore::parse(ESM::ESMReader &esm) const
+{
+    std::vector<std::unique_ptr<ParsedRecord>> result;
+
+    while(esm.hasMoreRecs())
+    {
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+
+        std::map<int, StoreBase *>::const_iterator it = mStores.find(n.intval);
+        std::unique_ptr<ParsedRecord> record;
+        if (it != mStores.end())
+            record = it->second->parse(esm);
+        if (record == nullptr)
+            esm.skipRecord();
+        result.push_back(std::move(record));
+    }
+
+    return result;
+}
+
+void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener, std::vector<std::unique_ptr<ParsedRecord>>& parsed)
 {
     listener->setProgressRange(1000);
 
@@ -108,11 +135,17 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
     }
 
     // Loop through all records
+    std::size_t recordIndex = 0;
     while(esm.hasMoreRecs())
     {
         ESM::NAME n = esm.getRecName();
         esm.getRecHeader();
 
+        std::unique_ptr<ParsedRecord> parsedRecord;
+        if (recordIndex < parsed.size())
+            parsedRecord = std::move(parsed[recordIndex]);
+        ++recordIndex;
+
         // Look up the record type.
         std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
 
@@ -143,7 +176,15 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
                 throw std::runtime_error(error.str());
             }
         } else {
-            RecordId id = it->second->load(esm);
+            RecordId id;
+            if (parsedRecord != nullptr)
+            {
+                esm.skipRecord();
+                id = it->second->load(*parsedRecord);
+            }
+            else
+                id = it->second->load(esm);
+
             if (id.mIsDeleted)
             {
                 it->second->eraseStatic(id.mId);
@@ -160,6 +201,73 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
     }
 }
 
+void ESMStore::writeSnapshot(ESM::ESMWriter &writer) const
+{
+    for (std::map<int, StoreBase *>::const_iterator it = mStores.begin(); it != mStores.end(); ++it)
+    {
+        // Pathgrids are written last, because loading them requires cells
+        if (it->first != ESM::REC_PGRD)
+            it->second->writeSnapshot(writer);
+    }
+    mPathgrids.writeSnapshot(writer);
+
+    for (const auto& effect : mMagicEffects)
+    {
+        writer.startRecord(ESM::REC_MGEF);
+        effect.second.save(writer);
+        writer.endRecord(ESM::REC_MGEF);
+    }
+
+    for (const auto& skill : mSkills)
+    {
+        writer.startRecord(ESM::REC_SKIL);
+        skill.second.save(writer);
+        writer.endRecord(ESM::REC_SKIL);
+    }
+}
+
+void ESMStore::loadSnapshot(ESM::ESMReader &esm, std::size_t contentFilesCount, Loading::Listener* listener)
+{
+    listener->setProgressRange(1000);
+
+    mLandTextures.resize(contentFilesCount);
+
+    ESM::Dialogue *dialogue = nullptr;
+
+    while (esm.hasMoreRecs())
+    {
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+
+        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+
+        if (it == mStores.end()) {
+            if (n.intval == ESM::REC_INFO) {
+                if (dialogue == nullptr)
+                    esm.fail("Info record without dialog");
+                dialogue->readInfo(esm, false);
+            } else if (n.intval == ESM::REC_MGEF) {
+                mMagicEffects.load (esm);
+            } else if (n.intval == ESM::REC_SKIL) {
+                mSkills.load (esm);
+            } else {
+                std::stringstream error;
+                error << "Unknown record: " << n.toString();
+                throw std::runtime_error(error.str());
+            }
+        } else {
+            const RecordId id = it->second->readSnapshot(esm);
+
+            if (n.intval==ESM::REC_DIAL) {
+                dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
+            } else {
+                dialogue = nullptr;
+            }
+        }
+        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+    }
+}
+
 void ESMStore::setUp(bool validateRecords)
 {
     mIds.clear();
@@ -184,6 +184,23 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /// Load content file using records read in advance by parse(). The result is the same as for
+        /// load(ESM::ESMReader&, Loading::Listener*), only records that can't be parsed independently are read here.
+        /// @param esm reader opened for the same content file as the one used by parse()
+        void load(ESM::ESMReader &esm, Loading::Listener* listener, std::vector<std::unique_ptr<ParsedRecord>>& parsed);
+
+        /// Read all records of the content file without changing the store. Thread safe as long as the store is not
+        /// destroyed. Records that have to be loaded on the main thread are represented by nullptr.
+        std::vector<std::unique_ptr<ParsedRecord>> parse(ESM::ESMReader &esm) const;
+
+        /// Write records loaded from content files, so they can be loaded back by loadSnapshot() without
+        /// loading content files. Has to be called before setUp.
+        void writeSnapshot(ESM::ESMWriter &writer) const;
+
+        /// Load records written by writeSnapshot() instead of loading content files.
+        /// @param contentFilesCount number of content files the snapshot was made from
+        void loadSnapshot(ESM::ESMReader &esm, std::size_t contentFilesCount, Loading::Listener* listener);
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
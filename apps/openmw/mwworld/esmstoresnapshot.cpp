@@ -0,0 +1,125 @@
+#include "esmstoresnapshot.hpp"
+#include "esmstore.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <stdexcept>
+
+namespace MWWorld
+{
+    ESM::StoreSnapshot makeStoreSnapshot(const std::vector<boost::filesystem::path>& contentFiles,
+        const ToUTF8::Utf8Encoder* encoder)
+    {
+        ESM::StoreSnapshot result;
+        result.mEncoding = encoder == nullptr ? -1 : static_cast<int>(encoder->getEncoding());
+        for (const boost::filesystem::path& path : contentFiles)
+        {
+            ESM::StoreSnapshot::ContentFile file;
+            file.mPath = boost::filesystem::absolute(path).string();
+            file.mSize = boost::filesystem::file_size(path);
+            file.mModificationTime = static_cast<std::int64_t>(boost::filesystem::last_write_time(path));
+            result.mContentFiles.push_back(std::move(file));
+        }
+        return result;
+    }
+
+    bool loadStoreSnapshot(const boost::filesystem::path& path, const ESM::StoreSnapshot& expected, ESMStore& store,
+        Loading::Listener& listener)
+    {
+        if (!boost::filesystem::exists(path))
+            return false;
+
+        // Strings are written without conversion, so the reader has no encoder
+        ESM::ESMReader reader;
+        try
+        {
+            reader.open(path.string());
+
+            if (!reader.hasMoreRecs() || reader.getRecName().intval != ESM::REC_SNAP)
+            {
+                Log(Debug::Warning) << "File " << path.string() << " is not an ESM store snapshot";
+                return false;
+            }
+
+            reader.getRecHeader();
+
+            ESM::StoreSnapshot snapshot;
+            snapshot.load(reader);
+
+            if (snapshot != expected)
+            {
+                Log(Debug::Info) << "ESM store snapshot " << path.string() << " is made for different content files";
+                return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read ESM store snapshot " << path.string() << " header: " << e.what();
+            return false;
+        }
+
+        Log(Debug::Info) << "Loading ESM store snapshot " << path.string();
+        listener.setLabel("Loading game data");
+
+        try
+        {
+            store.loadSnapshot(reader, expected.mContentFiles.size(), &listener);
+        }
+        catch (const std::exception& e)
+        {
+            throw std::runtime_error("Failed to load ESM store snapshot " + path.string() + ": " + e.what()
+                + ". Remove the file to load content files again.");
+        }
+
+        return true;
+    }
+
+    void saveStoreSnapshot(const boost::filesystem::path& path, const ESM::StoreSnapshot& snapshot,
+        const ESMStore& store)
+    {
+        if (path.has_parent_path())
+            boost::filesystem::create_directories(path.parent_path());
+
+        // Write to a temporary file first, so an interrupted write doesn't leave a broken snapshot
+        const boost::filesystem::path temporaryPath = path.string() + ".tmp";
+
+        {
+            boost::filesystem::ofstream stream(temporaryPath, std::ios::binary);
+            if (!stream.is_open())
+                throw std::runtime_error("Failed to open " + temporaryPath.string() + " for writing");
+
+            ESM::ESMWriter writer;
+            writer.setFormat(0);
+            writer.setVersion();
+            writer.setType(0);
+            writer.setAuthor("OpenMW");
+            writer.setDescription("ESM store snapshot");
+            for (const ESM::StoreSnapshot::ContentFile& file : snapshot.mContentFiles)
+                writer.addMaster(boost::filesystem::path(file.mPath).filename().string(), file.mSize);
+
+            writer.save(stream);
+
+            writer.startRecord(ESM::REC_SNAP);
+            snapshot.save(writer);
+            writer.endRecord(ESM::REC_SNAP);
+
+            store.writeSnapshot(writer);
+
+            writer.close();
+
+            if (!stream)
+                throw std::runtime_error("Failed to write " + temporaryPath.string());
+        }
+
+        boost::filesystem::rename(temporaryPath, path);
+
+        Log(Debug::Info) << "Written ESM store snapshot " << path.string();
+    }
+}
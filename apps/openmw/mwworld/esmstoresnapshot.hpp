@@ -0,0 +1,38 @@
+#ifndef OPENMW_MWWORLD_ESMSTORESNAPSHOT_H
+#define OPENMW_MWWORLD_ESMSTORESNAPSHOT_H
+
+#include <components/esm/storesnapshot.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <vector>
+
+namespace Loading
+{
+    class Listener;
+}
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// Describe content files in the load order, so a snapshot can be checked to be made from the same files.
+    ESM::StoreSnapshot makeStoreSnapshot(const std::vector<boost::filesystem::path>& contentFiles,
+        const ToUTF8::Utf8Encoder* encoder);
+
+    /// Load the store from the snapshot file made by saveStoreSnapshot() for the same content files.
+    /// @return false if there is no such file or it is made for different content files, the store is not changed then.
+    bool loadStoreSnapshot(const boost::filesystem::path& path, const ESM::StoreSnapshot& expected, ESMStore& store,
+        Loading::Listener& listener);
+
+    /// Write records loaded from content files into the snapshot file. Has to be called before ESMStore::setUp.
+    void saveStoreSnapshot(const boost::filesystem::path& path, const ESM::StoreSnapshot& snapshot,
+        const ESMStore& store);
+}
+
+#endif
@@ -43,6 +43,7 @@
 #include "cellvisitors.hpp"
 #include "cellstore.hpp"
 #include "cellpreloader.hpp"
+#include "inventorystore.hpp"
 
 namespace
 {
@@ -258,6 +259,57 @@ namespace
         }
     };
 
+    // Start decoding sounds actors are likely to play soon to avoid loading them when they are needed
+    struct PreloadActorSoundsVisitor
+    {
+        MWBase::SoundManager& mSoundManager;
+        const MWWorld::Store<ESM::SoundGenerator>& mSoundGenerators;
+
+        bool operator() (const MWWorld::Ptr& ptr)
+        {
+            if (ptr.getRefData().isDeleted() || !ptr.getRefData().isEnabled())
+                return true;
+            if (ptr.getTypeName() == typeid(ESM::Creature).name())
+                preloadCreatureSounds(ptr);
+            else
+                preloadNpcSounds(ptr);
+            return true;
+        }
+
+        void preloadCreatureSounds(const MWWorld::Ptr& ptr)
+        {
+            // Creature::getSoundIdFromSndGen picks a random sound, so preload all of them
+            const ESM::Creature& creature = *ptr.get<ESM::Creature>()->mBase;
+            const std::string& id = creature.mOriginal.empty() ? ptr.getCellRef().getRefId() : creature.mOriginal;
+            for (const ESM::SoundGenerator& sound : mSoundGenerators)
+                if (Misc::StringUtils::ciEqual(id, sound.mCreature))
+                    mSoundManager.preloadSound(sound.mSound);
+        }
+
+        void preloadNpcSounds(const MWWorld::Ptr& ptr)
+        {
+            const MWWorld::InventoryStore& inventory = ptr.getClass().getInventoryStore(ptr);
+            const MWWorld::ConstContainerStoreIterator boots = inventory.getSlot(MWWorld::InventoryStore::Slot_Boots);
+            if (boots == inventory.end() || boots->getTypeName() != typeid(ESM::Armor).name())
+                return preloadFootsteps("FootBare");
+            switch (boots->getClass().getEquipmentSkill(*boots))
+            {
+                case ESM::Skill::LightArmor:
+                    return preloadFootsteps("FootLight");
+                case ESM::Skill::MediumArmor:
+                    return preloadFootsteps("FootMed");
+                case ESM::Skill::HeavyArmor:
+                    return preloadFootsteps("FootHeavy");
+            }
+        }
+
+        void preloadFootsteps(const std::string& prefix)
+        {
+            mSoundManager.preloadSound(prefix + "Left");
+            mSoundManager.preloadSound(prefix + "Right");
+        }
+    };
+
     int getCellPositionDistanceToOrigin(const std::pair<int, int>& cellPosition)
     {
         return std::abs(cellPosition.first) + std::abs(cellPosition.second);
@@ -427,6 +479,14 @@ namespace MWWorld
             // ... then references. This is important for adjustPosition to work correctly.
             insertCell (*cell, loadingListener, test);
 
+            if (!test)
+            {
+                PreloadActorSoundsVisitor visitor {*MWBase::Environment::get().getSoundManager(),
+                                                   world->getStore().get<ESM::SoundGenerator>()};
+                cell->forEachType<ESM::Creature>(visitor);
+                cell->forEachType<ESM::NPC>(visitor);
+            }
+
             mRendering.addCell(cell);
             if (!test)
             {
@@ -4,10 +4,13 @@
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
+#include <components/esm/storesnapshot.hpp>
 
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 
 namespace
@@ -45,6 +48,29 @@ namespace
             return x->mX < y.first;
         }
     };
+
+    template <class T>
+    std::uint32_t getRecordFlags(const T& record)
+    {
+        return 0;
+    }
+
+    std::uint32_t getRecordFlags(const ESM::NPC& record)
+    {
+        return record.mPersistent ? 0x0400 : 0;
+    }
+
+    std::uint32_t getRecordFlags(const ESM::Creature& record)
+    {
+        return record.mPersistent ? 0x0400 : 0;
+    }
+
+    void readSnapshotExtraData(ESM::ESMReader& esm)
+    {
+        if (!esm.hasMoreRecs() || esm.getRecName().intval != ESM::REC_SNXT)
+            esm.fail("Missing snapshot extra data record");
+        esm.getRecHeader();
+    }
 }
 
 namespace MWWorld
@@ -136,34 +162,21 @@ namespace MWWorld
     template<typename T>
     const T *Store<T>::search(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-
-        typename Dynamic::const_iterator dit = mDynamic.find(idLower);
-        if (dit != mDynamic.end())
-            return &dit->second;
-
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-        if (it != mStatic.end())
-            return &(it->second);
+        if (const T *ptr = mDynamic.search(id))
+            return ptr;
 
-        return nullptr;
+        return mStatic.search(id);
     }
     template<typename T>
     const T *Store<T>::searchStatic(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-        if (it != mStatic.end())
-            return &(it->second);
-
-        return nullptr;
+        return mStatic.search(id);
     }
 
     template<typename T>
     bool Store<T>::isDynamic(const std::string &id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
-        return (dit != mDynamic.end());
+        return mDynamic.search(id) != nullptr;
     }
     template<typename T>
     const T *Store<T>::searchRandom(const std::string &id) const
@@ -205,11 +218,32 @@ namespace MWWorld
         record.load(esm, isDeleted);
         Misc::StringUtils::lowerCaseInPlace(record.mId);
 
-        std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(record.mId, record));
+        return insertLoaded(record, isDeleted);
+    }
+    template<typename T>
+    std::unique_ptr<ParsedRecord> Store<T>::parse(ESM::ESMReader &esm) const
+    {
+        auto result = std::make_unique<ParsedRecordValue<T>>();
+
+        result->mValue.load(esm, result->mIsDeleted);
+        Misc::StringUtils::lowerCaseInPlace(result->mValue.mId);
+
+        return result;
+    }
+    template<typename T>
+    RecordId Store<T>::load(ParsedRecord &record)
+    {
+        const ParsedRecordValue<T>& parsed = static_cast<const ParsedRecordValue<T>&>(record);
+        return insertLoaded(parsed.mValue, parsed.mIsDeleted);
+    }
+    template<typename T>
+    RecordId Store<T>::insertLoaded(const T &record, bool isDeleted)
+    {
+        std::pair<T *, bool> inserted = mStatic.insert(record.mId, record);
         if (inserted.second)
-            mShared.push_back(&inserted.first->second);
+            mShared.push_back(inserted.first);
         else
-            inserted.first->second = record;
+            *inserted.first = record;
 
         return RecordId(record.mId, isDeleted);
     }
@@ -252,10 +286,8 @@ namespace MWWorld
     template<typename T>
     T *Store<T>::insert(const T &item)
     {
-        std::string id = Misc::StringUtils::lowerCase(item.mId);
-        std::pair<typename Dynamic::iterator, bool> result =
-            mDynamic.insert(std::pair<std::string, T>(id, item));
-        T *ptr = &result.first->second;
+        std::pair<T *, bool> result = mDynamic.insert(item.mId, item);
+        T *ptr = result.first;
         if (result.second) {
             mShared.push_back(ptr);
         } else {
@@ -266,10 +298,8 @@ namespace MWWorld
     template<typename T>
     T *Store<T>::insertStatic(const T &item)
     {
-        std::string id = Misc::StringUtils::lowerCase(item.mId);
-        std::pair<typename Static::iterator, bool> result =
-            mStatic.insert(std::pair<std::string, T>(id, item));
-        T *ptr = &result.first->second;
+        std::pair<T *, bool> result = mStatic.insert(item.mId, item);
+        T *ptr = result.first;
         if (result.second) {
             mShared.push_back(ptr);
         } else {
@@ -280,23 +310,15 @@ namespace MWWorld
     template<typename T>
     bool Store<T>::eraseStatic(const std::string &id)
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-
-        typename std::map<std::string, T>::iterator it = mStatic.find(idLower);
+        const std::size_t staticSize = mStatic.size();
+        const T *ptr = mStatic.erase(id);
 
-        if (it != mStatic.end()) {
+        if (ptr != nullptr) {
             // delete from the static part of mShared
-            typename std::vector<T *>::iterator sharedIter = mShared.begin();
-            typename std::vector<T *>::iterator end = sharedIter + mStatic.size();
-
-            while (sharedIter != mShared.end() && sharedIter != end) {
-                if((*sharedIter)->mId == idLower) {
-                    mShared.erase(sharedIter);
-                    break;
-                }
-                ++sharedIter;
-            }
-            mStatic.erase(it);
+            typename std::vector<T *>::iterator end = mShared.begin() + std::min(staticSize, mShared.size());
+            typename std::vector<T *>::iterator sharedIter = std::find(mShared.begin(), end, ptr);
+            if (sharedIter != end)
+                mShared.erase(sharedIter);
         }
 
         return true;
@@ -305,19 +327,14 @@ namespace MWWorld
     template<typename T>
     bool Store<T>::erase(const std::string &id)
     {
-        std::string key = Misc::StringUtils::lowerCase(id);
-        typename Dynamic::iterator it = mDynamic.find(key);
-        if (it == mDynamic.end()) {
+        const T *ptr = mDynamic.erase(id);
+        if (ptr == nullptr) {
             return false;
         }
-        mDynamic.erase(it);
 
-        // have to reinit the whole shared part
+        // delete from the dynamic part of mShared
         assert(mShared.size() >= mStatic.size());
-        mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
-        for (it = mDynamic.begin(); it != mDynamic.end(); ++it) {
-            mShared.push_back(&it->second);
-        }
+        mShared.erase(std::find(mShared.begin() + mStatic.size(), mShared.end(), ptr));
         return true;
     }
     template<typename T>
@@ -328,11 +345,12 @@ namespace MWWorld
     template<typename T>
     void Store<T>::write (ESM::ESMWriter& writer, Loading::Listener& progress) const
     {
-        for (typename Dynamic::const_iterator iter (mDynamic.begin()); iter!=mDynamic.end();
+        assert(mShared.size() >= mStatic.size());
+        for (typename std::vector<T *>::const_iterator iter (mShared.begin() + mStatic.size()); iter!=mShared.end();
              ++iter)
         {
             writer.startRecord (T::sRecordId);
-            iter->second.save (writer);
+            (*iter)->save (writer);
             writer.endRecord (T::sRecordId);
         }
     }
@@ -347,6 +365,18 @@ namespace MWWorld
 
         return RecordId(record.mId, isDeleted);
     }
+    template<typename T>
+    void Store<T>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        assert(mShared.size() >= mStatic.size());
+        for (typename std::vector<T *>::const_iterator iter (mShared.begin()); iter != mShared.begin() + mStatic.size();
+             ++iter)
+        {
+            writer.startRecord (T::sRecordId, getRecordFlags(**iter));
+            (*iter)->save (writer);
+            writer.endRecord (T::sRecordId);
+        }
+    }
 
     // LandTexture
     //=========================================================================
@@ -423,6 +453,48 @@ namespace MWWorld
     {
         return load(esm, esm.getIndex());
     }
+    void Store<ESM::LandTexture>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (size_t plugin = 0; plugin < mStatic.size(); ++plugin)
+        {
+            const LandTextureList &ltexl = mStatic[plugin];
+            for (size_t index = 0; index < ltexl.size(); ++index)
+            {
+                writer.startRecord(ESM::REC_LTEX);
+                ltexl[index].save(writer);
+                writer.endRecord(ESM::REC_LTEX);
+
+                // Textures are already replaced across plugins, keep the position instead of loading them again
+                writer.startRecord(ESM::REC_SNXT);
+                writer.writeHNT("INDX", static_cast<std::uint32_t>(plugin));
+                writer.writeHNT("SLOT", static_cast<std::uint32_t>(index));
+                writer.endRecord(ESM::REC_SNXT);
+            }
+        }
+    }
+    RecordId Store<ESM::LandTexture>::readSnapshot(ESM::ESMReader &esm)
+    {
+        ESM::LandTexture lt;
+        bool isDeleted = false;
+
+        lt.load(esm, isDeleted);
+
+        readSnapshotExtraData(esm);
+        std::uint32_t plugin = 0;
+        std::uint32_t index = 0;
+        esm.getHNT(plugin, "INDX");
+        esm.getHNT(index, "SLOT");
+
+        if (plugin >= mStatic.size())
+            esm.fail("Invalid land texture plugin index " + std::to_string(plugin));
+
+        LandTextureList &ltexl = mStatic[plugin];
+        if (index + 1 > ltexl.size())
+            ltexl.resize(index + 1);
+        ltexl[index] = lt;
+
+        return RecordId(lt.mId, isDeleted);
+    }
     Store<ESM::LandTexture>::iterator Store<ESM::LandTexture>::begin(size_t plugin) const
     {
         assert(plugin < mStatic.size());
@@ -515,6 +587,45 @@ namespace MWWorld
         std::sort(mStatic.begin(), mStatic.end(), Compare());
         mBuilt = true;
     }
+    void Store<ESM::Land>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (const ESM::Land* land : mStatic)
+        {
+            // Land data is read from the content file on demand, only the location of it is kept
+            writer.startRecord(ESM::REC_LAND);
+            writer.startSubRecord("INTV");
+            writer.writeT(land->mX);
+            writer.writeT(land->mY);
+            writer.endRecord("INTV");
+            writer.writeHNT("DATA", land->mFlags);
+            writer.endRecord(ESM::REC_LAND);
+
+            writer.startRecord(ESM::REC_SNXT);
+            writer.writeHNT("INDX", land->mPlugin);
+            writer.writeHNT("DTYP", land->mDataTypes);
+            writer.writeHNT("WNAM", land->mWnam);
+            ESM::StoreSnapshot::saveContext(writer, land->mContext);
+            writer.endRecord(ESM::REC_SNXT);
+        }
+    }
+    RecordId Store<ESM::Land>::readSnapshot(ESM::ESMReader &esm)
+    {
+        std::unique_ptr<ESM::Land> land = std::make_unique<ESM::Land>();
+        bool isDeleted = false;
+
+        land->load(esm, isDeleted);
+
+        readSnapshotExtraData(esm);
+        esm.getHNT(land->mPlugin, "INDX");
+        esm.getHNT(land->mDataTypes, "DTYP");
+        esm.getHNT(land->mWnam, "WNAM");
+        esm.getSubNameIs("CNTX");
+        land->mContext = ESM::StoreSnapshot::loadContext(esm);
+
+        mStatic.push_back(land.release());
+
+        return RecordId("", isDeleted);
+    }
 
 
     // Cell
@@ -758,6 +869,87 @@ namespace MWWorld
 
         return RecordId(cell.mName, isDeleted);
     }
+    void Store<ESM::Cell>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        const auto writeCell = [&] (const ESM::Cell& cell)
+        {
+            writer.startRecord(ESM::REC_CELL);
+            cell.save(writer);
+            writer.endRecord(ESM::REC_CELL);
+
+            // ESM::Cell::save doesn't write water level, ambient light and region for all kinds of cells
+            writer.startRecord(ESM::REC_SNXT);
+            writer.writeHNT("WHGT", cell.mWater);
+            writer.writeHNT("WINT", static_cast<std::uint8_t>(cell.mWaterInt));
+            if (cell.mHasAmbi)
+                writer.writeHNT("AMBI", cell.mAmbi, 16);
+            writer.writeHNOCString("RGNN", cell.mRegion);
+            for (const ESM::ESM_Context& context : cell.mContextList)
+                ESM::StoreSnapshot::saveContext(writer, context);
+            for (const ESM::MovedCellRef& ref : cell.mMovedRefs)
+            {
+                ref.mRefNum.save(writer, true, "MVRF");
+                writer.writeHNT("CNDT", ref.mTarget);
+            }
+            for (const std::pair<ESM::CellRef, bool>& ref : cell.mLeasedRefs)
+            {
+                writer.writeHNT("LEAS", static_cast<std::uint8_t>(ref.second));
+                ref.first.save(writer, true);
+                // ESM::CellRef::save clamps the scale
+                writer.writeHNT("SCAL", ref.first.mScale);
+            }
+            writer.endRecord(ESM::REC_SNXT);
+        };
+
+        for (const auto& cell : mInt)
+            writeCell(cell.second);
+        for (const auto& cell : mExt)
+            writeCell(cell.second);
+    }
+    RecordId Store<ESM::Cell>::readSnapshot(ESM::ESMReader &esm)
+    {
+        ESM::Cell cell;
+        bool isDeleted = false;
+
+        cell.loadNameAndData(esm, isDeleted);
+        cell.loadCell(esm, false);
+
+        readSnapshotExtraData(esm);
+        esm.getHNT(cell.mWater, "WHGT");
+        std::uint8_t waterInt = 0;
+        esm.getHNT(waterInt, "WINT");
+        cell.mWaterInt = waterInt != 0;
+        cell.mHasAmbi = esm.isNextSub("AMBI");
+        if (cell.mHasAmbi)
+            esm.getHT(cell.mAmbi, 16);
+        cell.mRegion = esm.getHNOString("RGNN");
+        while (esm.isNextSub("CNTX"))
+            cell.mContextList.push_back(ESM::StoreSnapshot::loadContext(esm));
+        while (esm.isNextSub("MVRF"))
+        {
+            ESM::MovedCellRef ref;
+            esm.getHT(ref.mRefNum, 8);
+            esm.getHNT(ref.mTarget, "CNDT");
+            cell.mMovedRefs.push_back(ref);
+        }
+        while (esm.isNextSub("LEAS"))
+        {
+            std::uint8_t deleted = 0;
+            esm.getHT(deleted);
+            ESM::CellRef ref;
+            bool isRefDeleted = false;
+            ref.load(esm, isRefDeleted, true);
+            esm.getHNT(ref.mScale, "SCAL");
+            cell.mLeasedRefs.emplace_back(ref, deleted != 0);
+        }
+
+        if (cell.isExterior())
+            mExt[std::make_pair(cell.mData.mX, cell.mData.mY)] = cell;
+        else
+            mInt[Misc::StringUtils::lowerCase(cell.mName)] = cell;
+
+        return RecordId(cell.mName, isDeleted);
+    }
     Store<ESM::Cell>::iterator Store<ESM::Cell>::intBegin() const
     {
         return iterator(mSharedInt.begin());
@@ -953,6 +1145,21 @@ namespace MWWorld
     {
         return mInt.size() + mExt.size();
     }
+    void Store<ESM::Pathgrid>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        for (const auto& pathgrid : mInt)
+        {
+            writer.startRecord(ESM::REC_PGRD);
+            pathgrid.second.save(writer);
+            writer.endRecord(ESM::REC_PGRD);
+        }
+        for (const auto& pathgrid : mExt)
+        {
+            writer.startRecord(ESM::REC_PGRD);
+            pathgrid.second.save(writer);
+            writer.endRecord(ESM::REC_PGRD);
+        }
+    }
     void Store<ESM::Pathgrid>::setUp()
     {
     }
@@ -1081,18 +1288,29 @@ namespace MWWorld
     {
         // DialInfos marked as deleted are kept during the loading phase, so that the linked list
         // structure is kept intact for inserting further INFOs. Delete them now that loading is done.
-        for (Static::iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+        std::vector<std::pair<std::string, ESM::Dialogue*>> sorted;
+        sorted.reserve(mStatic.size());
+        mStatic.forEach([&] (const std::string& id, ESM::Dialogue& dial)
         {
-            ESM::Dialogue& dial = it->second;
             dial.clearDeletedInfos();
-        }
+            sorted.emplace_back(id, &dial);
+        });
+
+        // Dialogues are listed ordered by id
+        std::sort(sorted.begin(), sorted.end(),
+            [] (const auto& left, const auto& right) { return left.first < right.first; });
 
         mShared.clear();
-        mShared.reserve(mStatic.size());
-        std::map<std::string, ESM::Dialogue>::iterator it = mStatic.begin();
-        for (; it != mStatic.end(); ++it) {
-            mShared.push_back(&(it->second));
-        }
+        mShared.reserve(sorted.size());
+        for (const auto& v : sorted)
+            mShared.push_back(v.second);
+    }
+
+    template <>
+    std::unique_ptr<ParsedRecord> Store<ESM::Dialogue>::parse(ESM::ESMReader &esm) const
+    {
+        // Dialogue records are merged with the already loaded ones
+        return nullptr;
     }
 
     template <>
@@ -1103,17 +1321,16 @@ namespace MWWorld
 
         dialogue.loadId(esm);
 
-        std::string idLower = Misc::StringUtils::lowerCase(dialogue.mId);
-        std::map<std::string, ESM::Dialogue>::iterator found = mStatic.find(idLower);
-        if (found == mStatic.end())
+        ESM::Dialogue* found = mStatic.search(dialogue.mId);
+        if (found == nullptr)
         {
             dialogue.loadData(esm, isDeleted);
-            mStatic.insert(std::make_pair(idLower, dialogue));
+            mStatic.insert(dialogue.mId, dialogue);
         }
         else
         {
-            found->second.loadData(esm, isDeleted);
-            dialogue = found->second;
+            found->loadData(esm, isDeleted);
+            dialogue = *found;
         }
 
         return RecordId(dialogue.mId, isDeleted);
@@ -1122,14 +1339,34 @@ namespace MWWorld
     template<>
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
-        auto it = mStatic.find(Misc::StringUtils::lowerCase(id));
-
-        if (it != mStatic.end())
-            mStatic.erase(it);
+        mStatic.erase(id);
 
         return true;
     }
 
+    template<>
+    void Store<ESM::Dialogue>::writeSnapshot(ESM::ESMWriter& writer) const
+    {
+        // mShared is filled only by setUp. Infos of each dialogue follow it like in the content files,
+        // except the deleted ones, setUp would remove them anyway.
+        mStatic.forEach([&] (const std::string& id, const ESM::Dialogue& dialogue)
+        {
+            writer.startRecord(ESM::REC_DIAL);
+            dialogue.save(writer);
+            writer.endRecord(ESM::REC_DIAL);
+
+            for (const ESM::DialInfo& info : dialogue.mInfo)
+            {
+                const auto lookup = dialogue.mLookup.find(info.mId);
+                if (lookup != dialogue.mLookup.end() && lookup->second.second)
+                    continue;
+                writer.startRecord(ESM::REC_INFO);
+                info.save(writer);
+                writer.endRecord(ESM::REC_INFO);
+            }
+        });
+    }
+
 }
 
 template class MWWorld::Store<ESM::Activator>;
@@ -1,10 +1,14 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
 
+#include <components/misc/cistringindex.hpp>
+
 #include "recordcmp.hpp"
 
 namespace ESM
@@ -27,6 +31,19 @@ namespace MWWorld
         RecordId(const std::string &id = "", bool isDeleted = false);
     };
 
+    /// Record read from a content file but not yet inserted into a store, see StoreBase::parse
+    struct ParsedRecord
+    {
+        virtual ~ParsedRecord() {}
+    };
+
+    template <class T>
+    struct ParsedRecordValue : ParsedRecord
+    {
+        T mValue;
+        bool mIsDeleted = false;
+    };
+
     class StoreBase
     {
     public:
@@ -41,6 +58,14 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader &esm) = 0;
 
+        /// Read the record without changing the store, so that it can be done on a background thread.
+        /// @return nullptr if the record can't be read independently of the previously loaded records and has to
+        /// be loaded with load(ESM::ESMReader&) instead.
+        virtual std::unique_ptr<ParsedRecord> parse(ESM::ESMReader &esm) const { return nullptr; }
+
+        /// Insert the record returned by parse(). Has the same effect as load(ESM::ESMReader&) for the same data.
+        virtual RecordId load(ParsedRecord &record) { return RecordId(); }
+
         virtual bool eraseStatic(const std::string &id) {return false;}
         virtual void clearDynamic() {}
 
@@ -48,6 +73,12 @@ namespace MWWorld
 
         virtual RecordId read (ESM::ESMReader& reader) { return RecordId(); }
         ///< Read into dynamic storage
+
+        /// Write static records for ESMStore::writeSnapshot.
+        virtual void writeSnapshot(ESM::ESMWriter& writer) const {}
+
+        /// Read a record written by writeSnapshot(). Records are already merged, so they are inserted as is.
+        virtual RecordId readSnapshot(ESM::ESMReader& reader) { return load(reader); }
     };
 
     template <class T>
@@ -140,19 +171,92 @@ namespace MWWorld
         }
     };
 
+    /// Records stored in chunks of contiguous memory with case insensitive id lookup.
+    /// Addresses of the records are stable, erased slots are reused by following insertions.
+    template <class T>
+    class RecordTable
+    {
+        std::deque<T> mRecords;
+        std::vector<int> mFree;
+        Misc::CiStringIndex mIndex;
+
+    public:
+        const T *search(const std::string &id) const
+        {
+            const int index = mIndex.find(id);
+            return index < 0 ? nullptr : &mRecords[index];
+        }
+
+        T *search(const std::string &id)
+        {
+            const int index = mIndex.find(id);
+            return index < 0 ? nullptr : &mRecords[index];
+        }
+
+        /// @return Stored record and whether it was inserted. Existing record is left unchanged.
+        std::pair<T *, bool> insert(const std::string &id, const T &record)
+        {
+            if (T *existing = search(id))
+                return {existing, false};
+            int index;
+            if (mFree.empty())
+            {
+                index = static_cast<int>(mRecords.size());
+                mRecords.push_back(record);
+            }
+            else
+            {
+                index = mFree.back();
+                mFree.pop_back();
+                mRecords[index] = record;
+            }
+            mIndex.insert(id, index);
+            return {&mRecords[index], true};
+        }
+
+        /// @return Address of the erased record or nullptr if there is no such record.
+        const T *erase(const std::string &id)
+        {
+            const int index = mIndex.erase(id);
+            if (index < 0)
+                return nullptr;
+            mFree.push_back(index);
+            return &mRecords[index];
+        }
+
+        void clear()
+        {
+            mRecords.clear();
+            mFree.clear();
+            mIndex.clear();
+        }
+
+        std::size_t size() const { return mIndex.size(); }
+
+        /// Calls f(id, record) for each record in unspecified order, ids are in lower case.
+        template <class F>
+        void forEach(F &&f)
+        {
+            mIndex.forEach([&] (const std::string &id, int index) { f(id, mRecords[index]); });
+        }
+
+        template <class F>
+        void forEach(F &&f) const
+        {
+            mIndex.forEach([&] (const std::string &id, int index) { f(id, mRecords[index]); });
+        }
+    };
+
     class ESMStore;
 
     template <class T>
     class Store : public StoreBase
     {
-        std::map<std::string, T>      mStatic;
+        RecordTable<T>      mStatic;
         std::vector<T *>    mShared; // Preserves the record order as it came from the content files (this
                                      // is relevant for the spell autocalc code and selection order
                                      // for heads/hairs in the character creation)
-        std::map<std::string, T> mDynamic;
-
-        typedef std::map<std::string, T> Dynamic;
-        typedef std::map<std::string, T> Static;
+        RecordTable<T>      mDynamic;
 
         friend class ESMStore;
 
@@ -200,8 +304,14 @@ namespace MWWorld
         bool erase(const T &item);
 
         RecordId load(ESM::ESMReader &esm) override;
+        std::unique_ptr<ParsedRecord> parse(ESM::ESMReader &esm) const override;
+        RecordId load(ParsedRecord &record) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader) override;
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+
+    private:
+        RecordId insertLoaded(const T &record, bool isDeleted);
     };
 
     template <>
@@ -230,6 +340,9 @@ namespace MWWorld
         RecordId load(ESM::ESMReader &esm, size_t plugin);
         RecordId load(ESM::ESMReader &esm) override;
 
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
+
         iterator begin(size_t plugin) const;
         iterator end(size_t plugin) const;
     };
@@ -255,6 +368,9 @@ namespace MWWorld
 
         RecordId load(ESM::ESMReader &esm) override;
         void setUp() override;
+
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
     private:
         bool mBuilt = false;
     };
@@ -309,6 +425,10 @@ namespace MWWorld
 
         RecordId load(ESM::ESMReader &esm) override;
 
+        /// Cells are written with positions of their references in the content files and moved references
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+        RecordId readSnapshot(ESM::ESMReader& reader) override;
+
         iterator intBegin() const;
         iterator intEnd() const;
         iterator extBegin() const;
@@ -354,6 +474,9 @@ namespace MWWorld
         RecordId load(ESM::ESMReader &esm) override;
         size_t getSize() const override;
 
+        /// @note Cells have to be read before pathgrids to distinguish interior ones
+        void writeSnapshot(ESM::ESMWriter& writer) const override;
+
         void setUp() override;
 
         const ESM::Pathgrid *search(int x, int y) const;
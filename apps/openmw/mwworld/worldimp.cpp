@@ -7,6 +7,8 @@
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 #include <BulletCollision/CollisionShapes/btCompoundShape.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <components/debug/debuglog.hpp>
 
 #include <components/esm/esmreader.hpp>
@@ -73,6 +75,7 @@
 
 #include "contentloader.hpp"
 #include "esmloader.hpp"
+#include "esmstoresnapshot.hpp"
 
 namespace
 {
@@ -103,6 +106,13 @@ namespace MWWorld
             return mLoaders.insert(std::make_pair(extension, loader)).second;
         }
 
+        void prepare(const boost::filesystem::path& filepath, int index) override
+        {
+            LoadersContainer::iterator it(mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string())));
+            if (it != mLoaders.end())
+                it->second->prepare(filepath, index);
+        }
+
         void load(const boost::filesystem::path& filepath, int& index) override
         {
             LoadersContainer::iterator it(mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string())));
@@ -165,7 +175,38 @@ namespace MWWorld
         gameContentLoader.addLoader(".omwaddon", &esmLoader);
         gameContentLoader.addLoader(".project", &esmLoader);
 
-        loadContentFiles(fileCollections, contentFiles, gameContentLoader);
+        const std::vector<boost::filesystem::path> contentPaths = getContentFilePaths(fileCollections, contentFiles);
+
+        const bool useStoreSnapshot = Settings::Manager::getBool("esm store snapshot", "Game");
+        boost::filesystem::path storeSnapshotPath = Settings::Manager::getString("esm store snapshot path", "Game");
+        if (storeSnapshotPath.empty())
+            storeSnapshotPath = boost::filesystem::path(mUserDataPath) / "esmstore.snapshot";
+        ESM::StoreSnapshot storeSnapshot;
+        if (useStoreSnapshot)
+            storeSnapshot = makeStoreSnapshot(contentPaths, encoder);
+
+        if (useStoreSnapshot && loadStoreSnapshot(storeSnapshotPath, storeSnapshot, mStore, *listener))
+        {
+            // Cell references and land data are still read from the content files
+            for (std::size_t i = 0; i < contentPaths.size(); ++i)
+                esmLoader.open(contentPaths[i], static_cast<int>(i));
+        }
+        else
+        {
+            loadContentFiles(contentPaths, gameContentLoader);
+
+            if (useStoreSnapshot)
+            {
+                try
+                {
+                    saveStoreSnapshot(storeSnapshotPath, storeSnapshot, mStore);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to write ESM store snapshot " << storeSnapshotPath.string() << ": " << e.what();
+                }
+            }
+        }
 
         listener->loadingOff();
 
@@ -189,6 +230,8 @@ namespace MWWorld
             navigatorSettings->mMaxClimb = MWPhysics::sStepSizeUp;
             navigatorSettings->mMaxSlope = MWPhysics::sMaxSlope;
             navigatorSettings->mSwimHeightScale = mSwimHeightScale;
+            if (navigatorSettings->mNavMeshDiskCachePath.empty())
+                navigatorSettings->mNavMeshDiskCachePath = (boost::filesystem::path(mUserDataPath) / "navmesh").string();
             DetourNavigator::RecastGlobalAllocator::init();
             mNavigator.reset(new DetourNavigator::NavigatorImpl(*navigatorSettings));
         }
@@ -2940,23 +2983,37 @@ namespace MWWorld
         return mScriptsEnabled;
     }
 
-    void World::loadContentFiles(const Files::Collections& fileCollections,
-        const std::vector<std::string>& content, ContentLoader& contentLoader)
+    std::vector<boost::filesystem::path> World::getContentFilePaths(const Files::Collections& fileCollections,
+        const std::vector<std::string>& content)
     {
-        int idx = 0;
+        std::vector<boost::filesystem::path> result;
         for (const std::string &file : content)
         {
             boost::filesystem::path filename(file);
             const Files::MultiDirCollection& col = fileCollections.getCollection(filename.extension().string());
             if (col.doesExist(file))
             {
-                contentLoader.load(col.getPath(file), idx);
+                result.push_back(col.getPath(file));
             }
             else
             {
                 std::string message = "Failed loading " + file + ": the content file does not exist";
                 throw std::runtime_error(message);
             }
+        }
+        return result;
+    }
+
+    void World::loadContentFiles(const std::vector<boost::filesystem::path>& content, ContentLoader& contentLoader)
+    {
+        int idx = 0;
+        for (const boost::filesystem::path &file : content)
+            contentLoader.prepare(file, idx++);
+
+        idx = 0;
+        for (const boost::filesystem::path &file : content)
+        {
+            contentLoader.load(file, idx);
             idx++;
         }
     }
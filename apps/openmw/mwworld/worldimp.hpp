@@ -171,13 +171,19 @@ namespace MWWorld
             void updateSkyDate();
 
             /**
-             * @brief loadContentFiles - Loads content files (esm,esp,omwgame,omwaddon)
+             * @brief getContentFilePaths - Finds content files (esm,esp,omwgame,omwaddon)
              * @param fileCollections- Container which holds content file names and their paths
              * @param content - Container which holds content file names
+             */
+            static std::vector<boost::filesystem::path> getContentFilePaths(const Files::Collections& fileCollections,
+                const std::vector<std::string>& content);
+
+            /**
+             * @brief loadContentFiles - Loads content files (esm,esp,omwgame,omwaddon)
+             * @param content - Container which holds content file paths
              * @param contentLoader -
              */
-            void loadContentFiles(const Files::Collections& fileCollections,
-                const std::vector<std::string>& content, ContentLoader& contentLoader);
+            void loadContentFiles(const std::vector<boost::filesystem::path>& content, ContentLoader& contentLoader);
 
             float feetToGameUnits(float feet);
             float getActivationDistancePlusTelekinesis();
@@ -0,0 +1,119 @@
+#include <components/bsa/bsa_file.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    struct BsaFileTest : TestWithParam<bool>
+    {
+        const std::vector<std::pair<std::string, std::string>> mFiles {
+            {"meshes\\a.nif", "first"},
+            {"textures\\B.dds", "second file"},
+            {"icons\\c.tga", ""},
+        };
+        boost::filesystem::path mDirectory;
+
+        void SetUp() override
+        {
+            mDirectory = boost::filesystem::temp_directory_path()
+                / boost::filesystem::unique_path("openmw_test_bsa_%%%%%%%%");
+            boost::filesystem::create_directories(mDirectory);
+        }
+
+        void TearDown() override
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(mDirectory, ec);
+        }
+
+        std::string writeArchive()
+        {
+            auto name = std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".bsa";
+            std::replace(name.begin(), name.end(), '/', '_');
+            const std::string path = (mDirectory / name).string();
+
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::uint32_t> nameOffsets;
+            std::string names;
+            std::string data;
+            for (const auto& file : mFiles)
+            {
+                offsets.push_back(static_cast<std::uint32_t>(file.second.size()));
+                offsets.push_back(static_cast<std::uint32_t>(data.size()));
+                nameOffsets.push_back(static_cast<std::uint32_t>(names.size()));
+                names += file.first;
+                names.push_back('\0');
+                data += file.second;
+            }
+
+            const std::uint32_t fileCount = static_cast<std::uint32_t>(mFiles.size());
+            const std::uint32_t header[3] = {0x100, static_cast<std::uint32_t>(12 * fileCount + names.size()), fileCount};
+            const std::vector<char> hashes(8 * fileCount, 0);
+
+            boost::filesystem::ofstream stream(path, std::ios_base::binary);
+            stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+            stream.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint32_t));
+            stream.write(reinterpret_cast<const char*>(nameOffsets.data()), nameOffsets.size() * sizeof(std::uint32_t));
+            stream.write(names.data(), names.size());
+            stream.write(hashes.data(), hashes.size());
+            stream.write(data.data(), data.size());
+
+            return path;
+        }
+
+        static std::string readAll(const Files::IStreamPtr& stream)
+        {
+            return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        }
+    };
+
+    TEST_P(BsaFileTest, exists_should_be_case_insensitive)
+    {
+        Bsa::BSAFile bsa;
+        bsa.open(writeArchive(), GetParam());
+        EXPECT_EQ(bsa.isMemoryMapped(), GetParam());
+        EXPECT_TRUE(bsa.exists("meshes\\a.nif"));
+        EXPECT_TRUE(bsa.exists("MESHES\\A.NIF"));
+        EXPECT_TRUE(bsa.exists("textures\\b.dds"));
+        EXPECT_FALSE(bsa.exists("meshes\\b.nif"));
+        EXPECT_FALSE(bsa.exists(""));
+    }
+
+    TEST_P(BsaFileTest, get_file_should_return_file_contents)
+    {
+        Bsa::BSAFile bsa;
+        bsa.open(writeArchive(), GetParam());
+        for (const auto& file : mFiles)
+            EXPECT_EQ(readAll(bsa.getFile(file.first.c_str())), file.second);
+    }
+
+    TEST_P(BsaFileTest, file_streams_should_support_seeking)
+    {
+        Bsa::BSAFile bsa;
+        bsa.open(writeArchive(), GetParam());
+        const Files::IStreamPtr stream = bsa.getFile("textures\\b.dds");
+        stream->seekg(7);
+        EXPECT_EQ(readAll(stream), "file");
+    }
+
+    TEST_P(BsaFileTest, get_file_for_missing_file_should_throw)
+    {
+        Bsa::BSAFile bsa;
+        bsa.open(writeArchive(), GetParam());
+        EXPECT_THROW(bsa.getFile("meshes\\missing.nif"), std::runtime_error);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(MemoryMappedAndStreamed, BsaFileTest, Values(true, false));
+}
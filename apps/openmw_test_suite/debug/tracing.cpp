@@ -0,0 +1,87 @@
+#include <components/debug/tracing.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug;
+
+    struct DebugTracingTest : Test
+    {
+        const std::string mPath = (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("openmw-trace-%%%%-%%%%.json")).string();
+
+        ~DebugTracingTest()
+        {
+            stopTracing();
+            boost::filesystem::remove(mPath);
+        }
+
+        std::string read() const
+        {
+            std::ifstream stream(mPath);
+            return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+    };
+
+    TEST_F(DebugTracingTest, should_not_record_when_not_started)
+    {
+        EXPECT_FALSE(isTracing());
+        Debug::ScopedTrace trace("event", "test");
+        flushTrace();
+    }
+
+    TEST_F(DebugTracingTest, stop_should_write_json_array_of_complete_events)
+    {
+        startTracing(mPath);
+        EXPECT_TRUE(isTracing());
+        {
+            Debug::ScopedTrace trace("event", "test");
+        }
+        stopTracing();
+        EXPECT_FALSE(isTracing());
+        const std::string content = read();
+        EXPECT_THAT(content, StartsWith("[\n"));
+        EXPECT_THAT(content, EndsWith("\n]\n"));
+        EXPECT_THAT(content, HasSubstr(R"({"name":"event","cat":"test","ph":"X","ts":)"));
+    }
+
+    TEST_F(DebugTracingTest, flush_should_write_events_of_all_threads_with_names)
+    {
+        startTracing(mPath);
+        std::thread thread([]
+        {
+            setTraceThreadName("Worker \"1\"");
+            Debug::ScopedTrace trace("work", "test");
+        });
+        thread.join();
+        flushTrace();
+        const std::string content = read();
+        EXPECT_THAT(content, HasSubstr(R"("ph":"M")"));
+        EXPECT_THAT(content, HasSubstr(R"("args":{"name":"Worker \"1\""})"));
+        EXPECT_THAT(content, HasSubstr(R"({"name":"work","cat":"test")"));
+    }
+
+    TEST_F(DebugTracingTest, start_should_drop_events_recorded_before)
+    {
+        traceEvent("old", "test", std::chrono::steady_clock::now(), std::chrono::steady_clock::now());
+        startTracing(mPath);
+        stopTracing();
+        EXPECT_EQ(read(), "[\n\n]\n");
+    }
+
+    TEST_F(DebugTracingTest, start_should_throw_when_already_started)
+    {
+        startTracing(mPath);
+        EXPECT_THROW(startTracing(mPath), std::runtime_error);
+    }
+}
@@ -0,0 +1,179 @@
+#include "operators.hpp"
+
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/settings.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDbTest : Test
+    {
+        const osg::Vec3f mAgentHalfExtents {1, 2, 3};
+        const TilePosition mTilePosition {0, 0};
+        const std::size_t mGeneration = 0;
+        const std::size_t mRevision = 0;
+        const std::vector<int> mIndices {{0, 1, 2}};
+        const std::vector<float> mVertices {{0, 0, 0, 1, 0, 0, 1, 1, 0}};
+        const std::vector<AreaType> mAreaTypes {1, AreaType_ground};
+        const std::vector<RecastMesh::Water> mWater {};
+        const std::size_t mTrianglesPerChunk {1};
+        const RecastMesh mRecastMesh {mGeneration, mRevision, mIndices, mVertices,
+                                      mAreaTypes, mWater, mTrianglesPerChunk};
+        const std::vector<OffMeshConnection> mOffMeshConnections {};
+        unsigned char mData[3] = {1, 2, 3};
+        const NavMeshDataRef mNavMeshDataRef {mData, 3};
+        Settings mSettings;
+        std::string mPath;
+
+        void SetUp() override
+        {
+            mSettings.mMaxNavMeshDiskCacheSize = std::numeric_limits<std::size_t>::max();
+            mPath = (boost::filesystem::temp_directory_path()
+                / (std::string(UnitTest::GetInstance()->current_test_info()->name()) + ".navmeshdb")).string();
+            boost::filesystem::remove_all(mPath);
+        }
+
+        void TearDown() override
+        {
+            boost::filesystem::remove_all(mPath);
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_from_empty_db_should_return_empty_value)
+    {
+        NavMeshDb db(mPath, mSettings);
+        EXPECT_FALSE(db.getTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_should_return_stored_value)
+    {
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        const auto result = db.getTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections);
+        ASSERT_TRUE(result);
+        ASSERT_EQ(result->mSize, 3);
+        EXPECT_EQ(std::memcmp(result->mValue.get(), mData, 3), 0);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, stored_value_should_be_available_for_other_db_instance)
+    {
+        NavMeshDb(mPath, mSettings).putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections,
+                                            mNavMeshDataRef);
+        NavMeshDb db(mPath, mSettings);
+        EXPECT_TRUE(db.getTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_for_other_recast_mesh_should_return_empty_value)
+    {
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        const std::vector<float> vertices {{0, 0, 0, 1, 0, 0, 1, 2, 0}};
+        const RecastMesh recastMesh(mGeneration, mRevision, mIndices, vertices, mAreaTypes, mWater, mTrianglesPerChunk);
+        EXPECT_FALSE(db.getTile(mAgentHalfExtents, mTilePosition, recastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_should_not_depend_on_triangles_and_off_mesh_connections_order)
+    {
+        const std::vector<int> indices {{0, 1, 2, 3, 4, 5}};
+        const std::vector<float> vertices {{0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 1, 1, 1}};
+        const std::vector<AreaType> areaTypes {AreaType_ground, AreaType_water};
+        const std::vector<OffMeshConnection> offMeshConnections {
+            {osg::Vec3f(0, 0, 0), osg::Vec3f(1, 1, 1), AreaType_door},
+            {osg::Vec3f(2, 2, 2), osg::Vec3f(3, 3, 3), AreaType_door},
+        };
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, mTilePosition,
+                   RecastMesh(mGeneration, mRevision, indices, vertices, areaTypes, mWater, mTrianglesPerChunk),
+                   offMeshConnections, mNavMeshDataRef);
+        const std::vector<int> reorderedIndices {{3, 4, 5, 0, 1, 2}};
+        const std::vector<AreaType> reorderedAreaTypes {AreaType_water, AreaType_ground};
+        const std::vector<OffMeshConnection> reorderedOffMeshConnections {offMeshConnections[1], offMeshConnections[0]};
+        EXPECT_TRUE(db.getTile(mAgentHalfExtents, mTilePosition,
+                               RecastMesh(mGeneration, mRevision, reorderedIndices, vertices, reorderedAreaTypes,
+                                          mWater, mTrianglesPerChunk),
+                               reorderedOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_for_other_area_types_should_return_empty_value)
+    {
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        const std::vector<AreaType> areaTypes {1, AreaType_water};
+        const RecastMesh recastMesh(mGeneration, mRevision, mIndices, mVertices, areaTypes, mWater, mTrianglesPerChunk);
+        EXPECT_FALSE(db.getTile(mAgentHalfExtents, mTilePosition, recastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_for_other_agent_should_return_empty_value)
+    {
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        EXPECT_FALSE(db.getTile(osg::Vec3f(1, 1, 1), mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_with_other_settings_should_return_empty_value)
+    {
+        NavMeshDb(mPath, mSettings).putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections,
+                                            mNavMeshDataRef);
+        Settings settings = mSettings;
+        settings.mTileSize = 64;
+        NavMeshDb db(mPath, settings);
+        EXPECT_FALSE(db.getTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, put_tile_should_remove_least_recently_used_files_when_size_is_over_limit)
+    {
+        NavMeshDb(mPath, mSettings).putTile(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections,
+                                            mNavMeshDataRef);
+        mSettings.mMaxNavMeshDiskCacheSize = 2 * NavMeshDb(mPath, mSettings).getSize();
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        EXPECT_TRUE(db.getTile(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections));
+        db.putTile(mAgentHalfExtents, TilePosition(0, 2), mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        EXPECT_EQ(db.getSize(), mSettings.mMaxNavMeshDiskCacheSize);
+        EXPECT_TRUE(db.getTile(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections));
+        EXPECT_FALSE(db.getTile(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections));
+        EXPECT_TRUE(db.getTile(mAgentHalfExtents, TilePosition(0, 2), mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, put_tile_bigger_than_size_limit_should_not_store_it)
+    {
+        mSettings.mMaxNavMeshDiskCacheSize = sizeof(mData);
+        NavMeshDb db(mPath, mSettings);
+        db.putTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+        EXPECT_EQ(db.getSize(), 0);
+        EXPECT_FALSE(db.getTile(mAgentHalfExtents, mTilePosition, mRecastMesh, mOffMeshConnections));
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, constructor_should_remove_files_over_size_limit)
+    {
+        {
+            NavMeshDb db(mPath, mSettings);
+            db.putTile(mAgentHalfExtents, TilePosition(0, 0), mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+            db.putTile(mAgentHalfExtents, TilePosition(0, 1), mRecastMesh, mOffMeshConnections, mNavMeshDataRef);
+            mSettings.mMaxNavMeshDiskCacheSize = db.getSize() / 2;
+        }
+        NavMeshDb db(mPath, mSettings);
+        EXPECT_EQ(db.getSize(), mSettings.mMaxNavMeshDiskCacheSize);
+        EXPECT_EQ(std::distance(boost::filesystem::directory_iterator(mPath), boost::filesystem::directory_iterator()), 1);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, constructor_should_remove_temporary_files)
+    {
+        boost::filesystem::create_directories(mPath);
+        boost::filesystem::ofstream(boost::filesystem::path(mPath) / "0_0_0000000000000000.navmeshtile.1.0.tmp") << "data";
+        NavMeshDb db(mPath, mSettings);
+        EXPECT_EQ(db.getSize(), 0);
+        EXPECT_TRUE(boost::filesystem::is_empty(mPath));
+    }
+}
@@ -0,0 +1,101 @@
+#include <components/esm/compressedrecords.hpp>
+#include <components/esm/defs.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    struct ESMCompressedRecordsTest : Test
+    {
+        std::vector<std::string> mValues {"first", "second", std::string(100000, 'x'), "last"};
+
+        std::string write(std::size_t& firstRecordEnd) const
+        {
+            std::stringstream stream;
+            ESM::ESMWriter writer;
+            writer.setFormat(16);
+            writer.setVersion(0);
+            writer.setType(0);
+            writer.setAuthor("");
+            writer.setDescription("");
+            writer.setRecordCount(static_cast<int>(mValues.size()));
+            writer.save(stream);
+            for (std::size_t i = 0; i < mValues.size(); ++i)
+            {
+                writer.startRecord(ESM::REC_GLOB);
+                writer.writeHNString("NAME", mValues[i]);
+                writer.endRecord(ESM::REC_GLOB);
+                if (i == 0)
+                    firstRecordEnd = static_cast<std::size_t>(stream.tellp());
+            }
+            writer.close();
+            return stream.str();
+        }
+
+        std::vector<std::string> read(const std::string& data, std::vector<std::size_t>& offsets) const
+        {
+            ESM::ESMReader reader;
+            reader.open(std::make_shared<std::istringstream>(data), "test");
+            std::vector<std::string> result;
+            while (reader.hasMoreRecs())
+            {
+                EXPECT_EQ(reader.getRecName().intval, ESM::REC_GLOB);
+                reader.getRecHeader();
+                result.push_back(reader.getHNString("NAME"));
+                offsets.push_back(reader.getFileOffset());
+                EXPECT_LE(reader.getFileOffset(), reader.getFileSize());
+            }
+            return result;
+        }
+    };
+
+    TEST_F(ESMCompressedRecordsTest, records_after_offset_should_be_read_transparently)
+    {
+        std::size_t firstRecordEnd = 0;
+        const std::string uncompressed = write(firstRecordEnd);
+        std::string compressed = uncompressed;
+        ESM::compressRecords(compressed, firstRecordEnd);
+        EXPECT_LT(compressed.size(), uncompressed.size());
+        EXPECT_EQ(compressed.substr(0, firstRecordEnd), uncompressed.substr(0, firstRecordEnd));
+
+        std::vector<std::size_t> uncompressedOffsets;
+        std::vector<std::size_t> compressedOffsets;
+        EXPECT_EQ(read(uncompressed, uncompressedOffsets), mValues);
+        EXPECT_EQ(read(compressed, compressedOffsets), mValues);
+        EXPECT_EQ(compressedOffsets, uncompressedOffsets);
+    }
+
+    TEST_F(ESMCompressedRecordsTest, nothing_should_be_compressed_after_end_of_data)
+    {
+        std::size_t firstRecordEnd = 0;
+        const std::string uncompressed = write(firstRecordEnd);
+        std::string data = uncompressed;
+        ESM::compressRecords(data, data.size());
+        EXPECT_EQ(data, uncompressed);
+    }
+
+    TEST_F(ESMCompressedRecordsTest, damaged_compressed_records_should_fail_to_read)
+    {
+        std::size_t firstRecordEnd = 0;
+        std::string data = write(firstRecordEnd);
+        ESM::compressRecords(data, firstRecordEnd);
+        data[data.size() - 8] ^= 0x55;
+
+        std::vector<std::size_t> offsets;
+        ESM::ESMReader reader;
+        reader.open(std::make_shared<std::istringstream>(data), "test");
+        reader.getRecName();
+        reader.getRecHeader();
+        reader.getHNString("NAME");
+        EXPECT_THROW(reader.getRecName(), std::runtime_error);
+    }
+}
@@ -0,0 +1,63 @@
+#include <components/misc/internedstring.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using Misc::InternedString;
+
+    TEST(MiscInternedStringTest, default_constructed_should_be_null)
+    {
+        EXPECT_TRUE(InternedString().isNull());
+        EXPECT_EQ(InternedString().str(), "");
+        EXPECT_NE(InternedString(), InternedString(""));
+    }
+
+    TEST(MiscInternedStringTest, should_be_equal_for_case_insensitively_equal_strings)
+    {
+        const InternedString value("Bip01 Head");
+        EXPECT_EQ(value, InternedString("BIP01 HEAD"));
+        EXPECT_EQ(value.str(), "bip01 head");
+        EXPECT_EQ(&value.str(), &InternedString("bip01 head").str());
+        EXPECT_NE(value, InternedString("Bip01 Neck"));
+    }
+
+    TEST(MiscInternedStringTest, find_should_not_intern)
+    {
+        EXPECT_TRUE(InternedString::find("MiscInternedStringTest not interned").isNull());
+        EXPECT_TRUE(InternedString::find("MiscInternedStringTest not interned").isNull());
+        const InternedString value("MiscInternedStringTest interned");
+        EXPECT_EQ(InternedString::find("MISCINTERNEDSTRINGTEST INTERNED"), value);
+    }
+
+    TEST(MiscInternedStringTest, should_keep_values_valid_after_many_insertions)
+    {
+        const InternedString first("MiscInternedStringTest first");
+        const std::string* const address = &first.str();
+        for (int i = 0; i < 10000; ++i)
+            InternedString("MiscInternedStringTest " + std::to_string(i));
+        EXPECT_EQ(&InternedString("MiscInternedStringTest FIRST").str(), address);
+        EXPECT_EQ(*address, "miscinternedstringtest first");
+    }
+
+    TEST(MiscInternedStringTest, concurrent_interning_should_produce_equal_handles)
+    {
+        std::vector<std::vector<InternedString>> values(4);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < values.size(); ++i)
+            threads.emplace_back([&, i]
+            {
+                for (int j = 0; j < 1000; ++j)
+                    values[i].emplace_back((i % 2 == 0 ? "Concurrent " : "CONCURRENT ") + std::to_string(j));
+            });
+        for (std::thread& thread : threads)
+            thread.join();
+        for (std::size_t i = 1; i < values.size(); ++i)
+            EXPECT_EQ(values[i], values[0]);
+    }
+}
@@ -0,0 +1,115 @@
+#include <components/misc/slotmap.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    template <class T>
+    std::vector<T> getValues(const SlotMap<T>& map)
+    {
+        return std::vector<T>(map.begin(), map.end());
+    }
+
+    TEST(MiscSlotMapTest, get_should_return_inserted_value)
+    {
+        SlotMap<std::string> map;
+        const auto handle = map.emplace("value");
+        ASSERT_NE(map.get(handle), nullptr);
+        EXPECT_EQ(*map.get(handle), "value");
+        EXPECT_EQ(map.size(), 1u);
+    }
+
+    TEST(MiscSlotMapTest, get_should_return_nullptr_for_erased_value)
+    {
+        SlotMap<int> map;
+        const auto handle = map.emplace(1);
+        EXPECT_TRUE(map.erase(handle));
+        EXPECT_EQ(map.get(handle), nullptr);
+        EXPECT_FALSE(map.erase(handle));
+        EXPECT_TRUE(map.empty());
+    }
+
+    TEST(MiscSlotMapTest, handle_should_stay_invalid_when_slot_is_reused)
+    {
+        SlotMap<int> map;
+        const auto first = map.emplace(1);
+        map.erase(first);
+        const auto second = map.emplace(2);
+        EXPECT_EQ(second.mIndex, first.mIndex);
+        EXPECT_NE(second, first);
+        EXPECT_EQ(map.get(first), nullptr);
+        EXPECT_EQ(*map.get(second), 2);
+    }
+
+    TEST(MiscSlotMapTest, handle_should_be_invalid_after_clear)
+    {
+        SlotMap<int> map;
+        const auto first = map.emplace(1);
+        map.clear();
+        const auto second = map.emplace(2);
+        EXPECT_EQ(map.get(first), nullptr);
+        EXPECT_EQ(*map.get(second), 2);
+    }
+
+    TEST(MiscSlotMapTest, iteration_should_skip_erased_values_in_slot_order)
+    {
+        SlotMap<int> map;
+        map.emplace(1);
+        const auto handle = map.emplace(2);
+        map.emplace(3);
+        map.erase(handle);
+        EXPECT_THAT(getValues(map), ElementsAre(1, 3));
+        map.emplace(4);
+        EXPECT_THAT(getValues(map), ElementsAre(1, 4, 3));
+    }
+
+    TEST(MiscSlotMapTest, references_should_stay_valid_after_insertion)
+    {
+        SlotMap<int> map;
+        int& value = *map.get(map.emplace(42));
+        for (int i = 0; i < 10000; ++i)
+            map.emplace(i);
+        EXPECT_EQ(value, 42);
+    }
+
+    TEST(MiscSlotMapTest, iteration_should_visit_values_appended_during_iteration)
+    {
+        SlotMap<int> map;
+        map.emplace(1);
+        map.emplace(2);
+        std::vector<int> visited;
+        for (auto it = map.begin(); it != map.end(); ++it)
+        {
+            visited.push_back(*it);
+            if (*it == 1)
+                map.emplace(3);
+        }
+        EXPECT_THAT(visited, ElementsAre(1, 2, 3));
+    }
+
+    TEST(MiscSlotMapTest, iterator_should_provide_handle)
+    {
+        SlotMap<int> map;
+        map.emplace(1);
+        const auto handle = map.emplace(2);
+        auto it = map.begin();
+        ++it;
+        EXPECT_EQ(it.getHandle(), handle);
+    }
+
+    TEST(MiscSlotMapTest, find_should_return_end_for_erased_value)
+    {
+        SlotMap<int> map;
+        const auto handle = map.emplace(1);
+        EXPECT_EQ(*map.find(handle), 1);
+        map.erase(handle);
+        EXPECT_EQ(map.find(handle), map.end());
+    }
+}
@@ -0,0 +1,102 @@
+#include <components/misc/spatialhash.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    std::vector<int> getInRange(const SpatialHash<int>& grid, const osg::Vec3f& position, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachInRange(position, radius, [&] (int value, const osg::Vec3f&) { result.push_back(value); });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    TEST(MiscSpatialHashTest, empty_grid_should_find_nothing)
+    {
+        SpatialHash<int> grid(128);
+        grid.build();
+        EXPECT_THAT(getInRange(grid, osg::Vec3f(0, 0, 0), 1000), IsEmpty());
+    }
+
+    TEST(MiscSpatialHashTest, should_find_values_within_radius_in_3d)
+    {
+        SpatialHash<int> grid(128);
+        grid.insert(osg::Vec3f(0, 0, 0), 1);
+        grid.insert(osg::Vec3f(100, 0, 0), 2);
+        grid.insert(osg::Vec3f(0, 0, 150), 3);
+        grid.insert(osg::Vec3f(-300, -300, 0), 4);
+        grid.build();
+        EXPECT_THAT(getInRange(grid, osg::Vec3f(0, 0, 0), 100), ElementsAre(1, 2));
+        EXPECT_THAT(getInRange(grid, osg::Vec3f(0, 0, 0), 150), ElementsAre(1, 2, 3));
+        EXPECT_THAT(getInRange(grid, osg::Vec3f(-290, -290, 0), 20), ElementsAre(4));
+    }
+
+    TEST(MiscSpatialHashTest, should_visit_values_of_one_cell_in_insertion_order)
+    {
+        SpatialHash<int> grid(1000);
+        for (int i = 0; i < 10; ++i)
+            grid.insert(osg::Vec3f(static_cast<float>(10 - i), 0, 0), i);
+        grid.build();
+        std::vector<int> result;
+        grid.forEachInRange(osg::Vec3f(0, 0, 0), 100, [&] (int value, const osg::Vec3f&) { result.push_back(value); });
+        EXPECT_THAT(result, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+    }
+
+    TEST(MiscSpatialHashTest, clear_should_remove_all_values)
+    {
+        SpatialHash<int> grid(128);
+        grid.insert(osg::Vec3f(0, 0, 0), 1);
+        grid.build();
+        grid.clear();
+        EXPECT_FALSE(grid.isBuilt());
+        EXPECT_EQ(grid.size(), 0u);
+        grid.build();
+        EXPECT_THAT(getInRange(grid, osg::Vec3f(0, 0, 0), 100), IsEmpty());
+    }
+
+    TEST(MiscSpatialHashTest, should_support_infinite_radius)
+    {
+        SpatialHash<int> grid(128);
+        grid.insert(osg::Vec3f(-1e6f, 1e6f, 0), 1);
+        grid.insert(osg::Vec3f(1e6f, -1e6f, 0), 2);
+        grid.build();
+        EXPECT_THAT(getInRange(grid, osg::Vec3f(0, 0, 0), std::numeric_limits<float>::max()), ElementsAre(1, 2));
+    }
+
+    TEST(MiscSpatialHashTest, should_find_same_values_as_linear_search)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-4096, 4096);
+        std::vector<osg::Vec3f> positions;
+        SpatialHash<int> grid(512);
+        for (int i = 0; i < 1000; ++i)
+        {
+            positions.emplace_back(distribution(random), distribution(random), distribution(random) / 8);
+            grid.insert(positions.back(), i);
+        }
+        grid.build();
+
+        for (float radius : {0.f, 50.f, 200.f, 511.f, 512.f, 2000.f, 10000.f})
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                const osg::Vec3f position(distribution(random), distribution(random), 0);
+                std::vector<int> expected;
+                for (std::size_t j = 0; j < positions.size(); ++j)
+                    if ((positions[j] - position).length2() <= radius * radius)
+                        expected.push_back(static_cast<int>(j));
+                EXPECT_EQ(getInRange(grid, position, radius), expected) << radius;
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#include "apps/openmw/mwdialogue/infoindex.hpp"
+
+#include <components/esm/loaddial.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWDialogue;
+
+    struct MWDialogueInfoIndexTest : Test
+    {
+        ESM::Dialogue mDialogue;
+
+        ESM::DialInfo& addInfo(const std::string& id)
+        {
+            ESM::DialInfo& info = mDialogue.mInfo.emplace_back();
+            info.blank();
+            info.mId = id;
+            info.mData.mGender = ESM::DialInfo::NA;
+            return info;
+        }
+
+        static InfoIndexActor makeNpc()
+        {
+            InfoIndexActor actor;
+            actor.mId = "npc";
+            actor.mIsNpc = true;
+            actor.mRace = "Dark Elf";
+            actor.mClass = "Guard";
+            actor.mFaction = "Hlaalu";
+            return actor;
+        }
+
+        static std::vector<std::string> getIds(const std::vector<const ESM::DialInfo*>& infos)
+        {
+            std::vector<std::string> result;
+            for (const ESM::DialInfo* info : infos)
+                result.push_back(info->mId);
+            return result;
+        }
+    };
+
+    TEST_F(MWDialogueInfoIndexTest, creature_should_get_only_infos_for_its_id)
+    {
+        addInfo("any");
+        addInfo("creature").mActor = "Creature";
+        addInfo("other").mActor = "other";
+        InfoIndexActor actor;
+        actor.mId = "creature";
+        const InfoIndex index(mDialogue);
+        EXPECT_THAT(getIds(index.getCandidates(actor, nullptr)), ElementsAre("creature"));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, npc_should_get_matching_infos_in_topic_order)
+    {
+        addInfo("other race").mRace = "Nord";
+        addInfo("class").mClass = "guard";
+        addInfo("any");
+        addInfo("race").mRace = "dark elf";
+        addInfo("other faction").mFaction = "Redoran";
+        addInfo("faction").mFaction = "HLAALU";
+        addInfo("actor").mActor = "NPC";
+        addInfo("factionless").mFactionLess = true;
+        const InfoIndex index(mDialogue);
+        EXPECT_THAT(getIds(index.getCandidates(makeNpc(), nullptr)),
+                    ElementsAre("class", "any", "race", "faction", "actor"));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, factionless_infos_should_be_used_for_npc_without_faction)
+    {
+        addInfo("faction").mFaction = "Hlaalu";
+        addInfo("factionless").mFactionLess = true;
+        InfoIndexActor actor = makeNpc();
+        actor.mFaction.clear();
+        const InfoIndex index(mDialogue);
+        EXPECT_THAT(getIds(index.getCandidates(actor, nullptr)), ElementsAre("factionless"));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, cell_should_match_player_cell_prefix)
+    {
+        addInfo("balmora").mCell = "Balmora";
+        addInfo("guild").mCell = "balmora, guild of mages";
+        addInfo("vivec").mCell = "Vivec";
+        const InfoIndex index(mDialogue);
+        const std::string playerCell = "Balmora, Council Club";
+        EXPECT_THAT(getIds(index.getCandidates(makeNpc(), &playerCell)), ElementsAre("balmora"));
+        EXPECT_THAT(getIds(index.getCandidates(makeNpc(), nullptr)), ElementsAre("balmora", "guild", "vivec"));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, npc_should_not_get_infos_for_other_gender)
+    {
+        addInfo("male").mData.mGender = ESM::DialInfo::Male;
+        addInfo("female").mData.mGender = ESM::DialInfo::Female;
+        addInfo("any");
+        InfoIndexActor actor = makeNpc();
+        actor.mIsFemale = true;
+        const InfoIndex index(mDialogue);
+        EXPECT_THAT(getIds(index.getCandidates(actor, nullptr)), ElementsAre("female", "any"));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, indices_should_be_rebuilt_after_clear)
+    {
+        addInfo("first");
+        InfoIndices indices;
+        const InfoIndex& index = indices.get(mDialogue);
+        EXPECT_EQ(&indices.get(mDialogue), &index);
+        EXPECT_THAT(getIds(index.getCandidates(makeNpc(), nullptr)), ElementsAre("first"));
+        addInfo("second");
+        indices.clear();
+        EXPECT_THAT(getIds(indices.get(mDialogue).getCandidates(makeNpc(), nullptr)), ElementsAre("first", "second"));
+    }
+}
@@ -65,3 +65,27 @@ TEST_F(KeywordSearchTest, keyword_test_conflict_resolution3)
     ASSERT_TRUE (matches.size() == 1);
     ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "bar lock");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_prefix_of_other_keyword)
+{
+    // a keyword may be a prefix of another keyword, the longest one matching at a position is chosen
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("dwemer", 1);
+    search.seed("dwemer ruins", 2);
+
+    std::string text = "Dwemer ruins of the dwemer";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 2);
+    ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "Dwemer ruins");
+    ASSERT_TRUE (matches.front().mValue == 2);
+    ASSERT_TRUE (std::string(matches.rbegin()->mBeg, matches.rbegin()->mEnd) == "dwemer");
+    ASSERT_TRUE (matches.rbegin()->mValue == 1);
+
+    int value = 0;
+    ASSERT_TRUE (search.containsKeyword("Dwemer", value));
+    ASSERT_TRUE (value == 1);
+    ASSERT_FALSE (search.containsKeyword("dwemer r", value));
+}
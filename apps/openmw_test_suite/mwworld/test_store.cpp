@@ -318,3 +318,224 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that records are iterated in the order they were inserted and are found regardless of letter case.
+TEST_F(StoreTest, insertion_order_and_case_insensitive_search_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    MWWorld::Store<RecordType> store;
+
+    const std::vector<std::string> staticIds {"zeta", "Alpha", "mid"};
+    for (const std::string& id : staticIds)
+    {
+        RecordType record;
+        record.blank();
+        record.mId = id;
+        store.insertStatic(record);
+    }
+
+    RecordType dynamic;
+    dynamic.blank();
+    dynamic.mId = "Dynamic";
+    const RecordType* inserted = store.insert(dynamic);
+
+    std::vector<std::string> ids;
+    for (const RecordType& record : store)
+        ids.push_back(record.mId);
+
+    EXPECT_EQ(ids, (std::vector<std::string> {"zeta", "Alpha", "mid", "Dynamic"}));
+    EXPECT_EQ(store.search("ALPHA"), store.searchStatic("alpha"));
+    ASSERT_NE(store.search("alpha"), nullptr);
+    EXPECT_EQ(store.search("dynamic"), inserted);
+    EXPECT_TRUE(store.isDynamic("DYNAMIC"));
+    EXPECT_EQ(store.search("missing"), nullptr);
+
+    ASSERT_TRUE(store.eraseStatic("ZETA"));
+    EXPECT_EQ(store.search("zeta"), nullptr);
+    ASSERT_TRUE(store.erase("dynamic"));
+    EXPECT_EQ(store.search("dynamic"), nullptr);
+
+    ids.clear();
+    for (const RecordType& record : store)
+        ids.push_back(record.mId);
+
+    EXPECT_EQ(ids, (std::vector<std::string> {"Alpha", "mid"}));
+    EXPECT_EQ(store.getSize(), 2);
+    EXPECT_EQ(store.getDynamicSize(), 0);
+}
+
+/// Tests that loading records parsed in advance gives the same result as loading them sequentially.
+TEST_F(StoreTest, parsed_load_test)
+{
+    ESM::ESMWriter writer;
+    auto* stream = new std::stringstream;
+    writer.setFormat(0);
+    writer.save(*stream);
+    for (const std::string& id : {"Foo", "bar", "FOO"})
+    {
+        ESM::Apparatus record;
+        record.blank();
+        record.mId = id;
+        record.mModel = id + ".nif";
+        writer.startRecord(ESM::Apparatus::sRecordId);
+        record.save(writer, id == "bar");
+        writer.endRecord(ESM::Apparatus::sRecordId);
+    }
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "Topic";
+    dialogue.mType = ESM::Dialogue::Topic;
+    writer.startRecord(ESM::Dialogue::sRecordId);
+    dialogue.save(writer);
+    writer.endRecord(ESM::Dialogue::sRecordId);
+    const std::string data = stream->str();
+    delete stream;
+
+    std::vector<ESM::ESMReader> readerList(1);
+    readerList[0].setGlobalReaderList(&readerList);
+    readerList[0].open(Files::IStreamPtr(new std::stringstream(data)), "filename");
+    mEsmStore.load(readerList[0], &dummyListener);
+    mEsmStore.setUp();
+
+    ESM::ESMReader parseReader;
+    parseReader.open(Files::IStreamPtr(new std::stringstream(data)), "filename");
+    MWWorld::ESMStore parsedStore;
+    std::vector<std::unique_ptr<MWWorld::ParsedRecord>> parsed = parsedStore.parse(parseReader);
+    ASSERT_EQ(parsed.size(), 4);
+    EXPECT_EQ(parsed[3], nullptr);
+
+    std::vector<ESM::ESMReader> parsedReaderList(1);
+    parsedReaderList[0].setGlobalReaderList(&parsedReaderList);
+    parsedReaderList[0].open(Files::IStreamPtr(new std::stringstream(data)), "filename");
+    parsedStore.load(parsedReaderList[0], &dummyListener, parsed);
+    parsedStore.setUp();
+
+    const auto& expected = mEsmStore.get<ESM::Apparatus>();
+    const auto& actual = parsedStore.get<ESM::Apparatus>();
+    ASSERT_EQ(actual.getSize(), expected.getSize());
+    for (auto expectedIt = expected.begin(), actualIt = actual.begin(); expectedIt != expected.end(); ++expectedIt, ++actualIt)
+    {
+        EXPECT_EQ(actualIt->mId, expectedIt->mId);
+        EXPECT_EQ(actualIt->mModel, expectedIt->mModel);
+    }
+    EXPECT_EQ(actual.search("bar"), nullptr);
+    ASSERT_NE(actual.search("foo"), nullptr);
+    EXPECT_EQ(actual.search("foo")->mModel, "FOO.nif");
+    EXPECT_NE(parsedStore.get<ESM::Dialogue>().search("topic"), nullptr);
+}
+
+TEST_F(StoreTest, snapshot_test)
+{
+    ESM::ESMWriter writer;
+    auto* stream = new std::stringstream;
+    writer.setFormat(0);
+    writer.save(*stream);
+    for (const std::string& id : {"Foo", "bar", "Baz"})
+    {
+        ESM::Apparatus record;
+        record.blank();
+        record.mId = id;
+        record.mModel = id + ".nif";
+        writer.startRecord(ESM::Apparatus::sRecordId);
+        record.save(writer, id == "bar");
+        writer.endRecord(ESM::Apparatus::sRecordId);
+    }
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "Topic";
+    dialogue.mType = ESM::Dialogue::Topic;
+    writer.startRecord(ESM::Dialogue::sRecordId);
+    dialogue.save(writer);
+    writer.endRecord(ESM::Dialogue::sRecordId);
+    for (const std::string& id : {"1", "2"})
+    {
+        ESM::DialInfo info;
+        info.blank();
+        info.mId = id;
+        info.mResponse = "Response " + id;
+        writer.startRecord(ESM::DialInfo::sRecordId);
+        info.save(writer, id == "2");
+        writer.endRecord(ESM::DialInfo::sRecordId);
+    }
+    ESM::Cell cell;
+    cell.blank();
+    cell.mName = "Room";
+    cell.mData.mFlags = ESM::Cell::Interior;
+    cell.mWater = 1.5f;
+    writer.startRecord(ESM::Cell::sRecordId);
+    cell.save(writer);
+    ESM::CellRef ref;
+    ref.blank();
+    ref.mRefNum.mIndex = 1;
+    ref.mRefID = "foo";
+    ref.save(writer);
+    writer.endRecord(ESM::Cell::sRecordId);
+    ESM::LandTexture texture;
+    texture.mId = "Texture";
+    texture.mIndex = 2;
+    texture.mTexture = "texture.dds";
+    writer.startRecord(ESM::LandTexture::sRecordId);
+    texture.save(writer);
+    writer.endRecord(ESM::LandTexture::sRecordId);
+    const std::string data = stream->str();
+    delete stream;
+
+    std::vector<ESM::ESMReader> readerList(1);
+    readerList[0].setGlobalReaderList(&readerList);
+    readerList[0].open(Files::IStreamPtr(new std::stringstream(data)), "filename");
+    mEsmStore.load(readerList[0], &dummyListener);
+
+    ESM::ESMWriter snapshotWriter;
+    auto* snapshotStream = new std::stringstream;
+    snapshotWriter.setFormat(0);
+    snapshotWriter.save(*snapshotStream);
+    mEsmStore.writeSnapshot(snapshotWriter);
+    snapshotWriter.close();
+
+    MWWorld::ESMStore snapshotStore;
+    ESM::ESMReader snapshotReader;
+    snapshotReader.open(Files::IStreamPtr(snapshotStream), "snapshot");
+    snapshotStore.loadSnapshot(snapshotReader, readerList.size(), &dummyListener);
+
+    mEsmStore.setUp();
+    snapshotStore.setUp();
+
+    const auto& expected = mEsmStore.get<ESM::Apparatus>();
+    const auto& actual = snapshotStore.get<ESM::Apparatus>();
+    ASSERT_EQ(actual.getSize(), 2);
+    ASSERT_EQ(actual.getSize(), expected.getSize());
+    for (auto expectedIt = expected.begin(), actualIt = actual.begin(); expectedIt != expected.end(); ++expectedIt, ++actualIt)
+    {
+        EXPECT_EQ(actualIt->mId, expectedIt->mId);
+        EXPECT_EQ(actualIt->mModel, expectedIt->mModel);
+    }
+
+    const ESM::Dialogue* actualDialogue = snapshotStore.get<ESM::Dialogue>().search("topic");
+    ASSERT_NE(actualDialogue, nullptr);
+    EXPECT_EQ(actualDialogue->mId, "Topic");
+    ASSERT_EQ(actualDialogue->mInfo.size(), 1);
+    EXPECT_EQ(actualDialogue->mInfo.front().mResponse, "Response 1");
+
+    const ESM::Cell* actualCell = snapshotStore.get<ESM::Cell>().search("room");
+    ASSERT_NE(actualCell, nullptr);
+    const ESM::Cell* expectedCell = mEsmStore.get<ESM::Cell>().search("room");
+    EXPECT_EQ(actualCell->mName, "Room");
+    EXPECT_EQ(actualCell->mWater, 1.5f);
+    ASSERT_EQ(actualCell->mContextList.size(), 1);
+    EXPECT_EQ(actualCell->mContextList[0].filename, expectedCell->mContextList[0].filename);
+    EXPECT_EQ(actualCell->mContextList[0].filePos, expectedCell->mContextList[0].filePos);
+    EXPECT_EQ(actualCell->mContextList[0].leftRec, expectedCell->mContextList[0].leftRec);
+
+    // References are read from the content file using the restored context
+    ESM::CellRef actualRef;
+    bool deleted = false;
+    actualCell->restore(readerList[0], 0);
+    ASSERT_TRUE(ESM::Cell::getNextRef(readerList[0], actualRef, deleted));
+    EXPECT_EQ(actualRef.mRefID, "foo");
+
+    const ESM::LandTexture* actualTexture = snapshotStore.get<ESM::LandTexture>().search(2, 0);
+    ASSERT_NE(actualTexture, nullptr);
+    EXPECT_EQ(actualTexture->mTexture, "texture.dds");
+    EXPECT_EQ(snapshotStore.get<ESM::LandTexture>().getSize(0), 3);
+}
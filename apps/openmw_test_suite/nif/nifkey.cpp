@@ -0,0 +1,127 @@
+#include <components/nif/niffile.hpp>
+#include <components/nif/data.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    struct NifKeyMapTest : Test
+    {
+        std::string mData;
+
+        void writeUInt(std::uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+                mData.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+
+        void writeFloat(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeUInt(bits);
+        }
+
+        void writeSizedString(const std::string& value)
+        {
+            writeUInt(static_cast<std::uint32_t>(value.size()));
+            mData += value;
+        }
+
+        void writeHeader()
+        {
+            mData = "NetImmerse File Format, Version 4.0.0.2\n";
+            writeUInt(Nif::NIFFile::VER_MW);
+            writeUInt(1); // Number of records
+            writeSizedString("NiFloatData");
+        }
+
+        void writeFooter()
+        {
+            writeUInt(1); // Number of roots
+            writeUInt(0);
+        }
+
+        void writeLinearKeys(const std::vector<std::pair<float, float>>& keys)
+        {
+            writeHeader();
+            writeUInt(static_cast<std::uint32_t>(keys.size()));
+            writeUInt(Nif::InterpolationType_Linear);
+            for (const auto& [time, value] : keys)
+            {
+                writeFloat(time);
+                writeFloat(value);
+            }
+            writeFooter();
+        }
+
+        std::shared_ptr<const Nif::FloatKeyMap> readKeys() const
+        {
+            const Nif::NIFFile file(std::make_shared<std::istringstream>(mData), "test.nif");
+            const auto record = dynamic_cast<const Nif::NiFloatData*>(file.getRoot());
+            if (record == nullptr)
+                return nullptr;
+            return record->mKeyList;
+        }
+    };
+
+    TEST_F(NifKeyMapTest, should_keep_sorted_keys_unchanged)
+    {
+        writeLinearKeys({{0, 1}, {1, 2}, {2, 3}});
+        const auto keys = readKeys();
+        ASSERT_NE(keys, nullptr);
+        EXPECT_EQ(keys->mInterpolationType, static_cast<unsigned>(Nif::InterpolationType_Linear));
+        EXPECT_THAT(keys->mTimes, ElementsAre(0, 1, 2));
+        EXPECT_THAT(keys->mValues, ElementsAre(1, 2, 3));
+    }
+
+    TEST_F(NifKeyMapTest, should_sort_out_of_order_keys_by_time)
+    {
+        writeLinearKeys({{2, 3}, {0, 1}, {3, 4}, {1, 2}});
+        const auto keys = readKeys();
+        ASSERT_NE(keys, nullptr);
+        EXPECT_THAT(keys->mTimes, ElementsAre(0, 1, 2, 3));
+        EXPECT_THAT(keys->mValues, ElementsAre(1, 2, 3, 4));
+    }
+
+    TEST_F(NifKeyMapTest, should_keep_last_key_for_duplicate_times)
+    {
+        writeLinearKeys({{0, 1}, {1, 2}, {1, 5}, {2, 3}, {1, 7}});
+        const auto keys = readKeys();
+        ASSERT_NE(keys, nullptr);
+        EXPECT_THAT(keys->mTimes, ElementsAre(0, 1, 2));
+        EXPECT_THAT(keys->mValues, ElementsAre(1, 7, 3));
+    }
+
+    TEST_F(NifKeyMapTest, should_sort_quadratic_key_tangents_with_values)
+    {
+        writeHeader();
+        writeUInt(3);
+        writeUInt(Nif::InterpolationType_Quadratic);
+        for (const float time : {2.f, 0.f, 1.f})
+        {
+            writeFloat(time);
+            writeFloat(time * 10); // Value
+            writeFloat(time * 100); // In tangent
+            writeFloat(time * 1000); // Out tangent
+        }
+        writeFooter();
+        const auto keys = readKeys();
+        ASSERT_NE(keys, nullptr);
+        EXPECT_THAT(keys->mTimes, ElementsAre(0, 1, 2));
+        EXPECT_THAT(keys->mValues, ElementsAre(0, 10, 20));
+        EXPECT_THAT(keys->mInTans, ElementsAre(0, 100, 200));
+        EXPECT_THAT(keys->mOutTans, ElementsAre(0, 1000, 2000));
+    }
+}
@@ -0,0 +1,92 @@
+#include <components/nif/niffile.hpp>
+#include <components/nif/extra.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+
+    struct NifStreamTest : Test
+    {
+        std::string mData;
+
+        void writeUInt(std::uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+                mData.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+
+        void writeSizedString(const std::string& value)
+        {
+            writeUInt(static_cast<std::uint32_t>(value.size()));
+            mData += value;
+        }
+
+        void writeFile(const std::string& extra)
+        {
+            mData = "NetImmerse File Format, Version 4.0.0.2\n";
+            writeUInt(Nif::NIFFile::VER_MW);
+            writeUInt(1); // Number of records
+            writeSizedString("NiStringExtraData");
+            writeUInt(0xffffffff); // Next extra data
+            writeUInt(0); // Record size
+            writeSizedString(extra);
+            writeUInt(1); // Number of roots
+            writeUInt(0);
+        }
+
+        Files::IStreamPtr getStream() const
+        {
+            return std::make_shared<std::istringstream>(mData);
+        }
+    };
+
+    TEST_F(NifStreamTest, should_read_records_from_whole_stream)
+    {
+        writeFile("extra");
+        const Nif::NIFFile file(getStream(), "test.nif");
+        EXPECT_EQ(file.getVersion(), Nif::NIFFile::VER_MW);
+        ASSERT_EQ(file.numRecords(), 1u);
+        ASSERT_EQ(file.numRoots(), 1u);
+        const auto record = dynamic_cast<const Nif::NiStringExtraData*>(file.getRoot());
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->string, "extra");
+    }
+
+    TEST_F(NifStreamTest, sized_string_should_end_at_null_character)
+    {
+        writeFile(std::string("extra\0data", 10));
+        const Nif::NIFFile file(getStream(), "test.nif");
+        const auto record = dynamic_cast<const Nif::NiStringExtraData*>(file.getRoot());
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->string, "extra");
+    }
+
+    TEST_F(NifStreamTest, should_throw_on_truncated_stream)
+    {
+        writeFile("extra");
+        mData.resize(mData.size() - 2);
+        EXPECT_THROW(Nif::NIFFile(getStream(), "test.nif"), std::runtime_error);
+    }
+
+    TEST_F(NifStreamTest, should_throw_on_count_exceeding_stream_size_before_allocation)
+    {
+        mData = "NetImmerse File Format, Version 4.0.0.2\n";
+        writeUInt(Nif::NIFFile::VER_MW);
+        writeUInt(1); // Number of records
+        writeSizedString("NiIntegersExtraData");
+        writeUInt(0xffffffff); // Next extra data
+        writeUInt(0); // Record size
+        writeUInt(0x40000000); // Number of integers
+        writeUInt(1);
+        writeUInt(1); // Number of roots
+        writeUInt(0);
+        EXPECT_THROW(Nif::NIFFile(getStream(), "test.nif"), std::runtime_error);
+    }
+}
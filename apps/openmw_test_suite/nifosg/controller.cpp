@@ -0,0 +1,87 @@
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    struct NifOsgFloatInterpolatorTest : Test
+    {
+        const std::vector<float> mTimes {0, 1, 2, 3, 5};
+        const std::vector<float> mValues {0, 10, 20, 40, 80};
+        std::shared_ptr<Nif::FloatKeyMap> mKeys = std::make_shared<Nif::FloatKeyMap>();
+
+        NifOsgFloatInterpolatorTest()
+        {
+            mKeys->mInterpolationType = Nif::InterpolationType_Linear;
+            mKeys->mTimes = mTimes;
+            mKeys->mValues = mValues;
+        }
+
+        /// Reference linear interpolation with a plain search over all keys
+        float expected(float time) const
+        {
+            if (time <= mTimes.front())
+                return mValues.front();
+            if (time >= mTimes.back())
+                return mValues.back();
+            const std::size_t high = static_cast<std::size_t>(
+                std::lower_bound(mTimes.begin(), mTimes.end(), time) - mTimes.begin());
+            const std::size_t low = high - 1;
+            const float fraction = (time - mTimes[low]) / (mTimes[high] - mTimes[low]);
+            return mValues[low] + (mValues[high] - mValues[low]) * fraction;
+        }
+
+        void check(const FloatInterpolator& interpolator, const std::vector<float>& times) const
+        {
+            for (const float time : times)
+                EXPECT_FLOAT_EQ(interpolator.interpKey(time), expected(time)) << "time=" << time;
+        }
+    };
+
+    TEST_F(NifOsgFloatInterpolatorTest, empty_interpolator_should_return_default_value)
+    {
+        const FloatInterpolator interpolator(std::make_shared<Nif::FloatKeyMap>(), 42);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1), 42);
+    }
+
+    TEST_F(NifOsgFloatInterpolatorTest, should_interpolate_forward_time_sequence)
+    {
+        const FloatInterpolator interpolator(mKeys);
+        std::vector<float> times;
+        for (float time = -1; time <= 6; time += 0.125f)
+            times.push_back(time);
+        check(interpolator, times);
+    }
+
+    TEST_F(NifOsgFloatInterpolatorTest, should_interpolate_backward_time_sequence)
+    {
+        const FloatInterpolator interpolator(mKeys);
+        std::vector<float> times;
+        for (float time = 6; time >= -1; time -= 0.125f)
+            times.push_back(time);
+        check(interpolator, times);
+    }
+
+    TEST_F(NifOsgFloatInterpolatorTest, should_interpolate_looping_time_sequence)
+    {
+        const FloatInterpolator interpolator(mKeys);
+        std::vector<float> times;
+        for (int loop = 0; loop < 3; ++loop)
+            for (float time = 0; time < 5; time += 0.3f)
+                times.push_back(time);
+        check(interpolator, times);
+    }
+
+    TEST_F(NifOsgFloatInterpolatorTest, should_interpolate_at_key_times_and_after_jumps)
+    {
+        const FloatInterpolator interpolator(mKeys);
+        check(interpolator, {0, 1, 2, 3, 5, 3, 2.5f, 4.5f, 0.5f, 4, 1, 1.5f, 5, 0.25f});
+    }
+}
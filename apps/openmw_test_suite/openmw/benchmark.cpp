@@ -0,0 +1,66 @@
+#include "apps/openmw/benchmark.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    using namespace testing;
+    using namespace OMW;
+
+    TEST(OpenMWBenchmarkTest, read_camera_path_should_skip_empty_lines_and_comments)
+    {
+        std::istringstream stream("# frame x y z yaw\n\n0 1 2 3 90\n  \n10 4 5 6 180\n");
+        const std::vector<CameraPathPoint> path = readCameraPath(stream);
+        ASSERT_EQ(path.size(), 2u);
+        EXPECT_EQ(path[0].mFrame, 0u);
+        EXPECT_EQ(path[0].mPosition, osg::Vec3f(1, 2, 3));
+        EXPECT_FLOAT_EQ(path[0].mYaw, osg::PI_2);
+        EXPECT_EQ(path[1].mFrame, 10u);
+    }
+
+    TEST(OpenMWBenchmarkTest, read_camera_path_should_throw_on_invalid_line)
+    {
+        std::istringstream stream("0 1 2 3\n");
+        EXPECT_THROW(readCameraPath(stream), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkTest, read_camera_path_should_throw_on_not_increasing_frames)
+    {
+        std::istringstream stream("10 0 0 0 0\n10 1 1 1 0\n");
+        EXPECT_THROW(readCameraPath(stream), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkTest, get_camera_path_point_should_interpolate_between_points)
+    {
+        const std::vector<CameraPathPoint> path {{10, osg::Vec3f(0, 0, 0), 0}, {20, osg::Vec3f(10, 20, 30), 1}};
+        const CameraPathPoint point = getCameraPathPoint(path, 15);
+        EXPECT_EQ(point.mPosition, osg::Vec3f(5, 10, 15));
+        EXPECT_FLOAT_EQ(point.mYaw, 0.5f);
+    }
+
+    TEST(OpenMWBenchmarkTest, get_camera_path_point_should_clamp_to_path_ends)
+    {
+        const std::vector<CameraPathPoint> path {{10, osg::Vec3f(1, 1, 1), 0}, {20, osg::Vec3f(2, 2, 2), 1}};
+        EXPECT_EQ(getCameraPathPoint(path, 0).mPosition, osg::Vec3f(1, 1, 1));
+        EXPECT_EQ(getCameraPathPoint(path, 20).mPosition, osg::Vec3f(2, 2, 2));
+        EXPECT_EQ(getCameraPathPoint(path, 100).mPosition, osg::Vec3f(2, 2, 2));
+    }
+
+    TEST(OpenMWBenchmarkTest, timings_should_write_row_per_phase_in_milliseconds)
+    {
+        BenchmarkTimings timings;
+        timings.add("input", 0.001);
+        timings.add("physics", 0.004);
+        timings.add("input", 0.003);
+        std::ostringstream stream;
+        timings.write(stream);
+        EXPECT_EQ(stream.str(),
+            "phase\tframes\ttotal\tmean\tmedian\tp95\tmax\n"
+            "input\t2\t4.000\t2.000\t1.000\t1.000\t3.000\n"
+            "physics\t1\t4.000\t4.000\t4.000\t4.000\t4.000\n");
+    }
+}
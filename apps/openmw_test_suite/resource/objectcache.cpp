@@ -0,0 +1,87 @@
+#include <components/resource/objectcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <utility>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    struct ResourceObjectCacheTest : Test
+    {
+        osg::ref_ptr<ObjectCache> mCache {new ObjectCache};
+    };
+
+    TEST_F(ResourceObjectCacheTest, get_should_return_added_object)
+    {
+        osg::ref_ptr<osg::Object> object(new osg::Node);
+        mCache->addEntryToObjectCache("key", object.get());
+        EXPECT_EQ(mCache->getRefFromObjectCache("key").get(), object.get());
+        EXPECT_EQ(mCache->getRefFromObjectCache("other").get(), nullptr);
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, remove_should_remove_only_given_key)
+    {
+        mCache->addEntryToObjectCache("key", new osg::Node);
+        mCache->addEntryToObjectCache("other", new osg::Node);
+        mCache->removeFromObjectCache("key");
+        EXPECT_EQ(mCache->getRefFromObjectCache("key").get(), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("other").get(), nullptr);
+    }
+
+    TEST_F(ResourceObjectCacheTest, remove_expired_should_keep_objects_with_external_references)
+    {
+        osg::ref_ptr<osg::Object> referenced(new osg::Node);
+        for (int i = 0; i < 100; ++i)
+            mCache->addEntryToObjectCache(std::to_string(i), new osg::Node);
+        mCache->addEntryToObjectCache("referenced", referenced.get());
+
+        mCache->updateTimeStampOfObjectsInCacheWithExternalReferences(1);
+        mCache->updateTimeStampOfObjectsInCacheWithExternalReferences(2);
+        mCache->removeExpiredObjectsInCache(1);
+
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+        EXPECT_EQ(mCache->getRefFromObjectCache("referenced").get(), referenced.get());
+    }
+
+    TEST_F(ResourceObjectCacheTest, check_should_update_time_stamp)
+    {
+        mCache->addEntryToObjectCache("key", new osg::Node, 1);
+        EXPECT_TRUE(mCache->checkInObjectCache("key", 3));
+        EXPECT_FALSE(mCache->checkInObjectCache("other", 3));
+        mCache->removeExpiredObjectsInCache(2);
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, clear_should_remove_all_objects)
+    {
+        for (int i = 0; i < 100; ++i)
+            mCache->addEntryToObjectCache(std::to_string(i), new osg::Node);
+        mCache->clear();
+        EXPECT_EQ(mCache->getCacheSize(), 0u);
+    }
+
+    TEST(ResourceGenericObjectCacheTest, should_support_tuple_keys)
+    {
+        using Key = std::tuple<osg::Vec2f, float, bool>;
+        osg::ref_ptr<GenericObjectCache<Key>> cache(new GenericObjectCache<Key>);
+        cache->addEntryToObjectCache(Key(osg::Vec2f(1, 2), 3, true), new osg::Node);
+        EXPECT_NE(cache->getRefFromObjectCache(Key(osg::Vec2f(1, 2), 3, true)).get(), nullptr);
+        EXPECT_EQ(cache->getRefFromObjectCache(Key(osg::Vec2f(1, 2), 3, false)).get(), nullptr);
+    }
+
+    TEST(ResourceGenericObjectCacheTest, should_support_pair_keys)
+    {
+        using Key = std::pair<int, int>;
+        osg::ref_ptr<GenericObjectCache<Key>> cache(new GenericObjectCache<Key>);
+        for (int x = -10; x < 10; ++x)
+            for (int y = -10; y < 10; ++y)
+                cache->addEntryToObjectCache(Key(x, y), new osg::Node);
+        EXPECT_EQ(cache->getCacheSize(), 400u);
+        EXPECT_NE(cache->getRefFromObjectCache(Key(-3, 7)).get(), nullptr);
+    }
+}
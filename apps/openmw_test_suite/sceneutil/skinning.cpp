@@ -0,0 +1,105 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    template <class Array>
+    osg::ref_ptr<Array> makeArray(const typename Array::ElementDataType& value)
+    {
+        osg::ref_ptr<Array> result(new Array);
+        result->resize(4, value);
+        return result;
+    }
+
+    struct SceneUtilSkinningTest : Test
+    {
+        std::vector<std::pair<std::string, BoneInfluence>> mInfluences;
+        std::vector<osg::Matrixf> mBoneMatrices {osg::Matrixf::translate(1, 0, 0), osg::Matrixf::translate(0, 2, 0)};
+        SkinningSource mSource;
+        SkinningTarget mTarget;
+
+        SceneUtilSkinningTest()
+        {
+            BoneInfluence first;
+            first.mWeights = {{0, 1}, {1, 0.5f}, {2, 1}};
+            mInfluences.emplace_back("first", first);
+
+            BoneInfluence second;
+            second.mWeights = {{1, 0.5f}, {3, 1}};
+            mInfluences.emplace_back("second", second);
+
+            mSource.mPositions = makeArray<osg::Vec3Array>(osg::Vec3f(0, 0, 1));
+            mSource.mNormals = makeArray<osg::Vec3Array>(osg::Vec3f(0, 0, 1));
+            mSource.mTangents = makeArray<osg::Vec4Array>(osg::Vec4f(1, 0, 0, -1));
+
+            mTarget.mPositions = makeArray<osg::Vec3Array>(osg::Vec3f());
+            mTarget.mNormals = makeArray<osg::Vec3Array>(osg::Vec3f());
+            mTarget.mTangents = makeArray<osg::Vec4Array>(osg::Vec4f());
+        }
+    };
+
+    TEST_F(SceneUtilSkinningTest, make_skinning_data_should_group_vertices_with_equal_weights)
+    {
+        const osg::ref_ptr<SkinningData> data = makeSkinningData(mInfluences);
+        ASSERT_EQ(data->mGroups.size(), 3);
+        EXPECT_EQ(data->mWeights.size(), 4);
+        EXPECT_THAT(data->mVertices, ElementsAre(1, 0, 2, 3));
+
+        const SkinningData::Group& shared = data->mGroups[0];
+        EXPECT_EQ(shared.mWeightsEnd - shared.mWeightsBegin, 2);
+        EXPECT_EQ(shared.mVerticesEnd - shared.mVerticesBegin, 1);
+
+        const SkinningData::Group& first = data->mGroups[1];
+        EXPECT_EQ(first.mWeightsEnd - first.mWeightsBegin, 1);
+        EXPECT_EQ(data->mWeights[first.mWeightsBegin].mBone, 0);
+        EXPECT_EQ(first.mVerticesEnd - first.mVerticesBegin, 2);
+    }
+
+    TEST_F(SceneUtilSkinningTest, skin_should_blend_bone_matrices_by_weights)
+    {
+        skin(*makeSkinningData(mInfluences), mBoneMatrices, nullptr, mSource, mTarget);
+        EXPECT_EQ((*mTarget.mPositions)[0], osg::Vec3f(1, 0, 1));
+        EXPECT_EQ((*mTarget.mPositions)[1], osg::Vec3f(0.5f, 1, 1));
+        EXPECT_EQ((*mTarget.mPositions)[2], osg::Vec3f(1, 0, 1));
+        EXPECT_EQ((*mTarget.mPositions)[3], osg::Vec3f(0, 2, 1));
+    }
+
+    TEST_F(SceneUtilSkinningTest, skin_should_rotate_normals_and_tangents_and_keep_tangent_w)
+    {
+        mBoneMatrices[1] = osg::Matrixf::rotate(osg::PI_2, osg::Vec3f(0, 1, 0));
+        skin(*makeSkinningData(mInfluences), mBoneMatrices, nullptr, mSource, mTarget);
+        EXPECT_EQ((*mTarget.mNormals)[0], osg::Vec3f(0, 0, 1));
+        EXPECT_NEAR((*mTarget.mNormals)[3].x(), 1, 1e-6);
+        EXPECT_NEAR((*mTarget.mNormals)[3].z(), 0, 1e-6);
+        EXPECT_NEAR((*mTarget.mTangents)[3].z(), -1, 1e-6);
+        EXPECT_EQ((*mTarget.mTangents)[3].w(), -1);
+    }
+
+    TEST_F(SceneUtilSkinningTest, skin_should_ignore_weights_of_bones_with_zero_matrix)
+    {
+        mBoneMatrices[1] = osg::Matrixf(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        skin(*makeSkinningData(mInfluences), mBoneMatrices, nullptr, mSource, mTarget);
+        EXPECT_EQ((*mTarget.mPositions)[1], osg::Vec3f(0.5f, 0, 0.5f));
+    }
+
+    TEST_F(SceneUtilSkinningTest, skin_should_apply_geom_to_skeleton_matrix_after_bones)
+    {
+        const osg::Matrixf geomToSkel = osg::Matrixf::scale(2, 2, 2);
+        skin(*makeSkinningData(mInfluences), mBoneMatrices, &geomToSkel, mSource, mTarget);
+        EXPECT_EQ((*mTarget.mPositions)[0], osg::Vec3f(2, 0, 2));
+        EXPECT_EQ((*mTarget.mPositions)[3], osg::Vec3f(0, 4, 2));
+    }
+
+    TEST_F(SceneUtilSkinningTest, skin_should_skip_missing_optional_arrays)
+    {
+        mTarget.mNormals = nullptr;
+        mTarget.mTangents = nullptr;
+        skin(*makeSkinningData(mInfluences), mBoneMatrices, nullptr, mSource, mTarget);
+        EXPECT_EQ((*mTarget.mPositions)[3], osg::Vec3f(0, 2, 1));
+    }
+}
@@ -0,0 +1,158 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct Log
+    {
+        std::mutex mMutex;
+        std::vector<int> mValues;
+
+        void push(int value)
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mValues.push_back(value);
+        }
+    };
+
+    struct LogItem : WorkItem
+    {
+        Log& mLog;
+        int mValue;
+
+        LogItem(Log& log, int value) : mLog(log), mValue(value) {}
+
+        void doWork() override { mLog.push(mValue); }
+    };
+
+    struct BlockingItem : WorkItem
+    {
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mStarted = false;
+        bool mReleased = false;
+
+        void doWork() override
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStarted = true;
+            mCondition.notify_all();
+            mCondition.wait(lock, [&] { return mReleased; });
+        }
+
+        void waitTillStarted()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mStarted; });
+        }
+
+        void release()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                mReleased = true;
+            }
+            mCondition.notify_all();
+        }
+    };
+
+    struct SceneUtilWorkQueueTest : Test
+    {
+        Log mLog;
+    };
+
+    TEST_F(SceneUtilWorkQueueTest, should_process_all_items)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        std::vector<osg::ref_ptr<WorkItem>> items;
+        for (int i = 0; i < 100; ++i)
+        {
+            items.emplace_back(new LogItem(mLog, i));
+            queue->addWorkItem(items.back(), static_cast<WorkPriority>(i % sWorkPriorityCount));
+        }
+        for (const auto& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(mLog.mValues.size(), 100u);
+        EXPECT_EQ(queue->getNumItems(), 0u);
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, should_process_higher_priority_items_first)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        osg::ref_ptr<BlockingItem> blocking(new BlockingItem);
+        queue->addWorkItem(blocking);
+        blocking->waitTillStarted();
+
+        osg::ref_ptr<WorkItem> low(new LogItem(mLog, 0));
+        osg::ref_ptr<WorkItem> normal(new LogItem(mLog, 1));
+        osg::ref_ptr<WorkItem> high(new LogItem(mLog, 2));
+        queue->addWorkItem(low, WorkPriority::Low);
+        queue->addWorkItem(normal, WorkPriority::Normal);
+        queue->addWorkItem(high, WorkPriority::High);
+        EXPECT_EQ(queue->getNumItems(), 3u);
+
+        blocking->release();
+        low->waitTillDone();
+        EXPECT_THAT(mLog.mValues, ElementsAre(2, 1, 0));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, should_start_item_after_dependencies_are_done)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        osg::ref_ptr<BlockingItem> blocking(new BlockingItem);
+        osg::ref_ptr<WorkItem> first(new LogItem(mLog, 0));
+        osg::ref_ptr<WorkItem> second(new LogItem(mLog, 1));
+        first->addDependency(blocking);
+        second->addDependency(first);
+
+        queue->addWorkItem(second, WorkPriority::High);
+        queue->addWorkItem(first, WorkPriority::High);
+        queue->addWorkItem(blocking, WorkPriority::Low);
+        blocking->waitTillStarted();
+        EXPECT_FALSE(first->isDone());
+        EXPECT_FALSE(second->isDone());
+
+        blocking->release();
+        second->waitTillDone();
+        EXPECT_THAT(mLog.mValues, ElementsAre(0, 1));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, dependency_on_done_item_should_be_ignored)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        osg::ref_ptr<WorkItem> first(new LogItem(mLog, 0));
+        queue->addWorkItem(first);
+        first->waitTillDone();
+
+        osg::ref_ptr<WorkItem> second(new LogItem(mLog, 1));
+        second->addDependency(first);
+        queue->addWorkItem(second);
+        second->waitTillDone();
+        EXPECT_THAT(mLog.mValues, ElementsAre(0, 1));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, destructor_should_mark_not_started_items_and_their_dependents_done)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(0));
+        osg::ref_ptr<WorkItem> first(new LogItem(mLog, 0));
+        osg::ref_ptr<WorkItem> second(new LogItem(mLog, 1));
+        second->addDependency(first);
+        queue->addWorkItem(second);
+        queue->addWorkItem(first);
+        EXPECT_EQ(queue->getNumItems(), 1u);
+
+        queue = nullptr;
+
+        EXPECT_TRUE(first->isDone());
+        EXPECT_TRUE(second->isDone());
+        EXPECT_THAT(mLog.mValues, IsEmpty());
+    }
+}
@@ -28,9 +28,24 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include <components/debug/debuglog.hpp>
+
 using namespace std;
 using namespace Bsa;
 
+namespace
+{
+    bool ciEqual(const char *s1, const char *s2)
+    {
+        for (; *s1 != '\0' && *s2 != '\0'; ++s1, ++s2)
+        {
+            if (Misc::StringUtils::toLower(*s1) != Misc::StringUtils::toLower(*s2))
+                return false;
+        }
+        return *s1 == *s2;
+    }
+}
+
 
 /// Error handling
 void BSAFile::fail(const string &msg)
@@ -139,33 +154,100 @@ void BSAFile::readHeader()
 
         if(fs.offset + fs.fileSize > fsize)
             fail("Archive contains offsets outside itself");
-
-        // Add the file name to the lookup
-        mLookup[fs.name] = i;
     }
 
+    buildLookup();
+
     mIsLoaded = true;
 }
 
+std::uint32_t BSAFile::hashFileName(const char *name)
+{
+    // FNV-1a over the lower cased name
+    std::uint32_t hash = 2166136261u;
+    for (; *name != '\0'; ++name)
+    {
+        hash ^= static_cast<unsigned char>(Misc::StringUtils::toLower(*name));
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void BSAFile::buildLookup()
+{
+    // Keep the load factor at or below 0.5 so that probe sequences stay short
+    size_t capacity = 16;
+    while (capacity < mFiles.size() * 2)
+        capacity *= 2;
+
+    mLookup.assign(capacity, -1);
+    const size_t mask = capacity - 1;
+
+    for (size_t i = 0; i < mFiles.size(); ++i)
+    {
+        size_t slot = hashFileName(mFiles[i].name) & mask;
+        while (mLookup[slot] != -1)
+        {
+            // Later entries with the same name replace earlier ones, like insertion into a map did
+            if (ciEqual(mFiles[mLookup[slot]].name, mFiles[i].name))
+                break;
+            slot = (slot + 1) & mask;
+        }
+        mLookup[slot] = static_cast<int>(i);
+    }
+}
+
 /// Get the index of a given file name, or -1 if not found
 int BSAFile::getIndex(const char *str) const
 {
-    auto it = mLookup.find(str);
-    if(it == mLookup.end())
+    if (mLookup.empty())
         return -1;
 
-    int res = it->second;
-    assert(res >= 0 && (size_t)res < mFiles.size());
-    return res;
+    const size_t mask = mLookup.size() - 1;
+    for (size_t slot = hashFileName(str) & mask; mLookup[slot] != -1; slot = (slot + 1) & mask)
+    {
+        int res = mLookup[slot];
+        assert(res >= 0 && (size_t)res < mFiles.size());
+        if (ciEqual(mFiles[res].name, str))
+            return res;
+    }
+    return -1;
 }
 
 /// Open an archive file.
-void BSAFile::open(const string &file)
+void BSAFile::open(const string &file, bool memoryMapped)
 {
     mFilename = file;
+
+    if (memoryMapped)
+    {
+        try
+        {
+            auto mappedFile = std::make_shared<Files::MemoryMappedFile>();
+            mappedFile->open(mFilename.c_str());
+            mMappedFile = std::move(mappedFile);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to map BSA archive into memory, falling back to file streams: " << e.what();
+        }
+    }
+
     readHeader();
 }
 
+Files::IStreamPtr BSAFile::openRegion(size_t offset, size_t size) const
+{
+    if (mMappedFile)
+    {
+        if (offset + size > mMappedFile->size())
+            throw std::runtime_error("BSA Error: File region out of bounds\nArchive: " + mFilename);
+        return Files::openMemoryMappedFileStream(mMappedFile, offset, size);
+    }
+
+    return Files::openConstrainedFileStream(mFilename.c_str(), offset, size);
+}
+
 Files::IStreamPtr BSAFile::getFile(const char *file)
 {
     assert(file);
@@ -175,10 +257,10 @@ Files::IStreamPtr BSAFile::getFile(const char *file)
 
     const FileStruct &fs = mFiles[i];
 
-    return Files::openConstrainedFileStream (mFilename.c_str (), fs.offset, fs.fileSize);
+    return openRegion(fs.offset, fs.fileSize);
 }
 
 Files::IStreamPtr BSAFile::getFile(const FileStruct *file)
 {
-    return Files::openConstrainedFileStream (mFilename.c_str (), file->offset, file->fileSize);
+    return openRegion(file->offset, file->fileSize);
 }
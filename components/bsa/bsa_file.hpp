@@ -27,11 +27,11 @@
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <map>
 
 #include <components/misc/stringops.hpp>
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorymappedfile.hpp>
 
 
 namespace Bsa
@@ -69,19 +69,20 @@ protected:
     /// Used for error messages
     std::string mFilename;
 
-    /// Case insensitive string comparison
-    struct iltstr
-    {
-        bool operator()(const char *s1, const char *s2) const
-        { return Misc::StringUtils::ciLess(s1, s2); }
-    };
+    /// The whole archive mapped into memory, null when the archive is read through file streams
+    Files::MemoryMappedFilePtr mMappedFile;
 
-    /** A map used for fast file name lookup. The value is the index into
-        the files[] vector above. The iltstr ensures that file name
-        checks are case insensitive.
+    /** An open addressing hash table used for fast file name lookup. Each
+        slot holds an index into the files[] vector above, or -1 if empty.
+        Hashing and comparison are case insensitive.
     */
-    typedef std::map<const char*, int, iltstr> Lookup;
-    Lookup mLookup;
+    std::vector<int> mLookup;
+
+    /// Case insensitive hash of a file name
+    static std::uint32_t hashFileName(const char *name);
+
+    /// Rebuild mLookup from mFiles, must be called after mFiles is filled
+    void buildLookup();
 
     /// Error handling
     void fail(const std::string &msg);
@@ -89,13 +90,15 @@ protected:
     /// Read header information from the input source
     virtual void readHeader();
 
-    /// Read header information from the input source
-
-
     /// Get the index of a given file name, or -1 if not found
     /// @note Thread safe.
     int getIndex(const char *str) const;
 
+    /// Open a stream over a raw region of the archive. The stream is a view into the memory mapped
+    /// archive if available, otherwise a file stream constrained to the region.
+    /// @note Thread safe.
+    Files::IStreamPtr openRegion(size_t offset, size_t size) const;
+
 public:
     /* -----------------------------------
      * BSA management methods
@@ -109,7 +112,13 @@ public:
     virtual ~BSAFile() = default;
 
     /// Open an archive file.
-    void open(const std::string &file);
+    /// @param memoryMapped map the archive into memory so that uncompressed files are read
+    /// without any copies or file handles. Falls back to file streams if mapping fails.
+    void open(const std::string &file, bool memoryMapped = true);
+
+    /// True if the archive was mapped into memory
+    bool isMemoryMapped() const
+    { return mMappedFile != nullptr; }
 
     /* -----------------------------------
      * Archive file routines
@@ -278,7 +278,6 @@ void CompressedBSAFile::readHeader()
 
         mFiles[fileIndex].name = reinterpret_cast<char*>(mStringBuf.data() + mStringBuffOffset);
 
-        mLookup[reinterpret_cast<char*>(mStringBuf.data() + mStringBuffOffset)] = fileIndex;
         mStringBuffOffset += stringLength + 1u;
     }
 
@@ -286,6 +285,8 @@ void CompressedBSAFile::readHeader()
         fail("Could not resolve names of files in BSA file");
     }
 
+    buildLookup();
+
     convertCompressedSizesToUncompressed();
     mIsLoaded = true;
 }
@@ -341,7 +342,25 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     size_t size = fileRecord.getSizeWithoutCompressionFlag();
     size_t uncompressedSize = size;
     bool compressed = fileRecord.isCompressed(mCompressedByDefault);
-    Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, size);
+
+    if (mMappedFile && !compressed)
+    {
+        // Uncompressed files can be returned as a view into the mapped archive
+        size_t offset = fileRecord.offset;
+        if (mEmbeddedFileNames)
+        {
+            if (offset >= mMappedFile->size())
+                fail("File offset outside of the archive");
+            size_t length = static_cast<unsigned char>(mMappedFile->data()[offset]) + sizeof(char);
+            if (length > size)
+                fail("Embedded file name larger than the file");
+            offset += length;
+            size -= length;
+        }
+        return openRegion(offset, size);
+    }
+
+    Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, size);
     std::istream* fileStream = streamPtr.get();
     if (mEmbeddedFileNames)
     {
@@ -442,7 +461,7 @@ void CompressedBSAFile::convertCompressedSizesToUncompressed()
             continue;
         }
 
-        Files::IStreamPtr dataBegin = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
+        Files::IStreamPtr dataBegin = openRegion(fileRecord.offset, fileRecord.getSizeWithoutCompressionFlag());
 
         if (mEmbeddedFileNames)
         {
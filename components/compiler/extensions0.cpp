@@ -337,6 +337,7 @@ namespace Compiler
             extensions.registerInstruction ("setnavmeshnumber", "l", opcodeSetNavMeshNumberToRender);
             extensions.registerFunction ("repairedonme", 'l', "S", opcodeRepairedOnMe, opcodeRepairedOnMeExplicit);
             extensions.registerInstruction ("togglerecastmesh", "", opcodeToggleRecastMesh);
+            extensions.registerInstruction ("scriptprofile", "/l", opcodeScriptProfile);
         }
     }
 
@@ -318,6 +318,7 @@ namespace Compiler
         const int opcodeDisableExplicit = 0x200031b;
         const int opcodeGetDisabledExplicit = 0x200031c;
         const int opcodeStartScriptExplicit = 0x200031d;
+        const int opcodeScriptProfile = 0x20031;
     }
 
     namespace Sky
@@ -0,0 +1,202 @@
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace Debug
+{
+    namespace Tracing
+    {
+        std::atomic_bool sEnabled {false};
+    }
+
+    namespace
+    {
+        struct Event
+        {
+            const char* mName;
+            const char* mCategory;
+            std::chrono::steady_clock::time_point mBegin;
+            std::chrono::steady_clock::time_point mEnd;
+        };
+
+        struct ThreadEvents
+        {
+            const std::size_t mId;
+            std::mutex mMutex;
+            std::string mName;
+            std::vector<Event> mEvents;
+            // Guarded by Trace::mMutex
+            bool mNameWritten = false;
+
+            explicit ThreadEvents(std::size_t id) : mId(id) {}
+        };
+
+        struct Trace
+        {
+            std::mutex mMutex;
+            std::size_t mNextThreadId = 0;
+            std::vector<std::shared_ptr<ThreadEvents>> mThreads;
+            std::ofstream mFile;
+            std::chrono::steady_clock::time_point mStart;
+            bool mHasEvents = false;
+        };
+
+        Trace& getTrace()
+        {
+            static Trace trace;
+            return trace;
+        }
+
+        ThreadEvents& getThreadEvents()
+        {
+            thread_local const std::shared_ptr<ThreadEvents> events = []
+            {
+                Trace& trace = getTrace();
+                const std::lock_guard<std::mutex> lock(trace.mMutex);
+                auto result = std::make_shared<ThreadEvents>(trace.mNextThreadId++);
+                trace.mThreads.push_back(result);
+                return result;
+            } ();
+            return *events;
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << ' ';
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+
+        double toMicroseconds(std::chrono::steady_clock::duration value)
+        {
+            return std::chrono::duration<double, std::micro>(value).count();
+        }
+
+        void beginEntry(Trace& trace)
+        {
+            if (trace.mHasEvents)
+                trace.mFile << ",\n";
+            trace.mHasEvents = true;
+        }
+
+        void writeEvents(Trace& trace, ThreadEvents& thread, const std::vector<Event>& events)
+        {
+            if (!thread.mNameWritten && !thread.mName.empty())
+            {
+                beginEntry(trace);
+                trace.mFile << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread.mId
+                            << R"(,"args":{"name":)";
+                writeString(trace.mFile, thread.mName);
+                trace.mFile << "}}";
+                thread.mNameWritten = true;
+            }
+
+            for (const Event& event : events)
+            {
+                beginEntry(trace);
+                trace.mFile << R"({"name":)";
+                writeString(trace.mFile, event.mName);
+                trace.mFile << R"(,"cat":)";
+                writeString(trace.mFile, event.mCategory);
+                trace.mFile << R"(,"ph":"X","ts":)" << toMicroseconds(event.mBegin - trace.mStart)
+                            << R"(,"dur":)" << toMicroseconds(event.mEnd - event.mBegin)
+                            << R"(,"pid":1,"tid":)" << thread.mId << '}';
+            }
+        }
+
+        void flush(Trace& trace)
+        {
+            std::vector<Event> events;
+            for (const std::shared_ptr<ThreadEvents>& thread : trace.mThreads)
+            {
+                {
+                    const std::lock_guard<std::mutex> lock(thread->mMutex);
+                    events.swap(thread->mEvents);
+                }
+                writeEvents(trace, *thread, events);
+                events.clear();
+            }
+
+            // Only the trace owns events of finished threads and they are already written
+            trace.mThreads.erase(std::remove_if(trace.mThreads.begin(), trace.mThreads.end(),
+                [] (const std::shared_ptr<ThreadEvents>& v) { return v.use_count() == 1; }), trace.mThreads.end());
+
+            trace.mFile.flush();
+        }
+    }
+
+    void startTracing(const std::string& path)
+    {
+        Trace& trace = getTrace();
+        const std::lock_guard<std::mutex> lock(trace.mMutex);
+        if (Tracing::sEnabled)
+            throw std::runtime_error("Tracing is already started");
+        trace.mFile.open(path, std::ios::out | std::ios::trunc);
+        if (!trace.mFile)
+            throw std::runtime_error("Failed to open trace file: " + path);
+        trace.mFile << std::fixed << std::setprecision(3) << "[\n";
+        trace.mStart = std::chrono::steady_clock::now();
+        trace.mHasEvents = false;
+        for (const std::shared_ptr<ThreadEvents>& thread : trace.mThreads)
+        {
+            const std::lock_guard<std::mutex> threadLock(thread->mMutex);
+            thread->mEvents.clear();
+            thread->mNameWritten = false;
+        }
+        Tracing::sEnabled = true;
+    }
+
+    void flushTrace()
+    {
+        if (!isTracing())
+            return;
+        Trace& trace = getTrace();
+        const std::lock_guard<std::mutex> lock(trace.mMutex);
+        if (trace.mFile.is_open())
+            flush(trace);
+    }
+
+    void stopTracing()
+    {
+        Trace& trace = getTrace();
+        const std::lock_guard<std::mutex> lock(trace.mMutex);
+        if (!Tracing::sEnabled)
+            return;
+        Tracing::sEnabled = false;
+        flush(trace);
+        trace.mFile << "\n]\n";
+        trace.mFile.close();
+    }
+
+    void setTraceThreadName(const std::string& name)
+    {
+        ThreadEvents& thread = getThreadEvents();
+        Trace& trace = getTrace();
+        const std::lock_guard<std::mutex> lock(trace.mMutex);
+        thread.mName = name;
+        thread.mNameWritten = false;
+    }
+
+    void traceEvent(const char* name, const char* category, std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end)
+    {
+        ThreadEvents& thread = getThreadEvents();
+        const std::lock_guard<std::mutex> lock(thread.mMutex);
+        thread.mEvents.push_back(Event {name, category, begin, end});
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACING_H
+#define OPENMW_COMPONENTS_DEBUG_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace Debug
+{
+    /// Records durations of named scopes executed by any thread and writes them into a file in Chrome trace event
+    /// format (JSON array of complete events). Such file can be opened by chrome://tracing, Perfetto UI and other
+    /// trace viewers to find what a particular frame or thread was busy with.
+    /// Events are kept in per thread buffers until flushTrace() is called, so recording doesn't wait for the disk.
+
+    namespace Tracing
+    {
+        extern std::atomic_bool sEnabled;
+    }
+
+    inline bool isTracing()
+    {
+        return Tracing::sEnabled.load(std::memory_order_relaxed);
+    }
+
+    /// Start recording into the file truncating it. Throws std::runtime_error if the file can't be opened.
+    void startTracing(const std::string& path);
+
+    /// Write all recorded events into the file. Does nothing when not tracing.
+    void flushTrace();
+
+    /// Flush recorded events and close the file.
+    void stopTracing();
+
+    /// Name of the calling thread shown by trace viewers. Can be set before tracing is started.
+    void setTraceThreadName(const std::string& name);
+
+    /// Record a complete event for the calling thread. Name and category must be valid until the event is flushed.
+    void traceEvent(const char* name, const char* category, std::chrono::steady_clock::time_point begin,
+                    std::chrono::steady_clock::time_point end);
+
+    class ScopedTrace
+    {
+        public:
+            ScopedTrace(const char* name, const char* category)
+                : mName(isTracing() ? name : nullptr)
+                , mCategory(category)
+            {
+                if (mName != nullptr)
+                    mBegin = std::chrono::steady_clock::now();
+            }
+
+            ScopedTrace(const ScopedTrace&) = delete;
+            ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+            ~ScopedTrace()
+            {
+                if (mName != nullptr)
+                    traceEvent(mName, mCategory, mBegin, std::chrono::steady_clock::now());
+            }
+
+        private:
+            const char* const mName;
+            const char* const mCategory;
+            std::chrono::steady_clock::time_point mBegin;
+    };
+}
+
+#endif
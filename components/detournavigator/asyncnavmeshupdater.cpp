@@ -1,9 +1,11 @@
 #include "asyncnavmeshupdater.hpp"
 #include "debug.hpp"
 #include "makenavmesh.hpp"
+#include "navmeshdb.hpp"
 #include "settings.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 
 #include <osg/Stats>
 
@@ -55,6 +57,7 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mNavMeshDb(makeNavMeshDb(settings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
             mThreads.emplace_back([&] { process(); });
@@ -130,17 +133,22 @@ namespace DetourNavigator
         stats.setAttribute(frameNumber, "NavMesh UpdateJobs", jobs);
 
         mNavMeshTilesCache.reportStats(frameNumber, stats);
+
+        if (mNavMeshDb)
+            mNavMeshDb->reportStats(frameNumber, stats);
     }
 
     void AsyncNavMeshUpdater::process() noexcept
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
+        Debug::setTraceThreadName("Navmesh updater");
         while (!mShouldStop)
         {
             try
             {
                 if (auto job = getNextJob())
                 {
+                    const Debug::ScopedTrace trace("Update navmesh tile", "Navigator");
                     const auto processed = processJob(*job);
                     unlockTile(job->mAgentHalfExtents, job->mChangedTile);
                     if (!processed)
@@ -176,7 +184,7 @@ namespace DetourNavigator
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
         const auto status = updateNavMesh(job.mAgentHalfExtents, recastMesh.get(), job.mChangedTile, playerTile,
-            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache);
+            offMeshConnections, mSettings, navMeshCacheItem, mNavMeshTilesCache, mNavMeshDb.get());
 
         const auto finish = std::chrono::steady_clock::now();
 
@@ -22,6 +22,8 @@ class dtNavMesh;
 
 namespace DetourNavigator
 {
+    class NavMeshDb;
+
     enum class ChangeType
     {
         remove = 0,
@@ -106,6 +108,7 @@ namespace DetourNavigator
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         Misc::ScopeGuarded<std::optional<std::chrono::steady_clock::time_point>> mFirstStart;
         NavMeshTilesCache mNavMeshTilesCache;
+        std::unique_ptr<NavMeshDb> mNavMeshDb;
         Misc::ScopeGuarded<std::map<osg::Vec3f, std::map<TilePosition, std::thread::id>>> mProcessingTiles;
         std::map<osg::Vec3f, std::map<TilePosition, std::chrono::steady_clock::time_point>> mLastUpdates;
         std::map<std::thread::id, Queue> mThreadsQueues;
@@ -9,6 +9,7 @@
 #include "sharednavmesh.hpp"
 #include "flags.hpp"
 #include "navmeshtilescache.hpp"
+#include "navmeshdb.hpp"
 
 #include <components/misc/convert.hpp>
 
@@ -517,7 +518,7 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache)
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache, NavMeshDb* navMeshDb)
     {
         Log(Debug::Debug) << std::fixed << std::setprecision(2) <<
             "Update NavMesh with multiple tiles:" <<
@@ -563,17 +564,35 @@ namespace DetourNavigator
 
         if (!cachedNavMeshData)
         {
-            const auto tileBounds = makeTileBounds(settings, changedTile);
-            const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
-            const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
+            NavMeshData navMeshData;
 
-            auto navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
-                tileBorderMin, tileBorderMax, settings);
+            if (navMeshDb != nullptr)
+            {
+                if (auto storedNavMeshData = navMeshDb->getTile(agentHalfExtents, changedTile, *recastMesh, offMeshConnections))
+                {
+                    navMeshData = std::move(*storedNavMeshData);
+                    cached = true;
+                }
+            }
 
             if (!navMeshData.mValue)
             {
-                Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
-                return navMeshCacheItem->lock()->removeTile(changedTile);
+                const auto tileBounds = makeTileBounds(settings, changedTile);
+                const osg::Vec3f tileBorderMin(tileBounds.mMin.x(), recastMeshBounds.mMin.y() - 1, tileBounds.mMin.y());
+                const osg::Vec3f tileBorderMax(tileBounds.mMax.x(), recastMeshBounds.mMax.y() + 1, tileBounds.mMax.y());
+
+                navMeshData = makeNavMeshTileData(agentHalfExtents, *recastMesh, offMeshConnections, changedTile,
+                    tileBorderMin, tileBorderMax, settings);
+
+                if (!navMeshData.mValue)
+                {
+                    Log(Debug::Debug) << "Ignore add tile: NavMeshData is null";
+                    return navMeshCacheItem->lock()->removeTile(changedTile);
+                }
+
+                if (navMeshDb != nullptr)
+                    navMeshDb->putTile(agentHalfExtents, changedTile, *recastMesh, offMeshConnections,
+                                       NavMeshDataRef {navMeshData.mValue.get(), navMeshData.mSize});
             }
 
             try
@@ -18,6 +18,7 @@ class dtNavMesh;
 namespace DetourNavigator
 {
     class RecastMesh;
+    class NavMeshDb;
     struct Settings;
 
     inline float getLength(const osg::Vec2i& value)
@@ -41,7 +42,7 @@ namespace DetourNavigator
     UpdateNavMeshStatus updateNavMesh(const osg::Vec3f& agentHalfExtents, const RecastMesh* recastMesh,
         const TilePosition& changedTile, const TilePosition& playerTile,
         const std::vector<OffMeshConnection>& offMeshConnections, const Settings& settings,
-        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache);
+        const SharedNavMeshCacheItem& navMeshCacheItem, NavMeshTilesCache& navMeshTilesCache, NavMeshDb* navMeshDb);
 }
 
 #endif
@@ -0,0 +1,413 @@
+#include "navmeshdb.hpp"
+#include "exceptions.hpp"
+#include "recastmesh.hpp"
+#include "settings.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <DetourAlloc.h>
+
+#include <osg/Stats>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        constexpr char sMagic[4] = {'O', 'N', 'M', 'T'};
+
+        // Increment when the file layout or the navmesh generation algorithm changes
+        constexpr std::uint32_t sVersion = 2;
+
+        constexpr char sTileExtension[] = ".navmeshtile";
+        constexpr char sTempExtension[] = ".tmp";
+
+        std::size_t getFileSize(std::size_t keySize, int dataSize)
+        {
+            return sizeof(sMagic) + sizeof(std::uint32_t) + sizeof(std::uint64_t) + keySize + sizeof(std::int32_t)
+                + static_cast<std::size_t>(dataSize);
+        }
+
+        template <class T>
+        void append(std::vector<unsigned char>& out, const T& value)
+        {
+            const auto begin = reinterpret_cast<const unsigned char*>(&value);
+            out.insert(out.end(), begin, begin + sizeof(T));
+        }
+
+        template <class T>
+        bool read(std::istream& stream, T& value)
+        {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        /// Serializes all settings having effect on the generated navmesh tile data
+        std::vector<unsigned char> makeSettingsKey(const Settings& settings)
+        {
+            std::vector<unsigned char> result;
+            append(result, settings.mCellHeight);
+            append(result, settings.mCellSize);
+            append(result, settings.mDetailSampleDist);
+            append(result, settings.mDetailSampleMaxError);
+            append(result, settings.mMaxClimb);
+            append(result, settings.mMaxSimplificationError);
+            append(result, settings.mMaxSlope);
+            append(result, settings.mRecastScaleFactor);
+            append(result, settings.mSwimHeightScale);
+            append(result, settings.mBorderSize);
+            append(result, settings.mMaxEdgeLen);
+            append(result, settings.mMaxPolys);
+            append(result, settings.mMaxVertsPerPoly);
+            append(result, settings.mRegionMergeSize);
+            append(result, settings.mRegionMinSize);
+            append(result, settings.mTileSize);
+            return result;
+        }
+
+        void appendFloat(std::vector<unsigned char>& out, float value)
+        {
+            // Negative zero has other bits but produces the same navmesh
+            append(out, value == 0 ? 0.0f : value);
+        }
+
+        template <std::size_t size>
+        void appendFloats(std::vector<unsigned char>& out, const std::array<float, size>& values)
+        {
+            for (const float value : values)
+                appendFloat(out, value);
+        }
+
+        void appendSize(std::vector<unsigned char>& out, std::size_t value)
+        {
+            append(out, static_cast<std::uint64_t>(value));
+        }
+
+        /// Serializes each field separately to avoid padding bytes in the key. Triangles, water and off mesh
+        /// connections are sorted so the key doesn't depend on the order objects were added to the navigator,
+        /// which differs between game sessions and openmw-navmeshtool.
+        void appendNavMeshKey(std::vector<unsigned char>& out, const RecastMesh& recastMesh,
+            const std::vector<OffMeshConnection>& offMeshConnections)
+        {
+            const auto& indices = recastMesh.getIndices();
+            const auto& vertices = recastMesh.getVertices();
+            const auto& areaTypes = recastMesh.getAreaTypes();
+            std::vector<std::pair<std::array<float, 9>, AreaType>> triangles;
+            triangles.reserve(areaTypes.size());
+            for (std::size_t i = 0; i < areaTypes.size(); ++i)
+            {
+                std::array<float, 9> triangle;
+                for (std::size_t j = 0; j < 3; ++j)
+                    for (std::size_t k = 0; k < 3; ++k)
+                        triangle[3 * j + k] = vertices[3 * static_cast<std::size_t>(indices[3 * i + j]) + k];
+                triangles.emplace_back(triangle, areaTypes[i]);
+            }
+            std::sort(triangles.begin(), triangles.end());
+            appendSize(out, triangles.size());
+            for (const auto& [triangle, areaType] : triangles)
+            {
+                appendFloats(out, triangle);
+                append(out, static_cast<unsigned char>(areaType));
+            }
+
+            std::vector<std::pair<int, std::array<float, 12>>> water;
+            water.reserve(recastMesh.getWater().size());
+            for (const auto& v : recastMesh.getWater())
+            {
+                const auto& basis = v.mTransform.getBasis();
+                const auto& origin = v.mTransform.getOrigin();
+                water.emplace_back(v.mCellSize, std::array<float, 12> {
+                    static_cast<float>(basis[0].x()), static_cast<float>(basis[0].y()), static_cast<float>(basis[0].z()),
+                    static_cast<float>(basis[1].x()), static_cast<float>(basis[1].y()), static_cast<float>(basis[1].z()),
+                    static_cast<float>(basis[2].x()), static_cast<float>(basis[2].y()), static_cast<float>(basis[2].z()),
+                    static_cast<float>(origin.x()), static_cast<float>(origin.y()), static_cast<float>(origin.z()),
+                });
+            }
+            std::sort(water.begin(), water.end());
+            appendSize(out, water.size());
+            for (const auto& [cellSize, transform] : water)
+            {
+                append(out, static_cast<std::int32_t>(cellSize));
+                appendFloats(out, transform);
+            }
+
+            std::vector<std::pair<std::array<float, 6>, AreaType>> connections;
+            connections.reserve(offMeshConnections.size());
+            for (const auto& v : offMeshConnections)
+                connections.emplace_back(std::array<float, 6> {v.mStart.x(), v.mStart.y(), v.mStart.z(),
+                                                               v.mEnd.x(), v.mEnd.y(), v.mEnd.z()}, v.mAreaType);
+            std::sort(connections.begin(), connections.end());
+            appendSize(out, connections.size());
+            for (const auto& [points, areaType] : connections)
+            {
+                appendFloats(out, points);
+                append(out, static_cast<unsigned char>(areaType));
+            }
+        }
+
+        std::uint64_t getHash(const std::vector<unsigned char>& value)
+        {
+            // FNV-1a
+            std::uint64_t hash = 14695981039346656037ull;
+            for (const unsigned char v : value)
+            {
+                hash ^= v;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    }
+
+    NavMeshDb::NavMeshDb(const std::string& path, const Settings& settings)
+        : mPath(path)
+        , mSettingsKey(makeSettingsKey(settings))
+        , mMaxSize(settings.mMaxNavMeshDiskCacheSize)
+    {
+        boost::system::error_code error;
+        boost::filesystem::create_directories(mPath, error);
+        if (error)
+            throw NavigatorException("Failed to create navmesh tiles directory \"" + path + "\": " + error.message());
+
+        std::vector<std::tuple<std::time_t, std::string, std::size_t>> files;
+        for (boost::filesystem::directory_iterator it(mPath, error), end; !error && it != end; it.increment(error))
+        {
+            const auto& filePath = it->path();
+            const auto extension = filePath.extension().string();
+            if (extension == sTempExtension)
+            {
+                // Left by interrupted writes
+                boost::filesystem::remove(filePath, error);
+                error.clear();
+                continue;
+            }
+            if (extension != sTileExtension || !boost::filesystem::is_regular_file(it->status()))
+                continue;
+            const auto size = boost::filesystem::file_size(filePath, error);
+            if (error)
+                continue;
+            const auto lastUse = boost::filesystem::last_write_time(filePath, error);
+            if (error)
+                continue;
+            files.emplace_back(lastUse, filePath.filename().string(), static_cast<std::size_t>(size));
+        }
+        if (error)
+            Log(Debug::Warning) << "Failed to list navmesh tiles directory \"" << path << "\": " << error.message();
+
+        std::sort(files.begin(), files.end());
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        for (const auto& [lastUse, name, size] : files)
+            add(name, size);
+    }
+
+    std::optional<NavMeshData> NavMeshDb::getTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const
+    {
+        const auto key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+
+        boost::filesystem::ifstream stream(getTilePath(changedTile, key), std::ios::binary);
+        if (!stream)
+        {
+            ++mMisses;
+            return std::nullopt;
+        }
+
+        char magic[sizeof(sMagic)];
+        std::uint32_t version = 0;
+        std::uint64_t keySize = 0;
+        if (!read(stream, magic) || std::memcmp(magic, sMagic, sizeof(sMagic)) != 0
+                || !read(stream, version) || version != sVersion
+                || !read(stream, keySize) || keySize != key.size())
+        {
+            ++mMisses;
+            return std::nullopt;
+        }
+
+        // Files are named by key hash, so the whole key has to match to rule out collisions
+        std::vector<unsigned char> storedKey(key.size());
+        std::int32_t dataSize = 0;
+        if (!stream.read(reinterpret_cast<char*>(storedKey.data()), static_cast<std::streamsize>(storedKey.size()))
+                || storedKey != key || !read(stream, dataSize) || dataSize <= 0)
+        {
+            ++mMisses;
+            return std::nullopt;
+        }
+
+        NavMeshData result(static_cast<unsigned char*>(dtAlloc(static_cast<std::size_t>(dataSize), DT_ALLOC_PERM)), dataSize);
+        if (!result.mValue)
+            throw NavigatorException("Failed to allocate memory for navmesh tile data");
+
+        if (!stream.read(reinterpret_cast<char*>(result.mValue.get()), dataSize))
+        {
+            Log(Debug::Warning) << "Navmesh tile file is truncated: " << getTilePath(changedTile, key).string();
+            ++mMisses;
+            return std::nullopt;
+        }
+
+        stream.close();
+        touch(getTilePath(changedTile, key));
+
+        ++mHits;
+        return result;
+    }
+
+    void NavMeshDb::putTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+        const NavMeshDataRef& value)
+    {
+        const auto key = makeKey(agentHalfExtents, changedTile, recastMesh, offMeshConnections);
+        const auto fileSize = getFileSize(key.size(), value.mSize);
+        if (fileSize > mMaxSize)
+            return;
+
+        const auto path = getTilePath(changedTile, key);
+
+        std::ostringstream tempName;
+        tempName << path.filename().string() << '.' << std::this_thread::get_id() << '.' << mTempFileCounter++
+                 << sTempExtension;
+        const auto tempPath = mPath / tempName.str();
+
+        try
+        {
+            {
+                boost::filesystem::ofstream stream(tempPath, std::ios::binary);
+                const std::uint32_t version = sVersion;
+                const std::uint64_t keySize = key.size();
+                const std::int32_t dataSize = value.mSize;
+                stream.write(sMagic, sizeof(sMagic));
+                stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+                stream.write(reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+                stream.write(reinterpret_cast<const char*>(key.data()), static_cast<std::streamsize>(key.size()));
+                stream.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+                stream.write(reinterpret_cast<const char*>(value.mValue), value.mSize);
+                if (!stream)
+                    throw std::runtime_error("write failed");
+            }
+
+            // Readers never see partially written files
+            boost::filesystem::rename(tempPath, path);
+            ++mWrites;
+
+            const std::lock_guard<std::mutex> lock(mMutex);
+            add(path.filename().string(), fileSize);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write navmesh tile file " << path.string() << ": " << e.what();
+            boost::system::error_code error;
+            boost::filesystem::remove(tempPath, error);
+        }
+    }
+
+    void NavMeshDb::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "NavMesh DbHits", mHits.load());
+        stats.setAttribute(frameNumber, "NavMesh DbMisses", mMisses.load());
+        stats.setAttribute(frameNumber, "NavMesh DbWrites", mWrites.load());
+        stats.setAttribute(frameNumber, "NavMesh DbSize", getSize());
+    }
+
+    std::size_t NavMeshDb::getSize() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return mSize;
+    }
+
+    std::vector<unsigned char> NavMeshDb::makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+        const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const
+    {
+        std::vector<unsigned char> result = mSettingsKey;
+        appendFloat(result, agentHalfExtents.x());
+        appendFloat(result, agentHalfExtents.y());
+        appendFloat(result, agentHalfExtents.z());
+        append(result, static_cast<std::int32_t>(changedTile.x()));
+        append(result, static_cast<std::int32_t>(changedTile.y()));
+        appendNavMeshKey(result, recastMesh, offMeshConnections);
+        return result;
+    }
+
+    boost::filesystem::path NavMeshDb::getTilePath(const TilePosition& changedTile, const std::vector<unsigned char>& key) const
+    {
+        std::ostringstream name;
+        name << changedTile.x() << '_' << changedTile.y() << '_'
+             << std::hex << std::setw(16) << std::setfill('0') << getHash(key) << sTileExtension;
+        return mPath / name.str();
+    }
+
+    void NavMeshDb::touch(const boost::filesystem::path& path) const
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            const auto it = mFiles.find(path.filename().string());
+            if (it == mFiles.end())
+                return;
+            mUsage.splice(mUsage.end(), mUsage, it->second.mUsage);
+        }
+
+        // Keep usage order for the next sessions
+        boost::system::error_code error;
+        boost::filesystem::last_write_time(path, std::time(nullptr), error);
+    }
+
+    void NavMeshDb::add(const std::string& name, std::size_t size)
+    {
+        const auto it = mFiles.find(name);
+        if (it != mFiles.end())
+        {
+            mSize -= it->second.mSize;
+            it->second.mSize = size;
+            mUsage.splice(mUsage.end(), mUsage, it->second.mUsage);
+        }
+        else
+        {
+            mFiles.emplace(name, File {size, mUsage.insert(mUsage.end(), name)});
+        }
+        mSize += size;
+
+        while (mSize > mMaxSize && !mUsage.empty())
+            removeLeastRecentlyUsed();
+    }
+
+    void NavMeshDb::removeLeastRecentlyUsed()
+    {
+        const auto it = mFiles.find(mUsage.front());
+        boost::system::error_code error;
+        boost::filesystem::remove(mPath / it->first, error);
+        if (error)
+            Log(Debug::Warning) << "Failed to remove navmesh tile file " << (mPath / it->first).string()
+                                << ": " << error.message();
+        mSize -= it->second.mSize;
+        mFiles.erase(it);
+        mUsage.pop_front();
+    }
+
+    std::unique_ptr<NavMeshDb> makeNavMeshDb(const Settings& settings)
+    {
+        if (!settings.mEnableNavMeshDiskCache)
+            return nullptr;
+        if (settings.mNavMeshDiskCachePath.empty())
+        {
+            Log(Debug::Warning) << "Navmesh disk cache is disabled: path is not set";
+            return nullptr;
+        }
+        try
+        {
+            return std::make_unique<NavMeshDb>(settings.mNavMeshDiskCachePath, settings);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Navmesh disk cache is disabled: " << e.what();
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
+
+#include "navmeshdata.hpp"
+#include "navmeshtilescache.hpp"
+#include "offmeshconnection.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <boost/filesystem/path.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    class RecastMesh;
+    struct Settings;
+
+    /// Persistent storage of generated navmesh tiles. Each tile is stored in a separate file inside the given
+    /// directory and is identified by the agent half extents, the tile position, the settings affecting generation
+    /// and the recast mesh geometry with off mesh connections.
+    /// Total size of the files is limited by Settings::mMaxNavMeshDiskCacheSize, least recently used files are removed
+    /// first. Usage order is persisted by file modification time.
+    /// @note Thread safe.
+    class NavMeshDb
+    {
+    public:
+        NavMeshDb(const std::string& path, const Settings& settings);
+
+        std::optional<NavMeshData> getTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const;
+
+        void putTile(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections,
+            const NavMeshDataRef& value);
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+        std::size_t getSize() const;
+
+    private:
+        struct File
+        {
+            std::size_t mSize;
+            std::list<std::string>::iterator mUsage;
+        };
+
+        boost::filesystem::path mPath;
+        std::vector<unsigned char> mSettingsKey;
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        std::size_t mSize = 0;
+        mutable std::list<std::string> mUsage;
+        std::map<std::string, File> mFiles;
+        mutable std::atomic_size_t mHits {0};
+        mutable std::atomic_size_t mMisses {0};
+        std::atomic_size_t mWrites {0};
+        std::atomic_size_t mTempFileCounter {0};
+
+        std::vector<unsigned char> makeKey(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
+            const RecastMesh& recastMesh, const std::vector<OffMeshConnection>& offMeshConnections) const;
+
+        boost::filesystem::path getTilePath(const TilePosition& changedTile, const std::vector<unsigned char>& key) const;
+
+        void touch(const boost::filesystem::path& path) const;
+
+        void add(const std::string& name, std::size_t size);
+
+        void removeLeastRecentlyUsed();
+    };
+
+    /// Returns nullptr when disk cache is disabled by settings or its directory can't be used.
+    std::unique_ptr<NavMeshDb> makeNavMeshDb(const Settings& settings);
+}
+
+#endif
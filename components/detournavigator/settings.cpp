@@ -40,6 +40,9 @@ namespace DetourNavigator
         navigatorSettings.mNavMeshPathPrefix = ::Settings::Manager::getString("nav mesh path prefix", "Navigator");
         navigatorSettings.mEnableRecastMeshFileNameRevision = ::Settings::Manager::getBool("enable recast mesh file name revision", "Navigator");
         navigatorSettings.mEnableNavMeshFileNameRevision = ::Settings::Manager::getBool("enable nav mesh file name revision", "Navigator");
+        navigatorSettings.mEnableNavMeshDiskCache = ::Settings::Manager::getBool("enable nav mesh disk cache", "Navigator");
+        navigatorSettings.mNavMeshDiskCachePath = ::Settings::Manager::getString("nav mesh disk cache path", "Navigator");
+        navigatorSettings.mMaxNavMeshDiskCacheSize = static_cast<std::size_t>(::Settings::Manager::getInt("max nav mesh disk cache size", "Navigator"));
         navigatorSettings.mMinUpdateInterval = std::chrono::milliseconds(::Settings::Manager::getInt("min update interval ms", "Navigator"));
 
         return navigatorSettings;
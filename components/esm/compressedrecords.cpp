@@ -0,0 +1,105 @@
+#include "compressedrecords.hpp"
+
+#include <lz4frame.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "defs.hpp"
+
+namespace ESM
+{
+    namespace
+    {
+        struct DecompressionContextDeleter
+        {
+            void operator()(LZ4F_decompressionContext_t context) const
+            {
+                LZ4F_freeDecompressionContext(context);
+            }
+        };
+
+        template <class T>
+        void append(std::string& data, const T& value)
+        {
+            data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void appendName(std::string& data, const char (&name)[5])
+        {
+            data.append(name, 4);
+        }
+    }
+
+    void compressRecords(std::string& data, std::size_t offset)
+    {
+        if (offset >= data.size())
+            return;
+
+        const std::size_t size = data.size() - offset;
+
+        LZ4F_preferences_t preferences;
+        std::memset(&preferences, 0, sizeof(preferences));
+        // Blocks are small enough for the cache and the checksum detects damaged files
+        preferences.frameInfo.blockSizeID = LZ4F_max4MB;
+        preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+        preferences.frameInfo.contentSize = size;
+
+        std::string compressed(LZ4F_compressFrameBound(size, &preferences), '\0');
+        const std::size_t compressedSize = LZ4F_compressFrame(compressed.data(), compressed.size(),
+            data.data() + offset, size, &preferences);
+        if (LZ4F_isError(compressedSize))
+            throw std::runtime_error(std::string("LZ4 compression error: ") + LZ4F_getErrorName(compressedSize));
+
+        const std::uint64_t uncompressedSize = size;
+        // SIZE and DATA sub-records
+        const std::uint32_t recordSize = 4 + 4 + sizeof(uncompressedSize) + 4 + 4 + static_cast<std::uint32_t>(compressedSize);
+        const std::uint32_t dataSize = static_cast<std::uint32_t>(compressedSize);
+        const std::uint32_t uncompressedSizeSize = sizeof(uncompressedSize);
+        const std::uint32_t zero = 0;
+
+        data.resize(offset);
+        data.reserve(offset + 16 + recordSize);
+        append(data, static_cast<std::uint32_t>(REC_CMPR));
+        append(data, recordSize);
+        append(data, zero);
+        append(data, zero);
+        appendName(data, "SIZE");
+        append(data, uncompressedSizeSize);
+        append(data, uncompressedSize);
+        appendName(data, "DATA");
+        append(data, dataSize);
+        data.append(compressed.data(), compressedSize);
+    }
+
+    void decompressRecords(const char* data, std::size_t size, char* result, std::size_t resultSize)
+    {
+        LZ4F_decompressionContext_t context = nullptr;
+        const LZ4F_errorCode_t createError = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+        if (LZ4F_isError(createError))
+            throw std::runtime_error(std::string("LZ4 decompression error: ") + LZ4F_getErrorName(createError));
+        const std::unique_ptr<std::remove_pointer_t<LZ4F_decompressionContext_t>, DecompressionContextDeleter> contextGuard(context);
+
+        std::size_t read = 0;
+        std::size_t written = 0;
+        std::size_t hint = 1;
+        while (hint != 0 && read < size)
+        {
+            std::size_t readNow = size - read;
+            std::size_t writtenNow = resultSize - written;
+            hint = LZ4F_decompress(context, result + written, &writtenNow, data + read, &readNow, nullptr);
+            if (LZ4F_isError(hint))
+                throw std::runtime_error(std::string("LZ4 decompression error: ") + LZ4F_getErrorName(hint));
+            if (readNow == 0 && writtenNow == 0)
+                break;
+            read += readNow;
+            written += writtenNow;
+        }
+
+        if (hint != 0 || written != resultSize)
+            throw std::runtime_error("Compressed records are truncated");
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef OPENMW_ESM_COMPRESSEDRECORDS_H
+#define OPENMW_ESM_COMPRESSEDRECORDS_H
+
+#include <cstddef>
+#include <string>
+
+namespace ESM
+{
+    /// Replace all records of ESM file data after the offset by a single REC_CMPR record holding them compressed with
+    /// LZ4. ESMReader reads the records from it transparently. Does nothing if there are no records after the offset.
+    /// @note Data is expected to be completely written, ESMWriter has to be closed.
+    void compressRecords(std::string& data, std::size_t offset);
+
+    /// Decompress data of a REC_CMPR record into a buffer of the size stored in the record.
+    /// @throw std::runtime_error if data is damaged or has different size
+    void decompressRecords(const char* data, std::size_t size, char* result, std::size_t resultSize);
+}
+
+#endif
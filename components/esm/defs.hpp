@@ -161,6 +161,11 @@ enum RecNameInts
     REC_CAM_ = FourCC<'C','A','M','_'>::value,
     REC_STLN = FourCC<'S','T','L','N'>::value,
     REC_INPU = FourCC<'I','N','P','U'>::value,
+    REC_CMPR = FourCC<'C','M','P','R'>::value, // compressed records, see compressedrecords.hpp
+
+    // format 0 - ESMStore snapshots
+    REC_SNAP = FourCC<'S','N','A','P'>::value,
+    REC_SNXT = FourCC<'S','N','X','T'>::value,
 
     // format 1
     REC_FILT = FourCC<'F','I','L','T'>::value,
@@ -1,12 +1,38 @@
 #include "esmreader.hpp"
 
+#include <limits>
 #include <stdexcept>
 
+#include <components/files/memorystream.hpp>
+
+#include "compressedrecords.hpp"
+#include "defs.hpp"
+
 namespace ESM
 {
 
 using namespace Misc;
 
+namespace
+{
+    struct DecompressedBuffer
+    {
+        std::vector<char> mData;
+
+        explicit DecompressedBuffer(size_t size) : mData(size) {}
+    };
+
+    /// Owns the memory it reads from. Virtual bases are constructed first, so the buffer is ready for MemBuf.
+    struct DecompressedStream : virtual DecompressedBuffer, Files::IMemStream
+    {
+        explicit DecompressedStream(size_t size)
+            : DecompressedBuffer(size)
+            , Files::MemBuf(mData.data(), size)
+            , Files::IMemStream(mData.data(), size)
+        {}
+    };
+}
+
     std::string ESMReader::getName() const
     {
         return mCtx.filename;
@@ -25,6 +51,7 @@ ESMReader::ESMReader()
     , mGlobalReaderList(nullptr)
     , mEncoder(nullptr)
     , mFileSize(0)
+    , mFileOffset(0)
 {
     clearCtx();
 }
@@ -58,6 +85,7 @@ void ESMReader::clearCtx()
 {
    mCtx.filename.clear();
    mCtx.leftFile = 0;
+   mFileOffset = 0;
    mCtx.leftRec = 0;
    mCtx.leftSub = 0;
    mCtx.subCached = false;
@@ -282,9 +310,51 @@ NAME ESMReader::getRecName()
     // record.
     mCtx.subCached = false;
 
+    if (mCtx.recName.intval == REC_CMPR)
+    {
+        openCompressedRecords();
+        return getRecName();
+    }
+
     return mCtx.recName;
 }
 
+void ESMReader::openCompressedRecords()
+{
+    const size_t recordOffset = getFileOffset() - mCtx.recName.data_size();
+
+    getRecHeader();
+    uint64_t size = 0;
+    getHNT(size, "SIZE");
+    getSubNameIs("DATA");
+    getSubHeader();
+    if (mCtx.leftFile != 0)
+        fail("Compressed records have to be at the end of file");
+    if (size == 0 || size > std::numeric_limits<size_t>::max() - recordOffset)
+        fail("Invalid size of compressed records");
+
+    std::vector<char> compressed(mCtx.leftSub);
+    getExact(compressed.data(), static_cast<int>(compressed.size()));
+
+    auto stream = std::make_shared<DecompressedStream>(static_cast<size_t>(size));
+    try
+    {
+        decompressRecords(compressed.data(), compressed.size(), stream->mData.data(), stream->mData.size());
+    }
+    catch (const std::exception& e)
+    {
+        fail(e.what());
+    }
+
+    // Offsets continue from the position of the compressed record, so the progress of reading stays the same
+    mEsm = stream;
+    mFileOffset = recordOffset;
+    mFileSize = recordOffset + static_cast<size_t>(size);
+    mCtx.leftFile = static_cast<size_t>(size);
+    mCtx.leftRec = 0;
+    mCtx.leftSub = 0;
+}
+
 void ESMReader::skipRecord()
 {
     skip(mCtx.leftRec);
@@ -377,12 +447,12 @@ void ESMReader::setEncoder(ToUTF8::Utf8Encoder* encoder)
 
 size_t ESMReader::getFileOffset()
 {
-    return mEsm->tellg();
+    return mFileOffset + static_cast<size_t>(mEsm->tellg());
 }
 
 void ESMReader::skip(int bytes)
 {
-    mEsm->seekg(getFileOffset()+bytes);
+    mEsm->seekg(static_cast<size_t>(mEsm->tellg()) + bytes);
 }
 
 }
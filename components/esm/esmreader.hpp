@@ -73,6 +73,7 @@ public:
   void openRaw(const std::string &filename);
 
   /// Get the current position in the file. Make sure that the file has been opened!
+  /// @note Positions within compressed records are counted as if they were not compressed.
   size_t getFileOffset();
 
   // This is a quick hack for multiple esm/esp files. Each plugin introduces its own
@@ -267,11 +268,16 @@ public:
   /// Get record flags of last record
   unsigned int getRecordFlags() { return mRecordFlags; }
 
+  /// @note Updated to the uncompressed size when compressed records are reached.
   size_t getFileSize() const { return mFileSize; }
 
 private:
   void clearCtx();
 
+  /// Continue reading from decompressed data of the REC_CMPR record which name is just read.
+  /// @note Contexts saved after this point can be restored only while the reader stays open.
+  void openCompressedRecords();
+
   Files::IStreamPtr mEsm;
 
   ESM_Context mCtx;
@@ -290,6 +296,8 @@ private:
 
   size_t mFileSize;
 
+  // Position of the data mEsm reads in the file
+  size_t mFileOffset;
 };
 }
 #endif
@@ -4,7 +4,7 @@
 #include "esmwriter.hpp"
 
 unsigned int ESM::SavedGame::sRecordId = ESM::REC_SAVE;
-int ESM::SavedGame::sCurrentFormat = 15;
+int ESM::SavedGame::sCurrentFormat = 16;
 
 void ESM::SavedGame::load (ESMReader &esm)
 {
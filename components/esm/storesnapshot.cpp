@@ -0,0 +1,101 @@
+#include "storesnapshot.hpp"
+
+#include "esmreader.hpp"
+#include "esmwriter.hpp"
+
+#include <tuple>
+
+namespace ESM
+{
+    void StoreSnapshot::load(ESMReader& esm)
+    {
+        esm.getHNT(mFormat, "FORM");
+        esm.getHNT(mEncoding, "ENCD");
+
+        mContentFiles.clear();
+        while (esm.isNextSub("FNAM"))
+        {
+            ContentFile file;
+            file.mPath = esm.getHString();
+            esm.getHNT(file.mSize, "SIZE");
+            esm.getHNT(file.mModificationTime, "MTIM");
+            mContentFiles.push_back(file);
+        }
+    }
+
+    void StoreSnapshot::save(ESMWriter& esm) const
+    {
+        esm.writeHNT("FORM", mFormat);
+        esm.writeHNT("ENCD", mEncoding);
+
+        for (const ContentFile& file : mContentFiles)
+        {
+            esm.writeHNString("FNAM", file.mPath);
+            esm.writeHNT("SIZE", file.mSize);
+            esm.writeHNT("MTIM", file.mModificationTime);
+        }
+    }
+
+    void StoreSnapshot::saveContext(ESMWriter& esm, const ESM_Context& context)
+    {
+        esm.startSubRecord("CNTX");
+        esm.writeT(static_cast<std::uint32_t>(context.filename.size()));
+        esm.write(context.filename.data(), context.filename.size());
+        esm.writeT(context.leftRec);
+        esm.writeT(context.leftSub);
+        esm.writeT(static_cast<std::uint64_t>(context.leftFile));
+        esm.writeT(context.recName.intval);
+        esm.writeT(context.subName.intval);
+        esm.writeT(context.index);
+        esm.writeT(static_cast<std::uint8_t>(context.subCached));
+        esm.writeT(static_cast<std::uint64_t>(context.filePos));
+        esm.writeT(static_cast<std::uint32_t>(context.parentFileIndices.size()));
+        for (int index : context.parentFileIndices)
+            esm.writeT(index);
+        esm.endRecord("CNTX");
+    }
+
+    ESM_Context StoreSnapshot::loadContext(ESMReader& esm)
+    {
+        ESM_Context context;
+        esm.getSubHeader();
+
+        std::uint32_t filenameSize = 0;
+        esm.getT(filenameSize);
+        if (filenameSize > 0)
+            context.filename = esm.getString(static_cast<int>(filenameSize));
+        esm.getT(context.leftRec);
+        esm.getT(context.leftSub);
+        std::uint64_t leftFile = 0;
+        esm.getT(leftFile);
+        context.leftFile = static_cast<std::size_t>(leftFile);
+        esm.getT(context.recName.intval);
+        esm.getT(context.subName.intval);
+        esm.getT(context.index);
+        std::uint8_t subCached = 0;
+        esm.getT(subCached);
+        context.subCached = subCached != 0;
+        std::uint64_t filePos = 0;
+        esm.getT(filePos);
+        context.filePos = static_cast<std::size_t>(filePos);
+        std::uint32_t parentsCount = 0;
+        esm.getT(parentsCount);
+        context.parentFileIndices.resize(parentsCount);
+        for (int& index : context.parentFileIndices)
+            esm.getT(index);
+
+        return context;
+    }
+
+    bool operator==(const StoreSnapshot::ContentFile& lhs, const StoreSnapshot::ContentFile& rhs)
+    {
+        return std::tie(lhs.mPath, lhs.mSize, lhs.mModificationTime)
+            == std::tie(rhs.mPath, rhs.mSize, rhs.mModificationTime);
+    }
+
+    bool operator==(const StoreSnapshot& lhs, const StoreSnapshot& rhs)
+    {
+        return std::tie(lhs.mFormat, lhs.mEncoding, lhs.mContentFiles)
+            == std::tie(rhs.mFormat, rhs.mEncoding, rhs.mContentFiles);
+    }
+}
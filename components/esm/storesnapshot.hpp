@@ -0,0 +1,53 @@
+#ifndef OPENMW_COMPONENTS_ESM_STORESNAPSHOT_H
+#define OPENMW_COMPONENTS_ESM_STORESNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "esmcommon.hpp"
+
+namespace ESM
+{
+    class ESMReader;
+    class ESMWriter;
+
+    /// First record of a snapshot of records merged from content files, written by the engine to skip content files
+    /// parsing on next startup. Identifies the content files the snapshot was made from. Records that can't keep all
+    /// loaded data in their regular subrecords are followed by a REC_SNXT record with the rest of it.
+    struct StoreSnapshot
+    {
+        static constexpr int sCurrentFormat = 1;
+
+        struct ContentFile
+        {
+            std::string mPath;
+            std::uint64_t mSize = 0;
+            std::int64_t mModificationTime = 0;
+        };
+
+        int mFormat = sCurrentFormat;
+        int mEncoding = -1;
+        std::vector<ContentFile> mContentFiles;
+
+        void load(ESMReader& esm);
+        void save(ESMWriter& esm) const;
+
+        /// Write reader context as CNTX subrecord
+        static void saveContext(ESMWriter& esm, const ESM_Context& context);
+
+        /// Read CNTX subrecord, the subrecord name has to be read already
+        static ESM_Context loadContext(ESMReader& esm);
+    };
+
+    bool operator==(const StoreSnapshot::ContentFile& lhs, const StoreSnapshot::ContentFile& rhs);
+
+    bool operator==(const StoreSnapshot& lhs, const StoreSnapshot& rhs);
+
+    inline bool operator!=(const StoreSnapshot& lhs, const StoreSnapshot& rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
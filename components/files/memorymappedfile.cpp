@@ -0,0 +1,274 @@
+#include "memorymappedfile.hpp"
+
+#include <stdexcept>
+#include <sstream>
+#include <cassert>
+
+#include "memorystream.hpp"
+
+#if FILE_API == FILE_API_STDIO
+#include <cstdio>
+#include <errno.h>
+#include <string.h>
+#endif
+
+#if FILE_API == FILE_API_POSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+#if FILE_API == FILE_API_WIN32
+#include <boost/locale.hpp>
+#endif
+
+namespace
+{
+    struct MemoryMappedFileStream : Files::IMemStream
+    {
+        MemoryMappedFileStream(const Files::MemoryMappedFilePtr& file, size_t start, size_t length)
+            : MemBuf(file->data() + start, length)
+            , IMemStream(file->data() + start, length)
+            , mFile(file)
+        {
+        }
+
+        Files::MemoryMappedFilePtr mFile;
+    };
+}
+
+namespace Files
+{
+
+#if FILE_API == FILE_API_STDIO
+/*
+ *
+ *  Implementation of MemoryMappedFile methods using c stdio, the whole file is read into memory
+ *
+ */
+
+MemoryMappedFile::MemoryMappedFile()
+    : mData(nullptr)
+    , mSize(0)
+    , mOpen(false)
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (mOpen)
+        close();
+}
+
+void MemoryMappedFile::open(const char* filename)
+{
+    assert(!mOpen);
+
+    LowLevelFile file;
+    file.open(filename);
+
+    mBuffer.resize(file.size());
+    size_t got = 0;
+    while (got < mBuffer.size())
+    {
+        size_t read = file.read(mBuffer.data() + got, mBuffer.size() - got);
+        if (read == 0)
+        {
+            std::ostringstream os;
+            os << "Unexpected end of file while reading '" << filename << "'";
+            throw std::runtime_error(os.str());
+        }
+        got += read;
+    }
+
+    mData = mBuffer.data();
+    mSize = mBuffer.size();
+    mOpen = true;
+}
+
+void MemoryMappedFile::close()
+{
+    assert(mOpen);
+
+    std::vector<char>().swap(mBuffer);
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+
+#elif FILE_API == FILE_API_POSIX
+/*
+ *
+ *  Implementation of MemoryMappedFile methods using posix mmap
+ *
+ */
+
+MemoryMappedFile::MemoryMappedFile()
+    : mData(nullptr)
+    , mSize(0)
+    , mOpen(false)
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (mOpen)
+        close();
+}
+
+void MemoryMappedFile::open(const char* filename)
+{
+    assert(!mOpen);
+
+#ifdef O_BINARY
+    static const int openFlags = O_RDONLY | O_BINARY;
+#else
+    static const int openFlags = O_RDONLY;
+#endif
+
+    int handle = ::open(filename, openFlags, 0);
+    if (handle == -1)
+    {
+        std::ostringstream os;
+        os << "Failed to open '" << filename << "' for reading: " << strerror(errno);
+        throw std::runtime_error(os.str());
+    }
+
+    struct stat info;
+    if (::fstat(handle, &info) != 0)
+    {
+        std::ostringstream os;
+        os << "An fstat() call failed for '" << filename << "': " << strerror(errno);
+        ::close(handle);
+        throw std::runtime_error(os.str());
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = nullptr;
+    if (size != 0)
+    {
+        data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, handle, 0);
+        if (data == MAP_FAILED)
+        {
+            std::ostringstream os;
+            os << "Failed to map '" << filename << "' into memory: " << strerror(errno);
+            ::close(handle);
+            throw std::runtime_error(os.str());
+        }
+    }
+
+    // The mapping keeps its own reference to the file, so the descriptor is not needed anymore
+    ::close(handle);
+
+    mData = static_cast<const char*>(data);
+    mSize = size;
+    mOpen = true;
+}
+
+void MemoryMappedFile::close()
+{
+    assert(mOpen);
+
+    if (mData != nullptr)
+        ::munmap(const_cast<char*>(mData), mSize);
+
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+
+#elif FILE_API == FILE_API_WIN32
+/*
+ *
+ *  Implementation of MemoryMappedFile methods using Win32 file mappings
+ *
+ */
+
+MemoryMappedFile::MemoryMappedFile()
+    : mData(nullptr)
+    , mSize(0)
+    , mOpen(false)
+    , mFileHandle(INVALID_HANDLE_VALUE)
+    , mMappingHandle(nullptr)
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (mOpen)
+        close();
+}
+
+void MemoryMappedFile::open(const char* filename)
+{
+    assert(!mOpen);
+
+    std::wstring wname = boost::locale::conv::utf_to_utf<wchar_t>(filename);
+    mFileHandle = CreateFileW(wname.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, 0, 0);
+
+    if (mFileHandle == INVALID_HANDLE_VALUE)
+    {
+        std::ostringstream os;
+        os << "Failed to open '" << filename << "' for reading: " << GetLastError();
+        throw std::runtime_error(os.str());
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mFileHandle, &size))
+    {
+        std::ostringstream os;
+        os << "A GetFileSizeEx() call failed for '" << filename << "': " << GetLastError();
+        CloseHandle(mFileHandle);
+        mFileHandle = INVALID_HANDLE_VALUE;
+        throw std::runtime_error(os.str());
+    }
+
+    mSize = static_cast<size_t>(size.QuadPart);
+    mOpen = true;
+
+    if (mSize == 0)
+        return;
+
+    mMappingHandle = CreateFileMappingW(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMappingHandle != nullptr)
+        mData = static_cast<const char*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+    if (mData == nullptr)
+    {
+        std::ostringstream os;
+        os << "Failed to map '" << filename << "' into memory: " << GetLastError();
+        close();
+        throw std::runtime_error(os.str());
+    }
+}
+
+void MemoryMappedFile::close()
+{
+    assert(mOpen);
+
+    if (mData != nullptr)
+        UnmapViewOfFile(mData);
+    if (mMappingHandle != nullptr)
+        CloseHandle(mMappingHandle);
+    CloseHandle(mFileHandle);
+
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+    mMappingHandle = nullptr;
+    mFileHandle = INVALID_HANDLE_VALUE;
+}
+
+#endif
+
+IStreamPtr openMemoryMappedFileStream(const MemoryMappedFilePtr& file, size_t start, size_t length)
+{
+    assert(file->isOpen() && start + length <= file->size());
+    return std::make_shared<MemoryMappedFileStream>(file, start, length);
+}
+
+}
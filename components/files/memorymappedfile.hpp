@@ -0,0 +1,55 @@
+#ifndef COMPONENTS_FILES_MEMORYMAPPEDFILE_HPP
+#define COMPONENTS_FILES_MEMORYMAPPEDFILE_HPP
+
+#include <memory>
+#include <vector>
+
+#include "lowlevelfile.hpp"
+#include "constrainedfilestream.hpp"
+
+namespace Files
+{
+
+/// A read-only view of a whole file mapped into the address space of the process.
+/// Falls back to reading the file into memory on platforms without a mapping API.
+/// @note The mapping is never modified after open(), so concurrent reads are thread safe.
+class MemoryMappedFile
+{
+public:
+    MemoryMappedFile();
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /// Map the given file. Throws std::runtime_error on failure.
+    void open(const char* filename);
+    void close();
+
+    bool isOpen() const { return mOpen; }
+
+    const char* data() const { return mData; }
+    size_t size() const { return mSize; }
+
+private:
+    const char* mData;
+    size_t mSize;
+    bool mOpen;
+
+#if FILE_API == FILE_API_STDIO
+    std::vector<char> mBuffer;
+#elif FILE_API == FILE_API_WIN32
+    HANDLE mFileHandle;
+    HANDLE mMappingHandle;
+#endif
+};
+
+typedef std::shared_ptr<const MemoryMappedFile> MemoryMappedFilePtr;
+
+/// Open a stream over the region [start, start + length) of a mapped file without copying its contents.
+/// The stream shares ownership of the mapping, so it stays valid as long as the stream is alive.
+IStreamPtr openMemoryMappedFileStream(const MemoryMappedFilePtr& file, size_t start, size_t length);
+
+}
+
+#endif
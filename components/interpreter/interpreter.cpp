@@ -4,90 +4,202 @@
 #include <stdexcept>
 
 #include "opcodes.hpp"
+#include "genericopcodes.hpp"
+#include "controlopcodes.hpp"
 
 namespace Interpreter
 {
-    void Interpreter::execute (Type_Code code)
+    Instruction Interpreter::makeInstruction (Opcode0 *opcode)
     {
-        unsigned int segSpec = code>>30;
-
-        switch (segSpec)
+        Instruction instruction;
+        instruction.mArg0 = 0;
+        instruction.mOpcode0 = nullptr;
+
+        // Control flow is executed by the interpreter loop without a virtual call
+        if (dynamic_cast<OpReturn *> (opcode))
+            instruction.mKind = Instruction::Kind_Return;
+        else if (dynamic_cast<OpSkipZero *> (opcode))
+            instruction.mKind = Instruction::Kind_SkipZero;
+        else if (dynamic_cast<OpSkipNonZero *> (opcode))
+            instruction.mKind = Instruction::Kind_SkipNonZero;
+        else
         {
-            case 0:
-            {
-                int opcode = code>>24;
-                unsigned int arg0 = code & 0xffffff;
+            instruction.mKind = Instruction::Kind_Opcode0;
+            instruction.mOpcode0 = opcode;
+            return instruction;
+        }
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment0.find (opcode);
+        delete opcode;
+        return instruction;
+    }
 
-                if (iter==mSegment0.end())
-                    abortUnknownCode (0, opcode);
+    Instruction Interpreter::makeInstruction (Opcode1 *opcode)
+    {
+        Instruction instruction;
+        instruction.mArg0 = 0;
+        instruction.mOpcode1 = nullptr;
+
+        if (dynamic_cast<OpPushInt *> (opcode))
+            instruction.mKind = Instruction::Kind_PushInt;
+        else if (dynamic_cast<OpJumpForward *> (opcode))
+            instruction.mKind = Instruction::Kind_JumpForward;
+        else if (dynamic_cast<OpJumpBackward *> (opcode))
+            instruction.mKind = Instruction::Kind_JumpBackward;
+        else
+        {
+            instruction.mKind = Instruction::Kind_Opcode1;
+            instruction.mOpcode1 = opcode;
+            return instruction;
+        }
 
-                iter->second->execute (mRuntime, arg0);
+        delete opcode;
+        return instruction;
+    }
 
-                return;
-            }
+    Instruction Interpreter::decode (Type_Code code) const
+    {
+        Instruction unknown;
+        unknown.mKind = Instruction::Kind_Unknown;
+        unknown.mArg0 = code;
+        unknown.mOpcode0 = nullptr;
 
-            case 2:
-            {
-                int opcode = (code>>20) & 0x3ff;
-                unsigned int arg0 = code & 0xfffff;
+        const auto find = [&] (const std::unordered_map<int, Instruction>& segment, int opcode, unsigned int arg0)
+        {
+            std::unordered_map<int, Instruction>::const_iterator iter = segment.find (opcode);
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment2.find (opcode);
+            if (iter==segment.end())
+                return unknown;
 
-                if (iter==mSegment2.end())
-                    abortUnknownCode (2, opcode);
+            Instruction instruction = iter->second;
+            instruction.mArg0 = arg0;
+            return instruction;
+        };
 
-                iter->second->execute (mRuntime, arg0);
+        unsigned int segSpec = code>>30;
 
-                return;
-            }
+        switch (segSpec)
+        {
+            case 0: return find (mSegment0, code>>24, code & 0xffffff);
+            case 2: return find (mSegment2, (code>>20) & 0x3ff, code & 0xfffff);
         }
 
         segSpec = code>>26;
 
         switch (segSpec)
         {
-            case 0x30:
+            case 0x30: return find (mSegment3, (code>>8) & 0x3ffff, code & 0xff);
+            case 0x32: return find (mSegment5, code & 0x3ffffff, 0);
+        }
+
+        return unknown;
+    }
+
+    void Interpreter::execute (const std::vector<Instruction>& instructions)
+    {
+        const Instruction *code = instructions.data();
+        const int size = static_cast<int> (instructions.size());
+
+        for (int pc = 0; pc>=0 && pc<size;)
+        {
+            const Instruction& instruction = code[pc];
+            ++pc;
+            ++mInstructionsCount;
+
+            switch (instruction.mKind)
             {
-                int opcode = (code>>8) & 0x3ffff;
-                unsigned int arg0 = code & 0xff;
+                case Instruction::Kind_Opcode0:
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment3.find (opcode);
+                    mRuntime.setPC (pc);
+                    instruction.mOpcode0->execute (mRuntime);
+                    pc = mRuntime.getPC();
+                    break;
 
-                if (iter==mSegment3.end())
-                    abortUnknownCode (3, opcode);
+                case Instruction::Kind_Opcode1:
 
-                iter->second->execute (mRuntime, arg0);
+                    mRuntime.setPC (pc);
+                    instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+                    pc = mRuntime.getPC();
+                    break;
 
-                return;
-            }
+                case Instruction::Kind_PushInt:
 
-            case 0x32:
-            {
-                int opcode = code & 0x3ffffff;
+                    mRuntime.push (static_cast<Type_Integer> (instruction.mArg0));
+                    break;
+
+                case Instruction::Kind_Return:
+
+                    pc = -1;
+                    break;
+
+                case Instruction::Kind_SkipZero:
+                {
+                    Type_Integer data = mRuntime[0].mInteger;
+                    mRuntime.pop();
+
+                    if (data==0)
+                        ++pc;
+
+                    break;
+                }
+
+                case Instruction::Kind_SkipNonZero:
+                {
+                    Type_Integer data = mRuntime[0].mInteger;
+                    mRuntime.pop();
+
+                    if (data!=0)
+                        ++pc;
+
+                    break;
+                }
 
-                std::map<int, Opcode0 *>::iterator iter = mSegment5.find (opcode);
+                case Instruction::Kind_JumpForward:
 
-                if (iter==mSegment5.end())
-                    abortUnknownCode (5, opcode);
+                    if (instruction.mArg0==0)
+                        throw std::logic_error ("infinite loop");
 
-                iter->second->execute (mRuntime);
+                    pc += instruction.mArg0 - 1;
+                    break;
 
-                return;
+                case Instruction::Kind_JumpBackward:
+
+                    if (instruction.mArg0==0)
+                        throw std::logic_error ("infinite loop");
+
+                    pc -= instruction.mArg0 + 1;
+                    break;
+
+                case Instruction::Kind_Unknown:
+
+                    abortUnknown (instruction.mArg0);
             }
         }
+    }
+
+    void Interpreter::abortUnknown (Type_Code code) const
+    {
+        switch (code>>30)
+        {
+            case 0: abortUnknownCode (0, code>>24);
+            case 2: abortUnknownCode (2, (code>>20) & 0x3ff);
+        }
+
+        switch (code>>26)
+        {
+            case 0x30: abortUnknownCode (3, (code>>8) & 0x3ffff);
+            case 0x32: abortUnknownCode (5, code & 0x3ffffff);
+        }
 
         abortUnknownSegment (code);
     }
 
-    void Interpreter::abortUnknownCode (int segment, int opcode)
+    void Interpreter::abortUnknownCode (int segment, int opcode) const
     {
         const std::string error = "unknown opcode " + std::to_string(opcode) + " in segment " + std::to_string(segment);
         throw std::runtime_error (error);
     }
 
-    void Interpreter::abortUnknownSegment (Type_Code code)
+    void Interpreter::abortUnknownSegment (Type_Code code) const
     {
         const std::string error = "opcode outside of the allocated segment range: " + std::to_string(code);
         throw std::runtime_error (error);
@@ -120,72 +232,75 @@ namespace Interpreter
         }
     }
 
-    Interpreter::Interpreter() : mRunning (false)
+    Interpreter::Interpreter() : mRunning (false), mInstructionsCount (0)
     {}
 
     Interpreter::~Interpreter()
     {
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment0.begin());
-            iter!=mSegment0.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment2.begin());
-            iter!=mSegment2.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode1 *>::iterator iter (mSegment3.begin());
-            iter!=mSegment3.end(); ++iter)
-            delete iter->second;
-
-        for (std::map<int, Opcode0 *>::iterator iter (mSegment5.begin());
-            iter!=mSegment5.end(); ++iter)
-            delete iter->second;
+        for (const auto* segment : {&mSegment0, &mSegment2, &mSegment3, &mSegment5})
+            for (const auto& item : *segment)
+            {
+                if (item.second.mKind==Instruction::Kind_Opcode0)
+                    delete item.second.mOpcode0;
+                else if (item.second.mKind==Instruction::Kind_Opcode1)
+                    delete item.second.mOpcode1;
+            }
     }
 
     void Interpreter::installSegment0 (int code, Opcode1 *opcode)
     {
         assert(mSegment0.find(code) == mSegment0.end());
-        mSegment0.insert (std::make_pair (code, opcode));
+        mSegment0.emplace (code, makeInstruction (opcode));
     }
 
     void Interpreter::installSegment2 (int code, Opcode1 *opcode)
     {
         assert(mSegment2.find(code) == mSegment2.end());
-        mSegment2.insert (std::make_pair (code, opcode));
+        mSegment2.emplace (code, makeInstruction (opcode));
     }
 
     void Interpreter::installSegment3 (int code, Opcode1 *opcode)
     {
         assert(mSegment3.find(code) == mSegment3.end());
-        mSegment3.insert (std::make_pair (code, opcode));
+        mSegment3.emplace (code, makeInstruction (opcode));
     }
 
     void Interpreter::installSegment5 (int code, Opcode0 *opcode)
     {
         assert(mSegment5.find(code) == mSegment5.end());
-        mSegment5.insert (std::make_pair (code, opcode));
+        mSegment5.emplace (code, makeInstruction (opcode));
     }
 
-    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    Program Interpreter::decode (const Type_Code *code, int codeSize) const
     {
         assert (codeSize>=4);
 
+        const int opcodes = static_cast<int> (code[0]);
+
+        if (opcodes<0 || opcodes>codeSize-4)
+            throw std::runtime_error ("opcodes block exceeds code size");
+
+        Program program;
+        program.mCode.assign (code, code + codeSize);
+        program.mInstructions.reserve (opcodes);
+
+        const Type_Code *codeBlock = code + 4;
+
+        for (int i=0; i<opcodes; ++i)
+            program.mInstructions.push_back (decode (codeBlock[i]));
+
+        return program;
+    }
+
+    void Interpreter::run (const Program& program, Context& context)
+    {
         begin();
 
         try
         {
-            mRuntime.configure (code, codeSize, context);
-
-            int opcodes = static_cast<int> (code[0]);
-
-            const Type_Code *codeBlock = code + 4;
+            mRuntime.configure (program.mCode.data(), static_cast<int> (program.mCode.size()), context);
 
-            while (mRuntime.getPC()>=0 && mRuntime.getPC()<opcodes)
-            {
-                Type_Code runCode = codeBlock[mRuntime.getPC()];
-                mRuntime.setPC (mRuntime.getPC()+1);
-                execute (runCode);
-            }
+            execute (program.mInstructions);
         }
         catch (...)
         {
@@ -195,4 +310,14 @@ namespace Interpreter
 
         end();
     }
+
+    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    {
+        run (decode (code, codeSize), context);
+    }
+
+    std::uint64_t Interpreter::getInstructionsCount() const
+    {
+        return mInstructionsCount;
+    }
 }
@@ -1,9 +1,11 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
+#include <cstdint>
 #include <stack>
+#include <unordered_map>
 
+#include "program.hpp"
 #include "runtime.hpp"
 #include "types.hpp"
 
@@ -17,20 +19,30 @@ namespace Interpreter
             std::stack<Runtime> mCallstack;
             bool mRunning;
             Runtime mRuntime;
-            std::map<int, Opcode1 *> mSegment0;
-            std::map<int, Opcode1 *> mSegment2;
-            std::map<int, Opcode1 *> mSegment3;
-            std::map<int, Opcode0 *> mSegment5;
+            std::uint64_t mInstructionsCount;
+            // Installed opcodes as instructions without argument
+            std::unordered_map<int, Instruction> mSegment0;
+            std::unordered_map<int, Instruction> mSegment2;
+            std::unordered_map<int, Instruction> mSegment3;
+            std::unordered_map<int, Instruction> mSegment5;
 
             // not implemented
             Interpreter (const Interpreter&);
             Interpreter& operator= (const Interpreter&);
 
-            void execute (Type_Code code);
+            static Instruction makeInstruction (Opcode0 *opcode);
 
-            void abortUnknownCode (int segment, int opcode);
+            static Instruction makeInstruction (Opcode1 *opcode);
 
-            void abortUnknownSegment (Type_Code code);
+            Instruction decode (Type_Code code) const;
+
+            void execute (const std::vector<Instruction>& instructions);
+
+            [[noreturn]] void abortUnknown (Type_Code code) const;
+
+            [[noreturn]] void abortUnknownCode (int segment, int opcode) const;
+
+            [[noreturn]] void abortUnknownSegment (Type_Code code) const;
 
             void begin();
 
@@ -54,7 +66,17 @@ namespace Interpreter
             void installSegment5 (int code, Opcode0 *opcode);
             ///< ownership of \a opcode is transferred to *this.
 
+            Program decode (const Type_Code *code, int codeSize) const;
+            ///< Decode instructions once to run them multiple times. Unknown opcodes are reported
+            /// when executed. Installed opcodes must not change while the result is used.
+
+            void run (const Program& program, Context& context);
+
             void run (const Type_Code *code, int codeSize, Context& context);
+            ///< Decode and run \a code.
+
+            std::uint64_t getInstructionsCount() const;
+            ///< Return number of instructions executed since construction.
     };
 }
 
@@ -0,0 +1,48 @@
+#ifndef INTERPRETER_PROGRAM_H_INCLUDED
+#define INTERPRETER_PROGRAM_H_INCLUDED
+
+#include <vector>
+
+#include "types.hpp"
+
+namespace Interpreter
+{
+    class Opcode0;
+    class Opcode1;
+
+    /// Bytecode instruction decoded by the Interpreter, so executing it doesn't need opcode lookups.
+    struct Instruction
+    {
+        enum Kind
+        {
+            Kind_Opcode0,
+            Kind_Opcode1,
+            Kind_PushInt,
+            Kind_Return,
+            Kind_SkipZero,
+            Kind_SkipNonZero,
+            Kind_JumpForward,
+            Kind_JumpBackward,
+            Kind_Unknown ///< mArg0 is the whole code, the error is reported when the instruction is executed
+        };
+
+        Kind mKind;
+        unsigned int mArg0;
+
+        union
+        {
+            Opcode0 *mOpcode0;
+            Opcode1 *mOpcode1;
+        };
+    };
+
+    /// Bytecode with decoded instructions.
+    /// \note Valid only for the Interpreter that has decoded it and as long as its opcodes exist.
+    struct Program
+    {
+        std::vector<Type_Code> mCode;
+        std::vector<Instruction> mInstructions;
+    };
+}
+
+#endif
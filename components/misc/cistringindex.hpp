@@ -0,0 +1,139 @@
+#ifndef OPENMW_COMPONENTS_MISC_CISTRINGINDEX_H
+#define OPENMW_COMPONENTS_MISC_CISTRINGINDEX_H
+
+#include "stringops.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// \class CiStringIndex
+    /// Open addressing hash table mapping case insensitive string keys to non-negative integer values.
+    /// Keys are stored in lower case once on insertion, lookups don't allocate.
+    class CiStringIndex
+    {
+    public:
+        /// \return Value associated with the key or -1 if there is no such key.
+        int find(const std::string& key) const
+        {
+            if (mSlots.empty())
+                return -1;
+            const std::size_t hash = StringUtils::ciHash(key);
+            for (std::size_t i = hash & mMask; ; i = (i + 1) & mMask)
+            {
+                const Slot& slot = mSlots[i];
+                if (slot.mValue < 0)
+                    return -1;
+                if (slot.mHash == hash && equal(slot.mKey, key))
+                    return slot.mValue;
+            }
+        }
+
+        /// Associates value with the key if there is no such key yet.
+        /// \return Value associated with the key and whether insertion took place.
+        std::pair<int, bool> insert(const std::string& key, int value)
+        {
+            if ((mSize + 1) * 2 > mSlots.size())
+                rehash(mSlots.empty() ? 16 : mSlots.size() * 2);
+            const std::size_t hash = StringUtils::ciHash(key);
+            std::size_t i = hash & mMask;
+            for (; mSlots[i].mValue >= 0; i = (i + 1) & mMask)
+                if (mSlots[i].mHash == hash && equal(mSlots[i].mKey, key))
+                    return {mSlots[i].mValue, false};
+            mSlots[i].mHash = hash;
+            mSlots[i].mKey = StringUtils::lowerCase(key);
+            mSlots[i].mValue = value;
+            ++mSize;
+            return {value, true};
+        }
+
+        /// \return Value associated with the removed key or -1 if there is no such key.
+        int erase(const std::string& key)
+        {
+            if (mSlots.empty())
+                return -1;
+            const std::size_t hash = StringUtils::ciHash(key);
+            std::size_t i = hash & mMask;
+            for (; mSlots[i].mValue >= 0; i = (i + 1) & mMask)
+                if (mSlots[i].mHash == hash && equal(mSlots[i].mKey, key))
+                    break;
+            const int result = mSlots[i].mValue;
+            if (result < 0)
+                return -1;
+            // Backward shift deletion keeps probe sequences intact without tombstones
+            for (std::size_t j = (i + 1) & mMask; mSlots[j].mValue >= 0; j = (j + 1) & mMask)
+            {
+                const std::size_t home = mSlots[j].mHash & mMask;
+                if (((j - home) & mMask) >= ((j - i) & mMask))
+                {
+                    mSlots[i] = std::move(mSlots[j]);
+                    i = j;
+                }
+            }
+            mSlots[i] = Slot();
+            --mSize;
+            return result;
+        }
+
+        void clear()
+        {
+            mSlots.clear();
+            mMask = 0;
+            mSize = 0;
+        }
+
+        std::size_t size() const { return mSize; }
+
+        /// Calls f(key, value) for each stored pair in unspecified order, keys are in lower case.
+        template <class F>
+        void forEach(F&& f) const
+        {
+            for (const Slot& slot : mSlots)
+                if (slot.mValue >= 0)
+                    f(slot.mKey, slot.mValue);
+        }
+
+    private:
+        struct Slot
+        {
+            std::size_t mHash = 0;
+            int mValue = -1;
+            std::string mKey;
+        };
+
+        std::vector<Slot> mSlots;
+        std::size_t mMask = 0;
+        std::size_t mSize = 0;
+
+        static bool equal(const std::string& lowerCaseKey, const std::string& key)
+        {
+            if (lowerCaseKey.size() != key.size())
+                return false;
+            for (std::size_t i = 0; i < key.size(); ++i)
+                if (lowerCaseKey[i] != StringUtils::toLower(key[i]))
+                    return false;
+            return true;
+        }
+
+        void rehash(std::size_t size)
+        {
+            std::vector<Slot> slots(size);
+            std::swap(slots, mSlots);
+            mMask = size - 1;
+            for (Slot& slot : slots)
+            {
+                if (slot.mValue < 0)
+                    continue;
+                std::size_t i = slot.mHash & mMask;
+                while (mSlots[i].mValue >= 0)
+                    i = (i + 1) & mMask;
+                mSlots[i] = std::move(slot);
+            }
+        }
+    };
+}
+
+#endif
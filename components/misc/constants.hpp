@@ -27,6 +27,12 @@ const int CellSizeInUnits = 8192;
 // Size of active cell grid in cells (it is a square with the (2 * CellGridRadius + 1) cells side)
 const int CellGridRadius = 1;
 
+// Maximum height of a step actors can climb in game units
+const float StepSizeUp = 34.0f;
+
+// Maximum slope actors can walk on in degrees
+const float MaxSlope = 49.0f;
+
 // A label to mark night/day visual switches
 const std::string NightDayLabel = "NightDaySwitch";
 
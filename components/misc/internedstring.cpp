@@ -0,0 +1,115 @@
+#include "internedstring.hpp"
+
+#include "stringops.hpp"
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Misc
+{
+    namespace
+    {
+        bool equal(const std::string& lowerCaseValue, std::string_view value)
+        {
+            if (lowerCaseValue.size() != value.size())
+                return false;
+            for (std::size_t i = 0; i < value.size(); ++i)
+                if (lowerCaseValue[i] != StringUtils::toLower(value[i]))
+                    return false;
+            return true;
+        }
+
+        /// Open addressing hash set of interned strings, values are stored in a deque to keep their addresses.
+        class Shard
+        {
+        public:
+            const std::string* find(std::size_t hash, std::string_view value) const
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                return mSlots.empty() ? nullptr : mSlots[findSlot(hash, value)].mValue;
+            }
+
+            const std::string* insert(std::size_t hash, std::string_view value)
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                if ((mValues.size() + 1) * 2 > mSlots.size())
+                    rehash(mSlots.empty() ? 64 : mSlots.size() * 2);
+                Slot& slot = mSlots[findSlot(hash, value)];
+                if (slot.mValue == nullptr)
+                {
+                    std::string& stored = mValues.emplace_back(value);
+                    for (char& c : stored)
+                        c = StringUtils::toLower(c);
+                    slot.mHash = hash;
+                    slot.mValue = &stored;
+                }
+                return slot.mValue;
+            }
+
+        private:
+            struct Slot
+            {
+                std::size_t mHash = 0;
+                const std::string* mValue = nullptr;
+            };
+
+            mutable std::mutex mMutex;
+            std::vector<Slot> mSlots;
+            std::deque<std::string> mValues;
+
+            /// \return Index of the slot with equal value or the first empty slot of the probe sequence.
+            std::size_t findSlot(std::size_t hash, std::string_view value) const
+            {
+                const std::size_t mask = mSlots.size() - 1;
+                std::size_t i = hash & mask;
+                while (mSlots[i].mValue != nullptr && (mSlots[i].mHash != hash || !equal(*mSlots[i].mValue, value)))
+                    i = (i + 1) & mask;
+                return i;
+            }
+
+            void rehash(std::size_t size)
+            {
+                std::vector<Slot> slots(size);
+                std::swap(slots, mSlots);
+                for (const Slot& slot : slots)
+                {
+                    if (slot.mValue == nullptr)
+                        continue;
+                    std::size_t i = slot.mHash & (size - 1);
+                    while (mSlots[i].mValue != nullptr)
+                        i = (i + 1) & (size - 1);
+                    mSlots[i] = slot;
+                }
+            }
+        };
+
+        // Strings are interned concurrently by loading threads, sharding reduces the lock contention
+        constexpr std::size_t shardBits = 4;
+
+        Shard& getShard(std::size_t hash)
+        {
+            static std::array<Shard, 1 << shardBits> shards;
+            return shards[hash >> (sizeof(std::size_t) * 8 - shardBits)];
+        }
+    }
+
+    InternedString::InternedString(std::string_view value)
+    {
+        const std::size_t hash = StringUtils::ciHash(value.data(), value.size());
+        mValue = getShard(hash).insert(hash, value);
+    }
+
+    InternedString InternedString::find(std::string_view value)
+    {
+        const std::size_t hash = StringUtils::ciHash(value.data(), value.size());
+        return InternedString(getShard(hash).find(hash, value));
+    }
+
+    const std::string& InternedString::str() const
+    {
+        static const std::string empty;
+        return mValue == nullptr ? empty : *mValue;
+    }
+}
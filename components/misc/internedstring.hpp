@@ -0,0 +1,57 @@
+#ifndef OPENMW_COMPONENTS_MISC_INTERNEDSTRING_H
+#define OPENMW_COMPONENTS_MISC_INTERNEDSTRING_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Misc
+{
+    /// \class InternedString
+    /// Handle to a lower case string stored once in a process wide table. Case insensitively equal strings have
+    /// equal handles, so comparison and hashing of handles don't look at characters. Interned strings are never
+    /// freed, intern only names from a bounded set like node names and record ids. Thread safe.
+    class InternedString
+    {
+    public:
+        /// Null handle not equal to any interned string including the empty one.
+        InternedString() = default;
+
+        /// Interns the lower case copy of the value if there is no case insensitively equal string yet.
+        explicit InternedString(std::string_view value);
+
+        /// \return Handle of already interned case insensitively equal string or null handle. Doesn't intern.
+        static InternedString find(std::string_view value);
+
+        bool isNull() const { return mValue == nullptr; }
+
+        /// \return Lower case string, empty for null handle.
+        const std::string& str() const;
+
+        friend bool operator==(InternedString lhs, InternedString rhs) { return lhs.mValue == rhs.mValue; }
+
+        friend bool operator!=(InternedString lhs, InternedString rhs) { return lhs.mValue != rhs.mValue; }
+
+        std::size_t hash() const { return std::hash<const std::string*>()(mValue); }
+
+    private:
+        const std::string* mValue = nullptr;
+
+        explicit InternedString(const std::string* value) : mValue(value) {}
+    };
+}
+
+namespace std
+{
+    template <>
+    struct hash<Misc::InternedString>
+    {
+        std::size_t operator()(Misc::InternedString value) const
+        {
+            return value.hash();
+        }
+    };
+}
+
+#endif
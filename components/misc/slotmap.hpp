@@ -0,0 +1,195 @@
+#ifndef OPENMW_COMPONENTS_MISC_SLOTMAP_H
+#define OPENMW_COMPONENTS_MISC_SLOTMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// Container addressing values by handles that become invalid when the value is erased, even if its slot is
+    /// reused later. Values are stored in contiguous blocks and iterated in slot order. Values are never moved, so
+    /// references stay valid until the value is erased. Iteration by index tolerates insertion and erasure of other
+    /// values: new values are visited only if they take a free slot after the current one or are appended.
+    template <class T>
+    class SlotMap
+    {
+        struct Slot
+        {
+            std::optional<T> mValue;
+            std::uint32_t mGeneration = 0;
+        };
+
+    public:
+        struct Handle
+        {
+            std::uint32_t mIndex = 0;
+            std::uint32_t mGeneration = 0;
+
+            friend bool operator==(const Handle& lhs, const Handle& rhs)
+            {
+                return lhs.mIndex == rhs.mIndex && lhs.mGeneration == rhs.mGeneration;
+            }
+
+            friend bool operator!=(const Handle& lhs, const Handle& rhs)
+            {
+                return !(lhs == rhs);
+            }
+        };
+
+        template <class Map, class Value>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            Iterator(Map& map, std::size_t index)
+                : mMap(&map), mIndex(index)
+            {
+                skipEmpty();
+            }
+
+            reference operator*() const { return *mMap->mSlots[mIndex].mValue; }
+
+            pointer operator->() const { return &*mMap->mSlots[mIndex].mValue; }
+
+            Handle getHandle() const { return Handle {static_cast<std::uint32_t>(mIndex), mMap->mSlots[mIndex].mGeneration}; }
+
+            Iterator& operator++()
+            {
+                ++mIndex;
+                skipEmpty();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator result = *this;
+                ++*this;
+                return result;
+            }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.mIndex == rhs.mIndex; }
+
+            friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.mIndex != rhs.mIndex; }
+
+        private:
+            Map* mMap;
+            std::size_t mIndex;
+
+            void skipEmpty()
+            {
+                while (mIndex < mMap->mSlots.size() && !mMap->mSlots[mIndex].mValue.has_value())
+                    ++mIndex;
+            }
+        };
+
+        using iterator = Iterator<SlotMap, T>;
+        using const_iterator = Iterator<const SlotMap, const T>;
+
+        std::size_t size() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        template <class ... Args>
+        Handle emplace(Args&& ... args)
+        {
+            std::uint32_t index;
+            if (mFreeSlots.empty())
+            {
+                index = static_cast<std::uint32_t>(mSlots.size());
+                mSlots.emplace_back();
+            }
+            else
+            {
+                index = mFreeSlots.back();
+                mFreeSlots.pop_back();
+            }
+            Slot& slot = mSlots[index];
+            slot.mValue.emplace(std::forward<Args>(args) ...);
+            ++mSize;
+            return Handle {index, slot.mGeneration};
+        }
+
+        /// Returns false if the handle is invalid
+        bool erase(Handle handle)
+        {
+            if (get(handle) == nullptr)
+                return false;
+            Slot& slot = mSlots[handle.mIndex];
+            slot.mValue.reset();
+            ++slot.mGeneration;
+            mFreeSlots.push_back(handle.mIndex);
+            --mSize;
+            return true;
+        }
+
+        T* get(Handle handle)
+        {
+            return const_cast<T*>(std::as_const(*this).get(handle));
+        }
+
+        const T* get(Handle handle) const
+        {
+            if (handle.mIndex >= mSlots.size())
+                return nullptr;
+            const Slot& slot = mSlots[handle.mIndex];
+            if (slot.mGeneration != handle.mGeneration || !slot.mValue.has_value())
+                return nullptr;
+            return &*slot.mValue;
+        }
+
+        /// Returns end() if the handle is invalid
+        iterator find(Handle handle)
+        {
+            return get(handle) == nullptr ? end() : iterator(*this, handle.mIndex);
+        }
+
+        const_iterator find(Handle handle) const
+        {
+            return get(handle) == nullptr ? end() : const_iterator(*this, handle.mIndex);
+        }
+
+        /// Keeps the slots to invalidate existing handles
+        void clear()
+        {
+            mFreeSlots.clear();
+            for (std::size_t i = mSlots.size(); i > 0; --i)
+            {
+                Slot& slot = mSlots[i - 1];
+                if (slot.mValue.has_value())
+                {
+                    slot.mValue.reset();
+                    ++slot.mGeneration;
+                }
+                mFreeSlots.push_back(static_cast<std::uint32_t>(i - 1));
+            }
+            mSize = 0;
+        }
+
+        iterator begin() { return iterator(*this, 0); }
+
+        iterator end() { return iterator(*this, mSlots.size()); }
+
+        const_iterator begin() const { return const_iterator(*this, 0); }
+
+        const_iterator end() const { return const_iterator(*this, mSlots.size()); }
+
+    private:
+        std::deque<Slot> mSlots;
+        // Reused in LIFO order to keep recently touched blocks in cache
+        std::vector<std::uint32_t> mFreeSlots;
+        std::size_t mSize = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALHASH_H
+#define OPENMW_COMPONENTS_MISC_SPATIALHASH_H
+
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace Misc
+{
+    /// Uniform grid over XY plane to find values near a position without checking all of them.
+    /// Values are inserted with their positions and then build() is called to make queries possible. The grid doesn't
+    /// track value movement, clear and fill it again when positions change.
+    template <class T>
+    class SpatialHash
+    {
+    public:
+        explicit SpatialHash(float cellSize)
+            : mCellSize(cellSize)
+        {}
+
+        float getCellSize() const
+        {
+            return mCellSize;
+        }
+
+        std::size_t size() const
+        {
+            return mEntries.size();
+        }
+
+        bool isBuilt() const
+        {
+            return mBuilt;
+        }
+
+        void clear()
+        {
+            mEntries.clear();
+            mPositions.clear();
+            mValues.clear();
+            mCells.clear();
+            mIndex.clear();
+            mBuilt = false;
+        }
+
+        void insert(const osg::Vec3f& position, const T& value)
+        {
+            mEntries.push_back(Entry {getCellPosition(position.x()), getCellPosition(position.y()), position, value});
+            mBuilt = false;
+        }
+
+        void build()
+        {
+            // Stable sort keeps insertion order of values within a cell
+            std::stable_sort(mEntries.begin(), mEntries.end(),
+                [] (const Entry& lhs, const Entry& rhs) { return std::tie(lhs.mX, lhs.mY) < std::tie(rhs.mX, rhs.mY); });
+
+            mCells.clear();
+            mIndex.clear();
+            mPositions.clear();
+            mValues.clear();
+            mMinX = std::numeric_limits<std::int32_t>::max();
+            mMaxX = std::numeric_limits<std::int32_t>::min();
+            mMinY = std::numeric_limits<std::int32_t>::max();
+            mMaxY = std::numeric_limits<std::int32_t>::min();
+
+            // Queries read positions of all values in a cell, keep them close to each other
+            mPositions.reserve(mEntries.size());
+            mValues.reserve(mEntries.size());
+
+            for (std::size_t i = 0; i < mEntries.size(); ++i)
+            {
+                const Entry& entry = mEntries[i];
+                mPositions.push_back(entry.mPosition);
+                mValues.push_back(entry.mValue);
+                if (mCells.empty() || mCells.back().mX != entry.mX || mCells.back().mY != entry.mY)
+                {
+                    mIndex.emplace(getKey(entry.mX, entry.mY), mCells.size());
+                    mCells.push_back(Cell {entry.mX, entry.mY, i, i});
+                }
+                mCells.back().mEnd = i + 1;
+                mMinX = std::min(mMinX, entry.mX);
+                mMaxX = std::max(mMaxX, entry.mX);
+                mMinY = std::min(mMinY, entry.mY);
+                mMaxY = std::max(mMaxY, entry.mY);
+            }
+
+            mBuilt = true;
+        }
+
+        /// Call function(value, position) for each value within radius from position in 3D.
+        /// Values of one cell are visited in insertion order, cells are visited in unspecified order.
+        template <class Function>
+        void forEachInRange(const osg::Vec3f& position, float radius, Function&& function) const
+        {
+            const float radius2 = radius * radius;
+            const std::int32_t minX = getCellPosition(position.x() - radius);
+            const std::int32_t maxX = getCellPosition(position.x() + radius);
+            const std::int32_t minY = getCellPosition(position.y() - radius);
+            const std::int32_t maxY = getCellPosition(position.y() + radius);
+
+            const auto visit = [&] (const Cell& cell)
+            {
+                for (std::size_t i = cell.mBegin; i < cell.mEnd; ++i)
+                    if ((mPositions[i] - position).length2() <= radius2)
+                        function(mValues[i], mPositions[i]);
+            };
+
+            const double cellsInRange = (static_cast<double>(maxX) - minX + 1) * (static_cast<double>(maxY) - minY + 1);
+
+            // For a large radius it's cheaper to check all non-empty cells than to look up each cell in range
+            if (minX <= mMinX && maxX >= mMaxX && minY <= mMinY && maxY >= mMaxY)
+            {
+                for (std::size_t i = 0; i < mPositions.size(); ++i)
+                    if ((mPositions[i] - position).length2() <= radius2)
+                        function(mValues[i], mPositions[i]);
+                return;
+            }
+
+            if (cellsInRange >= static_cast<double>(mCells.size()))
+            {
+                for (const Cell& cell : mCells)
+                    if (cell.mX >= minX && cell.mX <= maxX && cell.mY >= minY && cell.mY <= maxY)
+                        visit(cell);
+                return;
+            }
+
+            for (std::int32_t x = minX; x <= maxX; ++x)
+            {
+                for (std::int32_t y = minY; y <= maxY; ++y)
+                {
+                    const auto it = mIndex.find(getKey(x, y));
+                    if (it != mIndex.end())
+                        visit(mCells[it->second]);
+                }
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            std::int32_t mX;
+            std::int32_t mY;
+            osg::Vec3f mPosition;
+            T mValue;
+        };
+
+        struct Cell
+        {
+            std::int32_t mX;
+            std::int32_t mY;
+            std::size_t mBegin;
+            std::size_t mEnd;
+        };
+
+        float mCellSize;
+        bool mBuilt = false;
+        std::vector<Entry> mEntries;
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<T> mValues;
+        std::int32_t mMinX = 0;
+        std::int32_t mMaxX = 0;
+        std::int32_t mMinY = 0;
+        std::int32_t mMaxY = 0;
+        std::vector<Cell> mCells;
+        std::unordered_map<std::uint64_t, std::size_t> mIndex;
+
+        std::int32_t getCellPosition(float value) const
+        {
+            const double result = std::floor(static_cast<double>(value) / mCellSize);
+            return static_cast<std::int32_t>(std::clamp(result,
+                static_cast<double>(std::numeric_limits<std::int32_t>::min() / 2),
+                static_cast<double>(std::numeric_limits<std::int32_t>::max() / 2)));
+        }
+
+        static std::uint64_t getKey(std::int32_t x, std::int32_t y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+                | static_cast<std::uint64_t>(static_cast<std::uint32_t>(y));
+        }
+    };
+}
+
+#endif
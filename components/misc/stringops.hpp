@@ -2,6 +2,7 @@
 #define MISC_STRINGOPS_H
 
 #include <cctype>
+#include <cstdint>
 #include <string>
 #include <algorithm>
 
@@ -172,6 +173,23 @@ public:
         }
     };
 
+    /// Returns FNV-1a hash of the lower case version of the string w/o copy
+    static std::size_t ciHash(const char* data, std::size_t size)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char>(toLower(data[i]));
+            hash *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+    static std::size_t ciHash(const std::string& value)
+    {
+        return ciHash(value.data(), value.size());
+    }
+
 
     /// Performs a binary search on a sorted container for a string that 'key' starts with
     template<typename Iterator, typename T>
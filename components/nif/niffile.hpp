@@ -92,7 +92,7 @@ public:
     };
 
     /// Used if file parsing fails
-    void fail(const std::string &msg) const
+    [[noreturn]] void fail(const std::string &msg) const
     {
         std::string err = " NIFFile Error: " + msg;
         err += "\nFile: " + filename;
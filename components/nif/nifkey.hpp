@@ -5,8 +5,12 @@
 
 #include "nifstream.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <sstream>
-#include <map>
+#include <type_traits>
+#include <vector>
 
 #include "niffile.hpp"
 
@@ -41,15 +45,30 @@ using Vector3Key = KeyT<osg::Vec3f>;
 using Vector4Key = KeyT<osg::Vec4f>;
 using QuaternionKey = KeyT<osg::Quat>;
 
+/// Keyframe track stored as parallel arrays, so searching for a time reads only contiguous times and interpolation
+/// reads only the values it needs.
 template<typename T, T (NIFStream::*getValue)()>
 struct KeyMapT {
-    using MapType = std::map<float, KeyT<T>>;
-
     using ValueType = T;
     using KeyType = KeyT<T>;
 
     unsigned int mInterpolationType = InterpolationType_Linear;
-    MapType mKeys;
+    std::vector<float> mTimes; // Sorted, unique
+    std::vector<T> mValues;
+    std::vector<T> mInTans; // Only for Quadratic interpolation, and never for QuaternionKeyList
+    std::vector<T> mOutTans; // Only for Quadratic interpolation, and never for QuaternionKeyList
+
+    bool empty() const { return mTimes.empty(); }
+
+    std::size_t size() const { return mTimes.size(); }
+
+    void clear()
+    {
+        mTimes.clear();
+        mValues.clear();
+        mInTans.clear();
+        mOutTans.clear();
+    }
 
     //Read in a KeyGroup (see http://niftools.sourceforge.net/doc/nif/NiKeyframeData.html)
     void read(NIFStream *nif, bool force = false, bool morph = false)
@@ -73,7 +92,7 @@ struct KeyMapT {
             return;
         }
 
-        mKeys.clear();
+        clear();
 
         mInterpolationType = nif->getUInt();
 
@@ -87,17 +106,20 @@ struct KeyMapT {
             {
                 float time = nif->getFloat();
                 readValue(nifReference, key);
-                mKeys[time] = key;
+                addKey(time, key, false);
             }
+            sortKeys();
         }
         else if (mInterpolationType == InterpolationType_Quadratic)
         {
+            constexpr bool hasTangents = !std::is_same_v<T, osg::Quat>;
             for(size_t i = 0;i < count;i++)
             {
                 float time = nif->getFloat();
                 readQuadratic(nifReference, key);
-                mKeys[time] = key;
+                addKey(time, key, hasTangents);
             }
+            sortKeys();
         }
         else if (mInterpolationType == InterpolationType_TBC)
         {
@@ -105,8 +127,9 @@ struct KeyMapT {
             {
                 float time = nif->getFloat();
                 readTBC(nifReference, key);
-                mKeys[time] = key;
+                addKey(time, key, false);
             }
+            sortKeys();
         }
         //XYZ keys aren't actually read here.
         //data.hpp sees that the last type read was InterpolationType_XYZ and:
@@ -138,6 +161,56 @@ struct KeyMapT {
     }
 
 private:
+    void addKey(float time, const KeyT<T>& key, bool tangents)
+    {
+        mTimes.push_back(time);
+        mValues.push_back(key.mValue);
+        if (tangents)
+        {
+            mInTans.push_back(key.mInTan);
+            mOutTans.push_back(key.mOutTan);
+        }
+    }
+
+    // Keys are usually stored in order, otherwise sort them and keep the last key of the same time
+    void sortKeys()
+    {
+        if (std::adjacent_find(mTimes.begin(), mTimes.end(), std::greater_equal<float>()) == mTimes.end())
+            return;
+
+        std::vector<std::size_t> order(mTimes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+            [&] (std::size_t lhs, std::size_t rhs) { return mTimes[lhs] < mTimes[rhs]; });
+
+        KeyMapT result;
+        result.mInterpolationType = mInterpolationType;
+        const bool tangents = !mInTans.empty();
+        for (std::size_t index : order)
+        {
+            KeyT<T> key;
+            key.mValue = mValues[index];
+            if (tangents)
+            {
+                key.mInTan = mInTans[index];
+                key.mOutTan = mOutTans[index];
+            }
+            if (!result.mTimes.empty() && result.mTimes.back() == mTimes[index])
+            {
+                result.mValues.back() = key.mValue;
+                if (tangents)
+                {
+                    result.mInTans.back() = key.mInTan;
+                    result.mOutTans.back() = key.mOutTan;
+                }
+                continue;
+            }
+            result.addKey(mTimes[index], key, tangents);
+        }
+
+        *this = std::move(result);
+    }
+
     static void readValue(NIFStream &nif, KeyT<T> &key)
     {
         key.mValue = (nif.*getValue)();
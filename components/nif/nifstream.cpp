@@ -2,12 +2,45 @@
 //For error reporting
 #include "niffile.hpp"
 
+#include <algorithm>
+#include <sstream>
+
 namespace Nif
 {
+    NIFStream::NIFStream(NIFFile * file, Files::IStreamPtr inp)
+        : file(file)
+    {
+        constexpr std::size_t chunkSize = 64 * 1024;
+        std::size_t size = 0;
+        while (*inp)
+        {
+            mBuffer.resize(size + chunkSize);
+            inp->read(mBuffer.data() + size, chunkSize);
+            size += static_cast<std::size_t>(inp->gcount());
+        }
+        mBuffer.resize(size);
+    }
+
+    void NIFStream::failRead(std::size_t size) const
+    {
+        std::ostringstream error;
+        error << "Failed to read " << size << " bytes at offset " << mPosition << " of " << mBuffer.size();
+        file->fail(error.str());
+    }
+
+    std::string NIFStream::getVersionString()
+    {
+        const auto begin = mBuffer.begin() + mPosition;
+        const auto end = std::find(begin, mBuffer.end(), '\n');
+        std::string result(begin, end);
+        mPosition = end == mBuffer.end() ? mBuffer.size() : mPosition + result.size() + 1;
+        return result;
+    }
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float>(inp, (float*)&f);
+        readLittleEndianBuffer(f, 4);
         osg::Quat quat;
         quat.w() = f[0];
         quat.x() = f[1];
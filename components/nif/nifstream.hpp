@@ -3,9 +3,14 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include <stdint.h>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include <components/files/constrainedfilestream.hpp>
@@ -22,102 +27,123 @@ namespace Nif
 
 class NIFFile;
 
-/* 
-    readLittleEndianBufferOfType: This template should only be used with arithmetic types
-*/
-template <uint32_t numInstances, typename T> inline void readLittleEndianBufferOfType(Files::IStreamPtr &pIStream, T* dest)
+class NIFStream
 {
-    pIStream->read((char*)dest, numInstances * sizeof(T));
-    if constexpr (Misc::IS_BIG_ENDIAN)
-        for (uint32_t i = 0; i < numInstances; i++)
-            Misc::swapEndiannessInplace(dest[i]);
-}
+    /// Whole content of the input stream, it is read at once to avoid the overhead of std::istream per value
+    std::vector<char> mBuffer;
+    std::size_t mPosition = 0;
 
-/*
-    readLittleEndianDynamicBufferOfType: This template should only be used with arithmetic types
-*/
-template <typename T> inline void readLittleEndianDynamicBufferOfType(Files::IStreamPtr &pIStream, T* dest, uint32_t numInstances)
-{
-    pIStream->read((char*)dest, numInstances * sizeof(T));
-    if constexpr (Misc::IS_BIG_ENDIAN)
-        for (uint32_t i = 0; i < numInstances; i++)
-            Misc::swapEndiannessInplace(dest[i]);
-}
-template<typename type> type inline readLittleEndianType(Files::IStreamPtr &pIStream)
-{
-    type val;
-    readLittleEndianBufferOfType<1, type>(pIStream, (type*)&val);
-    return val;
-}
+    /// Throws when less than size bytes are left
+    const char* take(std::size_t size)
+    {
+        if (size > mBuffer.size() - mPosition)
+            failRead(size);
+        const char* const result = mBuffer.data() + mPosition;
+        mPosition += size;
+        return result;
+    }
 
-class NIFStream
-{
-    /// Input stream
-    Files::IStreamPtr inp;
+    [[noreturn]] void failRead(std::size_t size) const;
+
+    /// Throws when less than numInstances values taking at least size bytes each are left, so a count read from
+    /// a corrupted file can't allocate more than the file could fill
+    void checkAvailable(std::size_t numInstances, std::size_t size) const
+    {
+        if (numInstances > (mBuffer.size() - mPosition) / size)
+            failRead(numInstances > std::numeric_limits<std::size_t>::max() / size
+                ? std::numeric_limits<std::size_t>::max() : numInstances * size);
+    }
+
+    template <typename T>
+    void getLittleEndianVector(std::vector<T>& vec, std::size_t size)
+    {
+        checkAvailable(size, sizeof(T));
+        vec.resize(size);
+        readLittleEndianBuffer(vec.data(), size);
+    }
+
+    /// Decode little endian values straight into the destination. Should only be used with arithmetic types.
+    template <typename T>
+    void readLittleEndianBuffer(T* dest, std::size_t numInstances)
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        std::memcpy(dest, take(numInstances * sizeof(T)), numInstances * sizeof(T));
+        if constexpr (Misc::IS_BIG_ENDIAN)
+            for (std::size_t i = 0; i < numInstances; i++)
+                Misc::swapEndiannessInplace(dest[i]);
+    }
+
+    template <typename T>
+    T readLittleEndianType()
+    {
+        T val;
+        readLittleEndianBuffer(&val, 1);
+        return val;
+    }
 
 public:
 
     NIFFile * const file;
 
-    NIFStream (NIFFile * file, Files::IStreamPtr inp): inp (inp), file (file) {}
+    NIFStream (NIFFile * file, Files::IStreamPtr inp);
 
-    void skip(size_t size) { inp->ignore(size); }
+    void skip(size_t size) { take(size); }
 
     char getChar()
     {
-        return readLittleEndianType<char>(inp);
+        return readLittleEndianType<char>();
     }
 
     short getShort()
     {
-        return readLittleEndianType<short>(inp);
+        return readLittleEndianType<short>();
     }
 
     unsigned short getUShort()
     {
-        return readLittleEndianType<unsigned short>(inp);
+        return readLittleEndianType<unsigned short>();
     }
 
     int getInt()
     {
-        return readLittleEndianType<int>(inp);
+        return readLittleEndianType<int>();
     }
 
     unsigned int getUInt()
     {
-        return readLittleEndianType<unsigned int>(inp);
+        return readLittleEndianType<unsigned int>();
     }
 
     float getFloat()
     {
-        return readLittleEndianType<float>(inp);
+        return readLittleEndianType<float>();
     }
 
     osg::Vec2f getVector2()
     {
         osg::Vec2f vec;
-        readLittleEndianBufferOfType<2,float>(inp, (float*)&vec._v[0]);
+        readLittleEndianBuffer(vec._v, 2);
         return vec;
     }
 
     osg::Vec3f getVector3()
     {
         osg::Vec3f vec;
-        readLittleEndianBufferOfType<3, float>(inp, (float*)&vec._v[0]);
+        readLittleEndianBuffer(vec._v, 3);
         return vec;
     }
 
     osg::Vec4f getVector4()
     {
         osg::Vec4f vec;
-        readLittleEndianBufferOfType<4, float>(inp, (float*)&vec._v[0]);
+        readLittleEndianBuffer(vec._v, 4);
         return vec;
     }
 
     Matrix3 getMatrix3()
     {
         Matrix3 mat;
-        readLittleEndianBufferOfType<9, float>(inp, (float*)&mat.mValues);
+        readLittleEndianBuffer(&mat.mValues[0][0], 9);
         return mat;
     }
 
@@ -142,93 +168,84 @@ public:
     ///Read in a string of the given length
     std::string getSizedString(size_t length)
     {
-        std::vector<char> str(length + 1, 0);
-
-        inp->read(str.data(), length);
-
-        return str.data();
+        const char* const data = take(length);
+        // The string ends at the first null character if there is one
+        return std::string(data, std::find(data, data + length, '\0'));
     }
     ///Read in a string of the length specified in the file
     std::string getSizedString()
     {
-        size_t size = readLittleEndianType<uint32_t>(inp);
+        size_t size = readLittleEndianType<uint32_t>();
         return getSizedString(size);
     }
 
     ///Specific to Bethesda headers, uses a byte for length
     std::string getExportString()
     {
-        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>(inp));
+        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>());
         return getSizedString(size);
     }
 
     ///This is special since the version string doesn't start with a number, and ends with "\n"
-    std::string getVersionString()
-    {
-        std::string result;
-        std::getline(*inp, result);
-        return result;
-    }
+    std::string getVersionString();
 
     void getChars(std::vector<char> &vec, size_t size)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<char>(inp, vec.data(), size);
+        getLittleEndianVector(vec, size);
     }
 
     void getUChars(std::vector<unsigned char> &vec, size_t size)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned char>(inp, vec.data(), size);
+        getLittleEndianVector(vec, size);
     }
 
     void getUShorts(std::vector<unsigned short> &vec, size_t size)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned short>(inp, vec.data(), size);
+        getLittleEndianVector(vec, size);
     }
 
     void getFloats(std::vector<float> &vec, size_t size)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<float>(inp, vec.data(), size);
+        getLittleEndianVector(vec, size);
     }
 
     void getInts(std::vector<int> &vec, size_t size)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<int>(inp, vec.data(), size);
+        getLittleEndianVector(vec, size);
     }
 
     void getUInts(std::vector<unsigned int> &vec, size_t size)
     {
-        vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned int>(inp, vec.data(), size);
+        getLittleEndianVector(vec, size);
     }
 
     void getVector2s(std::vector<osg::Vec2f> &vec, size_t size)
     {
+        checkAvailable(size, 2 * sizeof(float));
         vec.resize(size);
         /* The packed storage of each Vec2f is 2 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp,(float*)vec.data(), size*2);
+        readLittleEndianBuffer(reinterpret_cast<float*>(vec.data()), size*2);
     }
 
     void getVector3s(std::vector<osg::Vec3f> &vec, size_t size)
     {
+        checkAvailable(size, 3 * sizeof(float));
         vec.resize(size);
         /* The packed storage of each Vec3f is 3 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size*3);
+        readLittleEndianBuffer(reinterpret_cast<float*>(vec.data()), size*3);
     }
 
     void getVector4s(std::vector<osg::Vec4f> &vec, size_t size)
     {
+        checkAvailable(size, 4 * sizeof(float));
         vec.resize(size);
         /* The packed storage of each Vec4f is 4 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size*4);
+        readLittleEndianBuffer(reinterpret_cast<float*>(vec.data()), size*4);
     }
 
     void getQuaternions(std::vector<osg::Quat> &quat, size_t size)
     {
+        checkAvailable(size, 4 * sizeof(float));
         quat.resize(size);
         for (size_t i = 0;i < quat.size();i++)
             quat[i] = getQuaternion();
@@ -236,6 +253,8 @@ public:
 
     void getStrings(std::vector<std::string> &vec, size_t size)
     {
+        // Each string is either a sized string or an index into the string table, both start with 4 bytes
+        checkAvailable(size, sizeof(uint32_t));
         vec.resize(size);
         for (size_t i = 0; i < vec.size(); i++)
             vec[i] = getString();
@@ -243,6 +262,7 @@ public:
     /// We need to use this when the string table isn't actually initialized.
     void getSizedStrings(std::vector<std::string> &vec, size_t size)
     {
+        checkAvailable(size, sizeof(uint32_t));
         vec.resize(size);
         for (size_t i = 0; i < vec.size(); i++)
             vec[i] = getSizedString();
@@ -9,8 +9,12 @@
 #include <components/sceneutil/keyframe.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include <set>
 #include <type_traits>
+#include <vector>
 
 #include <osg/Texture2D>
 
@@ -36,23 +40,23 @@ namespace NifOsg
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+        std::size_t retrieveKey(float time) const
         {
-            // retrieve the current position in the map, optimized for the most common case
+            // retrieve the current position in the track, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            const std::vector<float>& times = mKeys->mTimes;
+            if (mLastHighKey < times.size())
             {
-                if (time > mLastHighKey->first)
+                if (time > times[mLastHighKey])
                 {
                     // try if we're there by incrementing one
-                    ++mLastLowKey;
                     ++mLastHighKey;
                 }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
+                if (mLastHighKey < times.size() && time >= times[mLastHighKey - 1] && time <= times[mLastHighKey])
                     return mLastHighKey;
             }
 
-            return mKeys->mKeys.lower_bound(time);
+            return static_cast<std::size_t>(std::lower_bound(times.begin(), times.end(), time) - times.begin());
         }
 
     public:
@@ -80,22 +84,12 @@ namespace NifOsg
             if (interpolator->data.empty())
                 return;
             mKeys = interpolator->data->mKeyList;
-            if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
             : mKeys(keys)
             , mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueT interpKey(float time) const
@@ -103,41 +97,45 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType & keys = mKeys->mKeys;
+            const std::vector<float>& times = mKeys->mTimes;
+            const std::vector<ValueT>& values = mKeys->mValues;
 
-            if(time <= keys.begin()->first)
-                return keys.begin()->second.mValue;
+            if (time <= times.front())
+                return values.front();
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+            const std::size_t high = retrieveKey(time);
 
             // now do the actual interpolation
-            if (it != keys.end())
+            if (high < times.size())
             {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                mLastHighKey = high;
+                const std::size_t low = high - 1;
 
-                float a = (time - mLastLowKey->first) / (mLastHighKey->first - mLastLowKey->first);
+                float a = (time - times[low]) / (times[high] - times[low]);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
+                if constexpr (std::is_same_v<ValueT, osg::Quat>)
+                    return interpolateQuat(low, high, a, mKeys->mInterpolationType);
+                else
+                    return interpolate(low, high, a, mKeys->mInterpolationType);
             }
 
-            return keys.rbegin()->second.mValue;
+            return values.back();
         }
 
         bool empty() const
         {
-            return !mKeys || mKeys->mKeys.empty();
+            return !mKeys || mKeys->empty();
         }
 
     private:
-        template <typename ValueType>
-        ValueType interpolate(const Nif::KeyT<ValueType>& a, const Nif::KeyT<ValueType>& b, float fraction, unsigned int type) const
+        ValueT interpolate(std::size_t low, std::size_t high, float fraction, unsigned int type) const
         {
+            const std::vector<ValueT>& values = mKeys->mValues;
             switch (type)
             {
                 case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
+                    return fraction > 0.5f ? values[high] : values[low];
                 case Nif::InterpolationType_Quadratic:
                 {
                     // Using a cubic Hermite spline.
@@ -153,31 +151,33 @@ namespace NifOsg
                     const float b2 = -2.f * t3 + 3.f * t2;
                     const float b3 = t3 - 2.f * t2 + t;
                     const float b4 = t3 - t2;
-                    return a.mValue * b1 + b.mValue * b2 + a.mOutTan * b3 + b.mInTan * b4;
+                    return values[low] * b1 + values[high] * b2 + mKeys->mOutTans[low] * b3 + mKeys->mInTans[high] * b4;
                 }
                 // TODO: Implement TBC interpolation
                 default:
-                    return a.mValue + ((b.mValue - a.mValue) * fraction);
+                    return values[low] + ((values[high] - values[low]) * fraction);
             }
         }
-        osg::Quat interpolate(const Nif::KeyT<osg::Quat>& a, const Nif::KeyT<osg::Quat>& b, float fraction, unsigned int type) const
+
+        osg::Quat interpolateQuat(std::size_t low, std::size_t high, float fraction, unsigned int type) const
         {
+            const std::vector<osg::Quat>& values = mKeys->mValues;
             switch (type)
             {
                 case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
+                    return fraction > 0.5f ? values[high] : values[low];
                 // TODO: Implement Quadratic and TBC interpolation
                 default:
                 {
                     osg::Quat result;
-                    result.slerp(fraction, a.mValue, b.mValue);
+                    result.slerp(fraction, values[low], values[high]);
                     return result;
                 }
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        // Index of the higher key used by the last interpolation, the lower one is right before it
+        mutable std::size_t mLastHighKey = std::numeric_limits<std::size_t>::max();
 
         std::shared_ptr<const MapT> mKeys;
 
@@ -3,6 +3,7 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - entries are split between shards with own mutex and hashed lookup, so concurrent users rarely wait for each other.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -23,10 +24,17 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 #include <osg/Node>
+#include <osg/Vec2f>
 
-#include <string>
-#include <map>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace osg
 {
@@ -37,6 +45,48 @@ namespace osg
 
 namespace Resource {
 
+/// Hash for object cache keys: strings, numbers, osg::Vec2f and pairs or tuples of them.
+struct ObjectCacheKeyHash
+{
+    template <class T>
+    std::size_t operator()(const T& value) const
+    {
+        return std::hash<T>()(value);
+    }
+
+    std::size_t operator()(const osg::Vec2f& value) const
+    {
+        std::size_t seed = 0;
+        combine(seed, value.x());
+        combine(seed, value.y());
+        return seed;
+    }
+
+    template <class First, class Second>
+    std::size_t operator()(const std::pair<First, Second>& value) const
+    {
+        std::size_t seed = 0;
+        combine(seed, value.first);
+        combine(seed, value.second);
+        return seed;
+    }
+
+    template <class ... Args>
+    std::size_t operator()(const std::tuple<Args ...>& value) const
+    {
+        std::size_t seed = 0;
+        std::apply([&] (const auto& ... v) { (combine(seed, v), ...); }, value);
+        return seed;
+    }
+
+    /* similar to the boost::hash_combine */
+    template <class T>
+    void combine(std::size_t& seed, const T& value) const
+    {
+        seed ^= (*this)(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+};
+
 template <typename KeyType>
 class GenericObjectCache : public osg::Referenced
 {
@@ -53,14 +103,17 @@ class GenericObjectCache : public osg::Referenced
           * The time used should be taken from the FrameStamp::getReferenceTime().*/
         void updateTimeStampOfObjectsInCacheWithExternalReferences(double referenceTime)
         {
-            // look for objects with external references and update their time stamp.
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr=_objectCache.begin(); itr!=_objectCache.end(); ++itr)
+            // look for objects with external references and update their time stamp, one shard at a time.
+            for (Shard& shard : _shards)
             {
-                // If ref count is greater than 1, the object has an external reference.
-                // If the timestamp is yet to be initialized, it needs to be updated too.
-                if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                std::lock_guard<std::mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
+                {
+                    // If ref count is greater than 1, the object has an external reference.
+                    // If the timestamp is yet to be initialized, it needs to be updated too.
+                    if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
+                        itr->second.second = referenceTime;
+                }
             }
         }
 
@@ -71,53 +124,64 @@ class GenericObjectCache : public osg::Referenced
         void removeExpiredObjectsInCache(double expiryTime)
         {
             std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            for (Shard& shard : _shards)
             {
-                std::lock_guard<std::mutex> lock(_objectCacheMutex);
-                // Remove expired entries from object cache
-                typename ObjectCacheMap::iterator oitr = _objectCache.begin();
-                while(oitr != _objectCache.end())
                 {
-                    if (oitr->second.second<=expiryTime)
+                    std::lock_guard<std::mutex> lock(shard._mutex);
+                    // Remove expired entries from object cache
+                    typename ObjectCacheMap::iterator oitr = shard._objectCache.begin();
+                    while(oitr != shard._objectCache.end())
                     {
-                        objectsToRemove.push_back(oitr->second.first);
-                        _objectCache.erase(oitr++);
+                        if (oitr->second.second<=expiryTime)
+                        {
+                            objectsToRemove.push_back(std::move(oitr->second.first));
+                            oitr = shard._objectCache.erase(oitr);
+                        }
+                        else
+                            ++oitr;
                     }
-                    else
-                        ++oitr;
                 }
+                // note, actual unref happens outside of the lock
+                objectsToRemove.clear();
             }
-            // note, actual unref happens outside of the lock
-            objectsToRemove.clear();
         }
 
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache.clear();
+            for (Shard& shard : _shards)
+            {
+                ObjectCacheMap objectCache;
+                {
+                    std::lock_guard<std::mutex> lock(shard._mutex);
+                    std::swap(objectCache, shard._objectCache);
+                }
+            }
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache[key]=ObjectTimeStampPair(object,timestamp);
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard._mutex);
+            shard._objectCache[key]=ObjectTimeStampPair(object,timestamp);
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end()) _objectCache.erase(itr);
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard._mutex);
+            shard._objectCache.erase(key);
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end())
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard._mutex);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
                 return itr->second.first;
             else return nullptr;
         }
@@ -125,9 +189,10 @@ class GenericObjectCache : public osg::Referenced
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const KeyType& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end())
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard._mutex);
+            typename ObjectCacheMap::iterator itr = shard._objectCache.find(key);
+            if (itr!=shard._objectCache.end())
             {
                 itr->second.second = timeStamp;
                 return true;
@@ -138,26 +203,32 @@ class GenericObjectCache : public osg::Referenced
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                osg::Object* object = itr->second.first.get();
-                object->releaseGLObjects(state);
+                std::lock_guard<std::mutex> lock(shard._mutex);
+                for(typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
+                {
+                    osg::Object* object = itr->second.first.get();
+                    object->releaseGLObjects(state);
+                }
             }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : _shards)
             {
-                osg::Object* object = itr->second.first.get();
-                if (object)
+                std::lock_guard<std::mutex> lock(shard._mutex);
+                for(typename ObjectCacheMap::iterator itr = shard._objectCache.begin(); itr != shard._objectCache.end(); ++itr)
                 {
-                    osg::Node* node = dynamic_cast<osg::Node*>(object);
-                    if (node)
-                        node->accept(nv);
+                    osg::Object* object = itr->second.first.get();
+                    if (object)
+                    {
+                        osg::Node* node = dynamic_cast<osg::Node*>(object);
+                        if (node)
+                            node->accept(nv);
+                    }
                 }
             }
         }
@@ -166,16 +237,24 @@ class GenericObjectCache : public osg::Referenced
         template <class Functor>
         void call(Functor& f)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->first, it->second.first.get());
+            for (Shard& shard : _shards)
+            {
+                std::lock_guard<std::mutex> lock(shard._mutex);
+                for (typename ObjectCacheMap::iterator it = shard._objectCache.begin(); it != shard._objectCache.end(); ++it)
+                    f(it->first, it->second.first.get());
+            }
         }
 
         /** Get the number of objects in the cache. */
         unsigned int getCacheSize() const
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            return _objectCache.size();
+            std::size_t result = 0;
+            for (const Shard& shard : _shards)
+            {
+                std::lock_guard<std::mutex> lock(shard._mutex);
+                result += shard._objectCache.size();
+            }
+            return static_cast<unsigned int>(result);
         }
 
     protected:
@@ -183,10 +262,24 @@ class GenericObjectCache : public osg::Referenced
         virtual ~GenericObjectCache() {}
 
         typedef std::pair<osg::ref_ptr<osg::Object>, double >           ObjectTimeStampPair;
-        typedef std::map<KeyType, ObjectTimeStampPair >             ObjectCacheMap;
+        typedef std::unordered_map<KeyType, ObjectTimeStampPair, ObjectCacheKeyHash> ObjectCacheMap;
+
+        struct Shard
+        {
+            ObjectCacheMap                      _objectCache;
+            mutable std::mutex                  _mutex;
+        };
+
+        static constexpr std::size_t sShardsCount = 16;
 
-        ObjectCacheMap                          _objectCache;
-        mutable std::mutex                      _objectCacheMutex;
+        std::array<Shard, sShardsCount>         _shards;
+
+        Shard& getShard(const KeyType& key)
+        {
+            // Hashes of small integer keys are the same values, so mix them to spread keys over all shards
+            const std::uint64_t hash = static_cast<std::uint64_t>(ObjectCacheKeyHash()(key)) * 0x9E3779B97F4A7C15ull;
+            return _shards[static_cast<std::size_t>(hash >> 60) % sShardsCount];
+        }
 
 };
 
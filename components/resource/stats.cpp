@@ -283,6 +283,13 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Compiling",
             "WorkQueue",
             "WorkThread",
+            "WorkQueue Steals",
+            "WorkQueue High",
+            "WorkQueue Normal",
+            "WorkQueue Low",
+            "WorkLatency High",
+            "WorkLatency Normal",
+            "WorkLatency Low",
             "",
             "Texture",
             "StateSet",
@@ -313,6 +320,10 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Physics Actors",
             "Physics Objects",
             "Physics HeightFields",
+            "",
+            "Script Calls",
+            "Script Instructions",
+            "Script Deferred",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
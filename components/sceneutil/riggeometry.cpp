@@ -3,33 +3,64 @@
 #include <osg/Version>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 
 #include "skeleton.hpp"
 #include "util.hpp"
+#include "workqueue.hpp"
 
 namespace
 {
-    inline void accumulateMatrix(const osg::Matrixf& invBindMatrix, const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
+    osg::ref_ptr<SceneUtil::WorkQueue> sWorkQueue;
+
+    class SkinningWorkItem : public SceneUtil::WorkItem
     {
-        osg::Matrixf m = invBindMatrix * matrix;
-        float* ptr = m.ptr();
-        float* ptrresult = result.ptr();
-        ptrresult[0] += ptr[0] * weight;
-        ptrresult[1] += ptr[1] * weight;
-        ptrresult[2] += ptr[2] * weight;
-
-        ptrresult[4] += ptr[4] * weight;
-        ptrresult[5] += ptr[5] * weight;
-        ptrresult[6] += ptr[6] * weight;
-
-        ptrresult[8] += ptr[8] * weight;
-        ptrresult[9] += ptr[9] * weight;
-        ptrresult[10] += ptr[10] * weight;
-
-        ptrresult[12] += ptr[12] * weight;
-        ptrresult[13] += ptr[13] * weight;
-        ptrresult[14] += ptr[14] * weight;
-    }
+    public:
+        SkinningWorkItem(osg::ref_ptr<const SceneUtil::SkinningData> data, std::vector<osg::Matrixf>&& boneMatrices,
+                         const osg::Matrixf* geomToSkelMatrix, const SceneUtil::SkinningSource& source,
+                         const SceneUtil::SkinningTarget& target)
+            : mData(std::move(data))
+            , mBoneMatrices(std::move(boneMatrices))
+            , mHasGeomToSkelMatrix(geomToSkelMatrix != nullptr)
+            , mGeomToSkelMatrix(geomToSkelMatrix ? *geomToSkelMatrix : osg::Matrixf())
+            , mSource(source)
+            , mTarget(target)
+        {}
+
+        void doWork() override
+        {
+            SceneUtil::skin(*mData, mBoneMatrices, mHasGeomToSkelMatrix ? &mGeomToSkelMatrix : nullptr, mSource, mTarget);
+        }
+
+    private:
+        osg::ref_ptr<const SceneUtil::SkinningData> mData;
+        // Copied because the update traversal of the next frame may change bones before the item is done
+        std::vector<osg::Matrixf> mBoneMatrices;
+        bool mHasGeomToSkelMatrix;
+        osg::Matrixf mGeomToSkelMatrix;
+        SceneUtil::SkinningSource mSource;
+        SceneUtil::SkinningTarget mTarget;
+    };
+
+    struct WaitForSkinningCallback : osg::Drawable::DrawCallback
+    {
+        osg::ref_ptr<SceneUtil::WorkItem> mSkinning;
+
+        void wait() const
+        {
+            if (mSkinning && !mSkinning->isDone())
+            {
+                const Debug::ScopedTrace trace("Wait for skinning", "Skinning");
+                mSkinning->waitTillDone();
+            }
+        }
+
+        void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const override
+        {
+            wait();
+            drawable->drawImplementation(renderInfo);
+        }
+    };
 }
 
 namespace SceneUtil
@@ -48,7 +79,7 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     : Drawable(copy, copyop)
     , mSkeleton(nullptr)
     , mInfluenceMap(copy.mInfluenceMap)
-    , mBone2VertexVector(copy.mBone2VertexVector)
+    , mSkinningData(copy.mSkinningData)
     , mBoneSphereVector(copy.mBoneSphereVector)
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
@@ -71,6 +102,7 @@ void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
         to.setCullingActive(false); // make sure to disable culling since that's handled by this class
         to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
         to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
+        to.setDrawCallback(new WaitForSkinningCallback);
 
         // vertices and normals are modified every frame, so we need to deep copy them.
         // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
@@ -111,6 +143,11 @@ osg::ref_ptr<osg::Geometry> RigGeometry::getSourceGeometry() const
     return mSourceGeometry;
 }
 
+void RigGeometry::setWorkQueue(osg::ref_ptr<WorkQueue> workQueue)
+{
+    sWorkQueue = std::move(workQueue);
+}
+
 bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
 {
     const osg::NodePath& path = nv->getNodePath();
@@ -137,37 +174,17 @@ bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
     }
 
     mBoneNodesVector.clear();
+    mBoneNodesVector.reserve(mBoneSphereVector->mData.size());
     for (auto& bonePair : mBoneSphereVector->mData)
     {
         const std::string& boneName = bonePair.first;
         Bone* bone = mSkeleton->getBone(boneName);
         if (!bone)
-        {
-            mBoneNodesVector.push_back(nullptr);
             Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-            continue;
-        }
 
         mBoneNodesVector.push_back(bone);
     }
 
-    for (auto& pair : mBone2VertexVector->mData)
-    {
-        for (auto &weight : pair.first)
-        {
-            const std::string& boneName = weight.first.first;
-            Bone* bone = mSkeleton->getBone(boneName);
-            if (!bone)
-            {
-                mBoneNodesVector.push_back(nullptr);
-                Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-                continue;
-            }
-
-            mBoneNodesVector.push_back(bone);
-        }
-    }
-
     return true;
 }
 
@@ -196,55 +213,44 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     mSkeleton->updateBoneMatrices(traversalNumber);
 
     // skinning
-    const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-    const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-    const osg::Vec4Array* tangentSrc = mSourceTangents;
-
-    osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-    osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-    osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
-
-    int index = mBoneSphereVector->mData.size();
-    for (auto &pair : mBone2VertexVector->mData)
+    SkinningSource source;
+    source.mPositions = static_cast<const osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+    source.mNormals = static_cast<const osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+    source.mTangents = mSourceTangents;
+
+    SkinningTarget target;
+    target.mPositions = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+    target.mNormals = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+    target.mTangents = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+
+    // Zero matrix of a missing bone doesn't contribute to the vertices
+    std::vector<osg::Matrixf> boneMatrices(mBoneNodesVector.size(), osg::Matrixf(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+    for (std::size_t i = 0; i < mBoneNodesVector.size(); ++i)
+        if (mBoneNodesVector[i] != nullptr)
+            boneMatrices[i] = mBoneNodesVector[i]->mMatrixInSkeletonSpace;
+
+    WaitForSkinningCallback& skinning = static_cast<WaitForSkinningCallback&>(*geom.getDrawCallback());
+    // Arrays may still be in use by the item started two frames ago if the geometry wasn't drawn since then
+    skinning.wait();
+
+    if (sWorkQueue)
     {
-        osg::Matrixf resultMat (0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 1);
-
-        for (auto &weight : pair.first)
-        {
-            Bone* bone = mBoneNodesVector[index];
-            if (bone == nullptr)
-                continue;
-
-            accumulateMatrix(weight.first.second, bone->mMatrixInSkeletonSpace, weight.second, resultMat);
-            index++;
-        }
-
-        if (mGeomToSkelMatrix)
-            resultMat *= (*mGeomToSkelMatrix);
-
-        for (auto &vertex : pair.second)
-        {
-            (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-            if (normalDst)
-                (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
-
-            if (tangentDst)
-            {
-                const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-            }
-        }
+        skinning.mSkinning = new SkinningWorkItem(mSkinningData, std::move(boneMatrices), mGeomToSkelMatrix.get(),
+                                                  source, target);
+        sWorkQueue->addWorkItem(skinning.mSkinning, WorkPriority::High);
+    }
+    else
+    {
+        skinning.mSkinning = nullptr;
+        skin(*mSkinningData, boneMatrices, mGeomToSkelMatrix.get(), source, target);
     }
 
-    positionDst->dirty();
-    if (normalDst)
-        normalDst->dirty();
-    if (tangentDst)
-        tangentDst->dirty();
+    // Buffer objects are uploaded when the geometry is drawn, i.e. after the skinning is done
+    target.mPositions->dirty();
+    if (target.mNormals)
+        target.mNormals->dirty();
+    if (target.mTangents)
+        target.mTangents->dirty();
 
 #if OSG_MIN_VERSION_REQUIRED(3, 5, 6)
     geom.dirtyGLObjects();
@@ -273,15 +279,13 @@ void RigGeometry::updateBounds(osg::NodeVisitor *nv)
 
     osg::BoundingBox box;
 
-    int index = 0;
-    for (auto& boundPair : mBoneSphereVector->mData)
+    for (std::size_t i = 0; i < mBoneSphereVector->mData.size(); ++i)
     {
-        Bone* bone = mBoneNodesVector[index];
+        Bone* bone = mBoneNodesVector[i];
         if (bone == nullptr)
             continue;
 
-        index++;
-        osg::BoundingSpheref bs = boundPair.second;
+        osg::BoundingSpheref bs = mBoneSphereVector->mData[i].second;
         if (mGeomToSkelMatrix)
             transformBoundingSphere(bone->mMatrixInSkeletonSpace * (*mGeomToSkelMatrix), bs);
         else
@@ -337,33 +341,12 @@ void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
 {
     mInfluenceMap = influenceMap;
 
-    typedef std::map<unsigned short, std::vector<BoneWeight> > Vertex2BoneMap;
-    Vertex2BoneMap vertex2BoneMap;
     mBoneSphereVector = new BoneSphereVector;
     mBoneSphereVector->mData.reserve(mInfluenceMap->mData.size());
-    mBone2VertexVector = new Bone2VertexVector;
     for (auto& influencePair : mInfluenceMap->mData)
-    {
-        const std::string& boneName = influencePair.first;
-        const BoneInfluence& bi = influencePair.second;
-        mBoneSphereVector->mData.emplace_back(boneName, bi.mBoundSphere);
-
-        for (auto& weightPair: bi.mWeights)
-        {
-            std::vector<BoneWeight>& vec = vertex2BoneMap[weightPair.first];
-
-            vec.emplace_back(std::make_pair(boneName, bi.mInvBindMatrix), weightPair.second);
-        }
-    }
-
-    Bone2VertexMap bone2VertexMap;
-    for (auto& vertexPair : vertex2BoneMap)
-    {
-        bone2VertexMap[vertexPair.second].emplace_back(vertexPair.first);
-    }
+        mBoneSphereVector->mData.emplace_back(influencePair.first, influencePair.second.mBoundSphere);
 
-    mBone2VertexVector->mData.reserve(bone2VertexMap.size());
-    mBone2VertexVector->mData.assign(bone2VertexMap.begin(), bone2VertexMap.end());
+    mSkinningData = makeSkinningData(mInfluenceMap->mData);
 }
 
 void RigGeometry::accept(osg::NodeVisitor &nv)
@@ -385,9 +368,15 @@ void RigGeometry::accept(osg::NodeVisitor &nv)
 
 void RigGeometry::accept(osg::PrimitiveFunctor& func) const
 {
+    waitForSkinning(mLastFrameNumber);
     getGeometry(mLastFrameNumber)->accept(func);
 }
 
+void RigGeometry::waitForSkinning(unsigned int frame) const
+{
+    static_cast<const WaitForSkinningCallback&>(*getGeometry(frame)->getDrawCallback()).wait();
+}
+
 osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
 {
     return mGeometry[frame%2].get();
@@ -4,16 +4,21 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include "skinning.hpp"
+
 namespace SceneUtil
 {
     class Skeleton;
     class Bone;
+    class WorkQueue;
 
     /// @brief Mesh skinning implementation.
     /// @note A RigGeometry may be attached directly to a Skeleton, or somewhere below a Skeleton.
     /// Note though that the RigGeometry ignores any transforms below the Skeleton, so the attachment point is not that important.
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread safe way while
     /// not compromising rendering performance. This is crucial when using osg's default threading model of DrawThreadPerContext.
+    /// @note With a work queue set, skinning of all visible RigGeometries is done by the queue threads while the cull
+    /// traversal goes on. Drawing of the internal Geometry waits until its skinning is done.
     class RigGeometry : public osg::Drawable
     {
     public:
@@ -25,13 +30,7 @@ namespace SceneUtil
         // Currently empty as this is difficult to implement. Technically we would need to compile both internal geometries in separate frames but this method is only called once. Alternatively we could compile just the static parts of the model.
         void compileGLObjects(osg::RenderInfo& renderInfo) const override {}
 
-        struct BoneInfluence
-        {
-            osg::Matrixf mInvBindMatrix;
-            osg::BoundingSpheref mBoundSphere;
-            // <vertex index, weight>
-            std::vector<std::pair<unsigned short, float>> mWeights;
-        };
+        using BoneInfluence = SceneUtil::BoneInfluence;
 
         struct InfluenceMap : public osg::Referenced
         {
@@ -46,6 +45,10 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// Set the queue to skin all RigGeometries on, skinning is done in the cull traversal if nullptr (default).
+        /// @note The queue has to have at least one thread.
+        static void setWorkQueue(osg::ref_ptr<WorkQueue> workQueue);
+
         void accept(osg::NodeVisitor &nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override{ return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -79,25 +82,14 @@ namespace SceneUtil
 
         osg::ref_ptr<InfluenceMap> mInfluenceMap;
 
-        typedef std::pair<std::string, osg::Matrixf> BoneBindMatrixPair;
-
-        typedef std::pair<BoneBindMatrixPair, float> BoneWeight;
-
-        typedef std::vector<unsigned short> VertexList;
-
-        typedef std::map<std::vector<BoneWeight>, VertexList> Bone2VertexMap;
-
-        struct Bone2VertexVector : public osg::Referenced
-        {
-            std::vector<std::pair<std::vector<BoneWeight>, VertexList>> mData;
-        };
-        osg::ref_ptr<Bone2VertexVector> mBone2VertexVector;
+        osg::ref_ptr<SkinningData> mSkinningData;
 
         struct BoneSphereVector : public osg::Referenced
         {
             std::vector<std::pair<std::string, osg::BoundingSpheref>> mData;
         };
         osg::ref_ptr<BoneSphereVector> mBoneSphereVector;
+        // Bone per influence, nullptr if the skeleton doesn't have it
         std::vector<Bone*> mBoneNodesVector;
 
         unsigned int mLastFrameNumber;
@@ -106,6 +98,8 @@ namespace SceneUtil
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
 
         void updateGeomToSkelMatrix(const osg::NodePath& nodePath);
+
+        void waitForSkinning(unsigned int frame) const;
     };
 
 }
@@ -4,7 +4,6 @@
 #include <osg/MatrixTransform>
 
 #include <components/debug/debuglog.hpp>
-#include <components/misc/stringops.hpp>
 
 namespace SceneUtil
 {
@@ -12,7 +11,7 @@ namespace SceneUtil
 class InitBoneCacheVisitor : public osg::NodeVisitor
 {
 public:
-    InitBoneCacheVisitor(std::map<std::string, std::pair<osg::NodePath, osg::MatrixTransform*> >& cache)
+    InitBoneCacheVisitor(std::unordered_map<Misc::InternedString, std::pair<osg::NodePath, osg::MatrixTransform*> >& cache)
         : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
         , mCache(cache)
     {
@@ -24,12 +23,12 @@ public:
         if (!bone)
             return;
 
-        mCache[Misc::StringUtils::lowerCase(bone->getName())] = std::make_pair(getNodePath(), bone);
+        mCache[Misc::InternedString(bone->getName())] = std::make_pair(getNodePath(), bone);
 
         traverse(node);
     }
 private:
-    std::map<std::string, std::pair<osg::NodePath, osg::MatrixTransform*> >& mCache;
+    std::unordered_map<Misc::InternedString, std::pair<osg::NodePath, osg::MatrixTransform*> >& mCache;
 };
 
 Skeleton::Skeleton()
@@ -62,7 +61,8 @@ Bone* Skeleton::getBone(const std::string &name)
         mBoneCacheInit = true;
     }
 
-    BoneCache::iterator found = mBoneCache.find(Misc::StringUtils::lowerCase(name));
+    // Names of all bones are interned, so a name that isn't can't be found
+    BoneCache::iterator found = mBoneCache.find(Misc::InternedString::find(name));
     if (found == mBoneCache.end())
         return nullptr;
 
@@ -3,7 +3,10 @@
 
 #include <osg/Group>
 
+#include <components/misc/internedstring.hpp>
+
 #include <memory>
+#include <unordered_map>
 
 namespace SceneUtil
 {
@@ -72,7 +75,7 @@ namespace SceneUtil
         // As far as the scene graph goes we support multiple root bones.
         std::unique_ptr<Bone> mRootBone;
 
-        typedef std::map<std::string, std::pair<osg::NodePath, osg::MatrixTransform*> > BoneCache;
+        typedef std::unordered_map<Misc::InternedString, std::pair<osg::NodePath, osg::MatrixTransform*> > BoneCache;
         BoneCache mBoneCache;
         bool mBoneCacheInit;
 
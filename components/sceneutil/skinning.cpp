@@ -0,0 +1,121 @@
+#include "skinning.hpp"
+
+#include <map>
+
+namespace
+{
+    inline void accumulateMatrix(const osg::Matrixf& invBindMatrix, const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
+    {
+        osg::Matrixf m = invBindMatrix * matrix;
+        float* ptr = m.ptr();
+        float* ptrresult = result.ptr();
+        ptrresult[0] += ptr[0] * weight;
+        ptrresult[1] += ptr[1] * weight;
+        ptrresult[2] += ptr[2] * weight;
+
+        ptrresult[4] += ptr[4] * weight;
+        ptrresult[5] += ptr[5] * weight;
+        ptrresult[6] += ptr[6] * weight;
+
+        ptrresult[8] += ptr[8] * weight;
+        ptrresult[9] += ptr[9] * weight;
+        ptrresult[10] += ptr[10] * weight;
+
+        ptrresult[12] += ptr[12] * weight;
+        ptrresult[13] += ptr[13] * weight;
+        ptrresult[14] += ptr[14] * weight;
+    }
+}
+
+namespace SceneUtil
+{
+    osg::ref_ptr<SkinningData> makeSkinningData(const std::vector<std::pair<std::string, BoneInfluence>>& influences)
+    {
+        // <bone index, weight>
+        using VertexWeights = std::vector<std::pair<std::size_t, float>>;
+
+        std::map<unsigned short, VertexWeights> vertex2Bones;
+        for (std::size_t bone = 0; bone < influences.size(); ++bone)
+            for (const auto& [vertex, weight] : influences[bone].second.mWeights)
+                vertex2Bones[vertex].emplace_back(bone, weight);
+
+        std::map<VertexWeights, std::vector<unsigned short>> bones2Vertices;
+        for (const auto& [vertex, weights] : vertex2Bones)
+            bones2Vertices[weights].push_back(vertex);
+
+        osg::ref_ptr<SkinningData> result(new SkinningData);
+        result->mGroups.reserve(bones2Vertices.size());
+        result->mVertices.reserve(vertex2Bones.size());
+
+        for (const auto& [weights, vertices] : bones2Vertices)
+        {
+            SkinningData::Group group;
+            group.mWeightsBegin = result->mWeights.size();
+            for (const auto& [bone, weight] : weights)
+                result->mWeights.push_back(SkinningData::Weight {bone, influences[bone].second.mInvBindMatrix, weight});
+            group.mWeightsEnd = result->mWeights.size();
+            group.mVerticesBegin = result->mVertices.size();
+            result->mVertices.insert(result->mVertices.end(), vertices.begin(), vertices.end());
+            group.mVerticesEnd = result->mVertices.size();
+            result->mGroups.push_back(group);
+        }
+
+        return result;
+    }
+
+    void skin(const SkinningData& data, const std::vector<osg::Matrixf>& boneMatrices,
+              const osg::Matrixf* geomToSkelMatrix, const SkinningSource& source, const SkinningTarget& target)
+    {
+        const osg::Vec3f* positionSrc = static_cast<const osg::Vec3f*>(source.mPositions->getDataPointer());
+        osg::Vec3f* positionDst = static_cast<osg::Vec3f*>(target.mPositions->getDataPointer());
+        const osg::Vec3f* normalSrc = target.mNormals ? static_cast<const osg::Vec3f*>(source.mNormals->getDataPointer()) : nullptr;
+        osg::Vec3f* normalDst = target.mNormals ? static_cast<osg::Vec3f*>(target.mNormals->getDataPointer()) : nullptr;
+        const osg::Vec4f* tangentSrc = target.mTangents ? static_cast<const osg::Vec4f*>(source.mTangents->getDataPointer()) : nullptr;
+        osg::Vec4f* tangentDst = target.mTangents ? static_cast<osg::Vec4f*>(target.mTangents->getDataPointer()) : nullptr;
+        const unsigned short* vertices = data.mVertices.data();
+
+        for (const SkinningData::Group& group : data.mGroups)
+        {
+            osg::Matrixf resultMat (0, 0, 0, 0,
+                                    0, 0, 0, 0,
+                                    0, 0, 0, 0,
+                                    0, 0, 0, 1);
+
+            for (std::size_t i = group.mWeightsBegin; i < group.mWeightsEnd; ++i)
+            {
+                const SkinningData::Weight& weight = data.mWeights[i];
+                accumulateMatrix(weight.mInvBindMatrix, boneMatrices[weight.mBone], weight.mWeight, resultMat);
+            }
+
+            if (geomToSkelMatrix)
+                resultMat *= *geomToSkelMatrix;
+
+            // Separate passes keep each loop free of branches
+            for (std::size_t i = group.mVerticesBegin; i < group.mVerticesEnd; ++i)
+            {
+                const unsigned short vertex = vertices[i];
+                positionDst[vertex] = resultMat.preMult(positionSrc[vertex]);
+            }
+
+            if (normalDst)
+            {
+                for (std::size_t i = group.mVerticesBegin; i < group.mVerticesEnd; ++i)
+                {
+                    const unsigned short vertex = vertices[i];
+                    normalDst[vertex] = osg::Matrixf::transform3x3(normalSrc[vertex], resultMat);
+                }
+            }
+
+            if (tangentDst)
+            {
+                for (std::size_t i = group.mVerticesBegin; i < group.mVerticesEnd; ++i)
+                {
+                    const unsigned short vertex = vertices[i];
+                    const osg::Vec4f& srcTangent = tangentSrc[vertex];
+                    const osg::Vec3f transformed = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
+                    tangentDst[vertex] = osg::Vec4f(transformed, srcTangent.w());
+                }
+            }
+        }
+    }
+}
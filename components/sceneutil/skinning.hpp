@@ -0,0 +1,74 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <osg/Array>
+#include <osg/BoundingSphere>
+#include <osg/Matrixf>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    struct BoneInfluence
+    {
+        osg::Matrixf mInvBindMatrix;
+        osg::BoundingSpheref mBoundSphere;
+        // <vertex index, weight>
+        std::vector<std::pair<unsigned short, float>> mWeights;
+    };
+
+    /// Bone weights of a mesh with vertices grouped by equal weights. Each group is skinned with a single matrix.
+    /// All groups are stored in contiguous arrays, so skinning goes over memory sequentially.
+    struct SkinningData : public osg::Referenced
+    {
+        struct Weight
+        {
+            // Index of the bone in the influences used to make the data
+            std::size_t mBone;
+            osg::Matrixf mInvBindMatrix;
+            float mWeight;
+        };
+
+        struct Group
+        {
+            std::size_t mWeightsBegin;
+            std::size_t mWeightsEnd;
+            std::size_t mVerticesBegin;
+            std::size_t mVerticesEnd;
+        };
+
+        std::vector<Weight> mWeights;
+        std::vector<Group> mGroups;
+        std::vector<unsigned short> mVertices;
+    };
+
+    osg::ref_ptr<SkinningData> makeSkinningData(const std::vector<std::pair<std::string, BoneInfluence>>& influences);
+
+    template <class Vec3Array, class Vec4Array>
+    struct SkinningArrays
+    {
+        osg::ref_ptr<Vec3Array> mPositions;
+        // Optional
+        osg::ref_ptr<Vec3Array> mNormals;
+        // Optional, w component is copied
+        osg::ref_ptr<Vec4Array> mTangents;
+    };
+
+    using SkinningSource = SkinningArrays<const osg::Vec3Array, const osg::Vec4Array>;
+    using SkinningTarget = SkinningArrays<osg::Vec3Array, osg::Vec4Array>;
+
+    /// Transform vertices of the source arrays into the target arrays.
+    /// @param boneMatrices Skeleton space matrix per bone in order of influences used to make the data. Use zero
+    /// matrix for missing bones to ignore their weights.
+    /// @param geomToSkelMatrix Optional transform applied after bone matrices.
+    /// @note Doesn't dirty the target arrays.
+    void skin(const SkinningData& data, const std::vector<osg::Matrixf>& boneMatrices,
+              const osg::Matrixf* geomToSkelMatrix, const SkinningSource& source, const SkinningTarget& target);
+}
+
+#endif
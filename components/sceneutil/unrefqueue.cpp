@@ -21,12 +21,12 @@ namespace SceneUtil
         mWorkItem->mObjects.emplace_back(obj);
     }
 
-    void UnrefQueue::flush(SceneUtil::WorkQueue *workQueue)
+    void UnrefQueue::flush(SceneUtil::WorkQueue *workQueue, WorkPriority priority)
     {
         if (mWorkItem->mObjects.empty())
             return;
 
-        workQueue->addWorkItem(mWorkItem, true);
+        workQueue->addWorkItem(mWorkItem, priority);
 
         mWorkItem = new UnrefWorkItem;
     }
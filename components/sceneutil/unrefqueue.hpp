@@ -31,7 +31,7 @@ namespace SceneUtil
 
         /// Adds a WorkItem to the given WorkQueue that will clear the list of objects in a worker thread, thus unreferencing them.
         /// Call from the main thread.
-        void flush(SceneUtil::WorkQueue* workQueue);
+        void flush(SceneUtil::WorkQueue* workQueue, WorkPriority priority = WorkPriority::High);
 
         unsigned int getNumItems() const;
 
@@ -60,8 +60,7 @@ namespace SceneUtil
     void NodeMapVisitor::apply(osg::MatrixTransform& trans)
     {
         // Take transformation for first found node in file
-        const std::string nodeName = Misc::StringUtils::lowerCase(trans.getName());
-        mMap.emplace(nodeName, &trans);
+        mMap.emplace(Misc::InternedString(trans.getName()), &trans);
 
         traverse(trans);
     }
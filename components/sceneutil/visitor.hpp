@@ -4,6 +4,10 @@
 #include <osg/MatrixTransform>
 #include <osg/NodeVisitor>
 
+#include <components/misc/internedstring.hpp>
+
+#include <unordered_map>
+
 // Commonly used scene graph visitors
 namespace SceneUtil
 {
@@ -63,7 +67,7 @@ namespace SceneUtil
     class NodeMapVisitor : public osg::NodeVisitor
     {
     public:
-        typedef std::map<std::string, osg::ref_ptr<osg::MatrixTransform> > NodeMap;
+        typedef std::unordered_map<Misc::InternedString, osg::ref_ptr<osg::MatrixTransform> > NodeMap;
 
         NodeMapVisitor(NodeMap& map)
             : osg::NodeVisitor(osg::NodeVisitor::TRAVERSE_ALL_CHILDREN)
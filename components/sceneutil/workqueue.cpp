@@ -1,12 +1,33 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracing.hpp>
 
+#include <osg/Stats>
+
+#include <algorithm>
+#include <iterator>
 #include <numeric>
+#include <string>
+#include <typeinfo>
 
 namespace SceneUtil
 {
 
+namespace
+{
+    // Set for worker threads, so items added from doWork() go to the queue of the thread adding them
+    thread_local const WorkQueue* sCurrentQueue = nullptr;
+    thread_local std::size_t sCurrentThreadIndex = 0;
+
+    const std::array<std::string, sWorkPriorityCount> sPriorityNames {"High", "Normal", "Low"};
+
+    std::size_t getPriorityIndex(WorkPriority priority)
+    {
+        return static_cast<std::size_t>(priority);
+    }
+}
+
 void WorkItem::waitTillDone()
 {
     if (mDone)
@@ -21,11 +42,21 @@ void WorkItem::waitTillDone()
 
 void WorkItem::signalDone()
 {
+    for (osg::ref_ptr<WorkItem>& dependent : markDone())
+        if (dependent->mPendingDependencies.fetch_sub(1) == 1)
+            dependent->mQueue->schedule(std::move(dependent));
+}
+
+std::vector<osg::ref_ptr<WorkItem>> WorkItem::markDone()
+{
+    std::vector<osg::ref_ptr<WorkItem>> dependents;
     {
         std::unique_lock<std::mutex> lock(mMutex);
         mDone = true;
+        dependents.swap(mDependents);
     }
     mCondition.notify_all();
+    return dependents;
 }
 
 bool WorkItem::isDone() const
@@ -33,27 +64,78 @@ bool WorkItem::isDone() const
     return mDone;
 }
 
-WorkQueue::WorkQueue(int workerThreads)
-    : mIsReleased(false)
+void WorkItem::addDependency(const osg::ref_ptr<WorkItem>& item)
+{
+    std::unique_lock<std::mutex> lock(item->mMutex);
+    if (item->mDone)
+        return;
+    ++mPendingDependencies;
+    item->mDependents.emplace_back(this);
+}
+
+WorkQueue::WorkQueue(int workerThreads, const std::string& name)
+    : mName(name)
 {
+    for (int i=0; i<std::max(workerThreads, 1); ++i)
+        mQueues.emplace_back(std::make_unique<ThreadQueue>());
     for (int i=0; i<workerThreads; ++i)
-        mThreads.emplace_back(std::make_unique<WorkThread>(*this));
+        mThreads.emplace_back(std::make_unique<WorkThread>(*this, static_cast<std::size_t>(i)));
 }
 
 WorkQueue::~WorkQueue()
 {
+    std::vector<osg::ref_ptr<WorkItem>> dropped;
+    takeAllWorkItems(dropped);
+
     {
         std::unique_lock<std::mutex> lock(mMutex);
-        while (!mQueue.empty())
-            mQueue.pop_back();
         mIsReleased = true;
         mCondition.notify_all();
     }
 
     mThreads.clear();
+
+    // Items running during the release may have added more
+    takeAllWorkItems(dropped);
+
+    while (!dropped.empty())
+    {
+        const osg::ref_ptr<WorkItem> item = std::move(dropped.back());
+        dropped.pop_back();
+        for (osg::ref_ptr<WorkItem>& dependent : item->markDone())
+        {
+            if (dependent->mPendingDependencies.fetch_sub(1) != 1)
+                continue;
+            if (dependent->mQueue == this)
+                dropped.push_back(std::move(dependent));
+            else
+                dependent->mQueue->schedule(std::move(dependent));
+        }
+    }
+}
+
+void WorkQueue::takeAllWorkItems(std::vector<osg::ref_ptr<WorkItem>>& result)
+{
+    for (const auto& queue : mQueues)
+    {
+        std::unique_lock<std::mutex> lock(queue->mMutex);
+        for (std::size_t priority = 0; priority < sWorkPriorityCount; ++priority)
+        {
+            auto& items = queue->mItems[priority];
+            mNumItems -= static_cast<unsigned int>(items.size());
+            mStats[priority].mQueued -= static_cast<unsigned int>(items.size());
+            std::move(items.begin(), items.end(), std::back_inserter(result));
+            items.clear();
+        }
+    }
 }
 
 void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
+{
+    addWorkItem(std::move(item), front ? WorkPriority::High : WorkPriority::Normal);
+}
+
+void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority)
 {
     if (item->isDone())
     {
@@ -61,35 +143,107 @@ void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
         return;
     }
 
-    std::unique_lock<std::mutex> lock(mMutex);
-    if (front)
-        mQueue.push_front(item);
-    else
-        mQueue.push_back(item);
+    item->mQueue = this;
+    item->mPriority = priority;
+
+    // Item is queued by the last finished dependency if there are any left
+    if (item->mPendingDependencies.fetch_sub(1) == 1)
+        schedule(std::move(item));
+}
+
+void WorkQueue::schedule(osg::ref_ptr<WorkItem> item)
+{
+    const std::size_t priority = getPriorityIndex(item->mPriority);
+    const std::size_t queueIndex = sCurrentQueue == this
+        ? sCurrentThreadIndex
+        : mNextQueue.fetch_add(1) % mQueues.size();
+
+    item->mQueuedAt = std::chrono::steady_clock::now();
+
+    {
+        ThreadQueue& queue = *mQueues[queueIndex];
+        std::unique_lock<std::mutex> lock(queue.mMutex);
+        queue.mItems[priority].push_back(std::move(item));
+        ++mNumItems;
+        ++mStats[priority].mQueued;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+    }
     mCondition.notify_one();
 }
 
-osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(std::size_t threadIndex)
 {
-    std::unique_lock<std::mutex> lock(mMutex);
-    while (mQueue.empty() && !mIsReleased)
+    while (true)
     {
-        mCondition.wait(lock);
+        if (osg::ref_ptr<WorkItem> item = takeWorkItem(threadIndex))
+        {
+            start(*item);
+            return item;
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [&] { return mIsReleased || mNumItems > 0; });
+        if (mIsReleased)
+            return nullptr;
     }
-    if (!mQueue.empty())
+}
+
+osg::ref_ptr<WorkItem> WorkQueue::takeWorkItem(std::size_t threadIndex)
+{
+    const auto pop = [&] (ThreadQueue& queue, std::size_t priority, bool steal) -> osg::ref_ptr<WorkItem>
+    {
+        std::unique_lock<std::mutex> lock(queue.mMutex);
+        auto& items = queue.mItems[priority];
+        if (items.empty())
+            return nullptr;
+        osg::ref_ptr<WorkItem> result;
+        if (steal)
+        {
+            result = std::move(items.back());
+            items.pop_back();
+        }
+        else
+        {
+            result = std::move(items.front());
+            items.pop_front();
+        }
+        --mNumItems;
+        --mStats[priority].mQueued;
+        return result;
+    };
+
+    for (std::size_t priority = 0; priority < sWorkPriorityCount; ++priority)
     {
-        osg::ref_ptr<WorkItem> item = mQueue.front();
-        mQueue.pop_front();
-        return item;
+        if (osg::ref_ptr<WorkItem> item = pop(*mQueues[threadIndex], priority, false))
+            return item;
+
+        for (std::size_t i = 1; i < mQueues.size(); ++i)
+        {
+            if (osg::ref_ptr<WorkItem> item = pop(*mQueues[(threadIndex + i) % mQueues.size()], priority, true))
+            {
+                ++mSteals;
+                return item;
+            }
+        }
     }
-    else
-        return nullptr;
+
+    return nullptr;
+}
+
+void WorkQueue::start(WorkItem& item)
+{
+    using namespace std::chrono;
+    PriorityStats& stats = mStats[getPriorityIndex(item.mPriority)];
+    ++stats.mStarted;
+    stats.mTotalLatency += duration_cast<microseconds>(steady_clock::now() - item.mQueuedAt).count();
 }
 
 unsigned int WorkQueue::getNumItems() const
 {
-    std::unique_lock<std::mutex> lock(mMutex);
-    return mQueue.size();
+    return mNumItems;
 }
 
 unsigned int WorkQueue::getNumActiveThreads() const
@@ -98,8 +252,27 @@ unsigned int WorkQueue::getNumActiveThreads() const
         [] (auto r, const auto& t) { return r + t->isActive(); });
 }
 
-WorkThread::WorkThread(WorkQueue& workQueue)
+void WorkQueue::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+{
+    stats.setAttribute(frameNumber, "WorkQueue", getNumItems());
+    stats.setAttribute(frameNumber, "WorkThread", getNumActiveThreads());
+    stats.setAttribute(frameNumber, "WorkQueue Steals", mSteals.exchange(0));
+
+    for (std::size_t priority = 0; priority < sWorkPriorityCount; ++priority)
+    {
+        const PriorityStats& priorityStats = mStats[priority];
+        stats.setAttribute(frameNumber, "WorkQueue " + sPriorityNames[priority], priorityStats.mQueued);
+        const std::uint64_t started = priorityStats.mStarted.exchange(0);
+        const std::uint64_t totalLatency = priorityStats.mTotalLatency.exchange(0);
+        if (started > 0)
+            stats.setAttribute(frameNumber, "WorkLatency " + sPriorityNames[priority],
+                               static_cast<double>(totalLatency) / static_cast<double>(started));
+    }
+}
+
+WorkThread::WorkThread(WorkQueue& workQueue, std::size_t index)
     : mWorkQueue(&workQueue)
+    , mIndex(index)
     , mActive(false)
     , mThread([this] { run(); })
 {
@@ -112,13 +285,21 @@ WorkThread::~WorkThread()
 
 void WorkThread::run()
 {
+    sCurrentQueue = mWorkQueue;
+    sCurrentThreadIndex = mIndex;
+    Debug::setTraceThreadName(mWorkQueue->getName() + " " + std::to_string(mIndex));
+
     while (true)
     {
-        osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+        osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex);
         if (!item)
             return;
         mActive = true;
-        item->doWork();
+        {
+            // Mangled type name still tells which kind of work took the time
+            const Debug::ScopedTrace trace(typeid(*item).name(), "WorkQueue");
+            item->doWork();
+        }
         item->signalDone();
         mActive = false;
     }
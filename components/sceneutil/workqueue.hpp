@@ -4,14 +4,36 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
-#include <queue>
-#include <thread>
-#include <mutex>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
 
 namespace SceneUtil
 {
+    /// Priority class of a work item. Worker threads always take items of a higher priority first.
+    enum class WorkPriority
+    {
+        High,
+        Normal,
+        Low,
+    };
+
+    constexpr std::size_t sWorkPriorityCount = 3;
+
+    class WorkQueue;
 
     class WorkItem : public osg::Referenced
     {
@@ -30,52 +52,113 @@ namespace SceneUtil
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Don't start this item until the given item is done. Has to be called before this item is added to a
+        /// WorkQueue. The dependency has to be added to a WorkQueue too, otherwise this item is never started.
+        void addDependency(const osg::ref_ptr<WorkItem>& item);
+
     private:
+        friend class WorkQueue;
+
         std::atomic_bool mDone {false};
         std::mutex mMutex;
         std::condition_variable mCondition;
+
+        // Unfinished dependencies plus one until the item is added to a queue
+        std::atomic<int> mPendingDependencies {1};
+        std::vector<osg::ref_ptr<WorkItem>> mDependents;
+
+        WorkQueue* mQueue = nullptr;
+        WorkPriority mPriority = WorkPriority::Normal;
+        std::chrono::steady_clock::time_point mQueuedAt;
+
+        /// Mark as done and return the dependents to be notified.
+        std::vector<osg::ref_ptr<WorkItem>> markDone();
     };
 
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @note Each worker thread has own queue per priority. Items are distributed over threads in round robin and
+    /// processed in the order that they were given in by the owning thread. An idle thread steals items from the back
+    /// of other threads queues, so a later item may start and complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
-        WorkQueue(int numWorkerThreads=1);
+        /// @param name Used to name the worker threads in traces.
+        WorkQueue(int numWorkerThreads=1, const std::string& name="WorkQueue");
+
+        /// Items that are not started yet are dropped and marked done without calling doWork(), so waitTillDone()
+        /// returns for them. Dependents of dropped items added to this queue are dropped too.
         ~WorkQueue();
 
         /// Add a new work item to the back of the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
+        /// @param front If true, add item with high priority. If false (default), add with normal priority.
         void addWorkItem(osg::ref_ptr<WorkItem> item, bool front=false);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
+        /// Add a new work item with given priority. The item is queued when all its dependencies are done.
+        void addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority);
+
+        /// Get the next work item to process by the given thread, stealing it from other threads if own queues are
+        /// empty. If there is no work, waits until a new item is added.
         /// If the workqueue is in the process of being destroyed, may return nullptr.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(std::size_t threadIndex);
 
         unsigned int getNumItems() const;
 
         unsigned int getNumActiveThreads() const;
 
+        /// Report queue depth per priority, steals and average wait time before an item is started since the last
+        /// report.
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+        const std::string& getName() const { return mName; }
+
     private:
-        bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem> > mQueue;
+        struct ThreadQueue
+        {
+            mutable std::mutex mMutex;
+            std::array<std::deque<osg::ref_ptr<WorkItem>>, sWorkPriorityCount> mItems;
+        };
+
+        struct PriorityStats
+        {
+            std::atomic<unsigned int> mQueued {0};
+            mutable std::atomic<std::uint64_t> mStarted {0};
+            mutable std::atomic<std::uint64_t> mTotalLatency {0};
+        };
+
+        const std::string mName;
+        std::atomic_bool mIsReleased {false};
+        std::vector<std::unique_ptr<ThreadQueue>> mQueues;
+        std::atomic<std::size_t> mNextQueue {0};
 
-        mutable std::mutex mMutex;
+        std::mutex mMutex;
         std::condition_variable mCondition;
+        std::atomic<unsigned int> mNumItems {0};
+
+        std::array<PriorityStats, sWorkPriorityCount> mStats;
+        mutable std::atomic<std::uint64_t> mSteals {0};
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        void schedule(osg::ref_ptr<WorkItem> item);
+
+        osg::ref_ptr<WorkItem> takeWorkItem(std::size_t threadIndex);
+
+        void start(WorkItem& item);
+
+        void takeAllWorkItems(std::vector<osg::ref_ptr<WorkItem>>& items);
+
+        friend class WorkItem;
     };
 
     /// Internally used by WorkQueue.
     class WorkThread
     {
     public:
-        WorkThread(WorkQueue& workQueue);
+        WorkThread(WorkQueue& workQueue, std::size_t index);
 
         ~WorkThread();
 
@@ -83,6 +166,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        std::size_t mIndex;
         std::atomic<bool> mActive;
         std::thread mThread;
 
@@ -46,7 +46,7 @@ void CompositeMapRenderer::drawImplementation(osg::RenderInfo &renderInfo) const
                                     mMinimumTimeAvailable);
 
     if (mWorkQueue)
-        mUnrefQueue->flush(mWorkQueue.get());
+        mUnrefQueue->flush(mWorkQueue.get(), SceneUtil::WorkPriority::Low);
 
     std::lock_guard<std::mutex> lock(mMutex);
 
@@ -40,6 +40,8 @@ namespace ToUTF8
                 return getLegacyEnc(str.c_str(), str.size());
             }
 
+            FromType getEncoding() const { return mEncoding; }
+
         private:
             void resize(size_t size);
             size_t getLength(const char* input, bool &ascii);
@@ -49,6 +51,7 @@ namespace ToUTF8
 
             std::vector<char> mOutput;
             signed char* translationArray;
+            FromType mEncoding;
     };
 }
 
@@ -21,7 +21,8 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::string& filename);
+        /// @param memoryMapped see Bsa::BSAFile::open
+        BsaArchive(const std::string& filename, bool memoryMapped = true);
         virtual ~BsaArchive();
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
         bool contains(const std::string& file, char (*normalize_function) (char)) const override;
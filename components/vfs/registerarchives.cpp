@@ -12,7 +12,8 @@
 namespace VFS
 {
 
-    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles)
+    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles,
+        bool memoryMapArchives)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -24,7 +25,7 @@ namespace VFS
                 const std::string archivePath = collections.getPath(*archive).string();
                 Log(Debug::Info) << "Adding BSA archive " << archivePath;
 
-                vfs->addArchive(new BsaArchive(archivePath));
+                vfs->addArchive(new BsaArchive(archivePath, memoryMapArchives));
             }
             else
             {
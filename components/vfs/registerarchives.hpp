@@ -8,8 +8,9 @@ namespace VFS
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param memoryMapArchives map BSA archives into memory instead of reading them with file streams
     void registerArchives (VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, bool memoryMapArchives = true);
 }
 
 #endif